@@ -75,6 +75,12 @@ struct assert_line_end { };
 
 template <typename> struct mode_switch { };
 
+// backtracking memoization point (see memoization.hpp)
+template <size_t Id, typename Content> struct memo_point { };
+
+// counts one step against match_limits (see limits.hpp)
+struct step_tick { };
+
 }
 
 #endif
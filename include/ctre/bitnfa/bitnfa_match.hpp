@@ -4,7 +4,6 @@
 #include "bitnfa_types.hpp"
 #include <string_view>
 #include <vector>
-#include <optional>
 
 #ifndef CTRE_V2__CTRE__HPP
 #include "../../ctre.hpp"
@@ -30,8 +29,9 @@ struct match_result {
     }
 };
 
-[[gnu::always_inline]] inline match_result match(const BitNFA128& nfa, std::string_view input) {
-    StateMask128 current = nfa.get_initial_state();
+template <size_t MaxStates, typename Reachability>
+[[gnu::always_inline]] inline match_result match(const BitNFA<MaxStates, Reachability>& nfa, std::string_view input) {
+    auto current = nfa.get_initial_state();
 
     size_t pos = 0;
     for (char c : input) {
@@ -49,14 +49,12 @@ struct match_result {
 
 template <typename AST>
 inline match_result match_from_ast(std::string_view input) {
-    static constexpr auto nfa = compile_with_charclass<AST>();
-    return match(nfa, input);
+    return match(compiled_bitnfa_v<AST>, input);
 }
 
 template <typename AST>
 inline match_result search_from_ast(std::string_view input) {
-    static constexpr auto nfa = compile_with_charclass<AST>();
-    return search(nfa, input);
+    return search(compiled_bitnfa_v<AST>, input);
 }
 
 template <ctll::fixed_string Pattern>
@@ -67,23 +65,57 @@ inline match_result match(std::string_view input) {
     return match_from_ast<AST>(input);
 }
 
-inline match_result search(const BitNFA128& nfa, std::string_view input) {
-    for (size_t start = 0; start < input.size(); ++start) {
-        StateMask128 current = nfa.get_initial_state();
-        std::optional<size_t> match_end;
-
-        for (size_t pos = start; pos < input.size(); ++pos) {
-            current = nfa.calculate_successors(current, input[pos]);
-            if (current.none()) break;
-            if (nfa.has_accept(current)) match_end = pos;
+// Single-pass unanchored search. The initial state is injected on every byte and
+// active states are kept in buckets ordered by start offset; a state already owned
+// by an earlier start is dropped from later buckets (same future, worse start).
+// This keeps at most one bucket per state and yields leftmost-longest in one scan.
+template <size_t MaxStates, typename Reachability>
+inline match_result search_from(const BitNFA<MaxStates, Reachability>& nfa, std::string_view input, size_t offset) {
+    using mask_type = typename BitNFA<MaxStates, Reachability>::mask_type;
+    struct bucket {
+        size_t start;
+        mask_type states;
+    };
+    // Every kept bucket owns a state of its own, plus the one seeded per byte. The scratch
+    // lives off the stack: MaxStates + 1 buckets of a 512-state mask are tens of KB
+    const size_t used_states =
+        (nfa.state_count == 0 || nfa.state_count > MaxStates) ? MaxStates : size_t{nfa.state_count};
+    thread_local std::vector<bucket> buckets;
+    if (buckets.size() < used_states + 1) buckets.resize(used_states + 1);
+    size_t count = 0;
+    match_result best{};
+
+    for (size_t pos = offset; pos < input.size(); ++pos) {
+        // Stop seeding new threads once a match exists: they cannot start further left
+        if (!best.matched) buckets[count++] = bucket{pos, nfa.get_initial_state()};
+        if (count == 0) break;
+
+        mask_type owned;
+        size_t kept = 0;
+        for (size_t i = 0; i < count; ++i) {
+            mask_type next = nfa.calculate_successors(buckets[i].states, input[pos]);
+            next = (next | owned) ^ owned;
+            if (next.none()) continue;
+            owned = owned | next;
+            if (nfa.has_accept(next) && (!best.matched || buckets[i].start <= best.position)) {
+                best = match_result{buckets[i].start, pos - buckets[i].start + 1, true};
+            }
+            buckets[kept++] = bucket{buckets[i].start, next};
         }
+        count = kept;
 
-        if (match_end.has_value()) {
-            return match_result{start, match_end.value() - start + 1, true};
+        // Threads starting right of the current best can never improve it
+        if (best.matched) {
+            while (count > 0 && buckets[count - 1].start > best.position) --count;
         }
     }
 
-    return match_result{0, 0, false};
+    return best;
+}
+
+template <size_t MaxStates, typename Reachability>
+inline match_result search(const BitNFA<MaxStates, Reachability>& nfa, std::string_view input) {
+    return search_from(nfa, input, 0);
 }
 
 template <ctll::fixed_string Pattern>
@@ -116,39 +148,68 @@ inline match_result search(std::string_view input) {
         }
         return match_result{0, 0, false};
     } else {
-        static constexpr auto nfa = compile_pattern_string_with_charclass<Pattern>();
-        return search(nfa, input);
+        return search(compiled_bitnfa_v<AST>, input);
+    }
+}
+
+// Patterns (bit k for pattern k) matching the whole input
+template <typename NFA, size_t Patterns>
+inline uint64_t match(const MultiBitNFA<NFA, Patterns>& multi, std::string_view input) {
+    auto current = multi.nfa.get_initial_state();
+    for (char c : input) {
+        current = multi.nfa.calculate_successors(current, c);
+        if (current.none()) return 0;
+    }
+    return multi.has_accept(current);
+}
+
+// Patterns matching anywhere in input, in one pass: the start state is re-entered
+// before every byte, so every start offset of every pattern advances together.
+// Nullable patterns match the empty string and always fire.
+template <typename NFA, size_t Patterns>
+inline uint64_t search(const MultiBitNFA<NFA, Patterns>& multi, std::string_view input) {
+    constexpr uint64_t all = Patterns == 64 ? ~uint64_t{0} : (uint64_t{1} << Patterns) - 1;
+    const auto initial = multi.nfa.get_initial_state();
+    uint64_t fired = multi.has_accept(initial);
+    auto current = initial;
+    for (char c : input) {
+        if (fired == all) break;
+        current = multi.nfa.calculate_successors(current | initial, c);
+        fired |= multi.has_accept(current);
     }
+    return fired;
 }
 
-inline std::vector<match_result> find_all(const BitNFA128& nfa, std::string_view input) {
+template <typename... ASTs>
+inline uint64_t match_each_from_ast(std::string_view input) {
+    return match(compiled_multi_bitnfa_v<ASTs...>, input);
+}
+
+template <typename... ASTs>
+inline uint64_t search_each_from_ast(std::string_view input) {
+    return search(compiled_multi_bitnfa_v<ASTs...>, input);
+}
+
+template <size_t MaxStates, typename Reachability>
+inline std::vector<match_result> find_all(const BitNFA<MaxStates, Reachability>& nfa, std::string_view input) {
     std::vector<match_result> results;
     size_t start = 0;
 
     while (start < input.size()) {
-        StateMask128 current = nfa.get_initial_state();
-        std::optional<size_t> match_end;
-
-        for (size_t pos = start; pos < input.size(); ++pos) {
-            current = nfa.calculate_successors(current, input[pos]);
-            if (current.none()) break;
-            if (nfa.has_accept(current)) match_end = pos;
-        }
-
-        if (match_end.has_value()) {
-            results.push_back(match_result{start, match_end.value() - start + 1, true});
-            start = match_end.value() + 1;
-        } else {
-            ++start;
-        }
+        match_result result = search_from(nfa, input, start);
+        if (!result.matched) break;
+        results.push_back(result);
+        start = result.position + result.length;
     }
     return results;
 }
 
 template <ctll::fixed_string Pattern>
 inline std::vector<match_result> find_all(std::string_view input) {
-    static constexpr auto nfa = compile_pattern_string_with_charclass<Pattern>();
-    return find_all(nfa, input);
+    using tmp = typename ctll::parser<::ctre::pcre, Pattern, ::ctre::pcre_actions>::template output<::ctre::pcre_context<>>;
+    static_assert(tmp(), "Regular Expression contains syntax error.");
+    using AST = decltype(ctll::front(typename tmp::output_type::stack_type()));
+    return find_all(compiled_bitnfa_v<AST>, input);
 }
 
 } // namespace ctre::bitnfa
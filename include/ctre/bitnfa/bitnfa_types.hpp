@@ -7,18 +7,23 @@
 
 namespace ctre::bitnfa {
 
-// Bit-based NFA structure for Algorithm 2 (Hyperscan paper)
-template <size_t MaxStates = 128>
+// Bit-based NFA structure for Algorithm 2 (Hyperscan paper). Built with a full
+// per-byte reachability table; the runtime copy uses the class-indexed one.
+template <size_t MaxStates = 128, typename Reachability = BasicReachabilityTable<state_mask_for<MaxStates>>>
 struct BitNFA {
     static constexpr size_t MAX_STATES = MaxStates;
-    static_assert(MaxStates <= 128, "Current implementation supports up to 128 states");
+    static_assert(MaxStates <= 512, "Current implementation supports up to 512 states");
+
+    // 128 states use the SSE mask, larger automata the AVX2 / AVX-512 ones
+    using mask_type = state_mask_for<MaxStates>;
+    using reachability_type = Reachability;
 
     size_t state_count = 0;
-    ShiftMasks7 shift_masks;
-    ReachabilityTable reachability;
-    StateMask128 accept_mask;
-    StateMask128 exception_mask;
-    std::array<StateMask128, MaxStates> exception_successors;
+    ShiftMasks<7, mask_type> shift_masks;
+    Reachability reachability;
+    mask_type accept_mask;
+    mask_type exception_mask;
+    std::array<mask_type, MaxStates> exception_successors;
 
     constexpr BitNFA()
         : state_count(0)
@@ -36,7 +41,7 @@ struct BitNFA {
         return result;
     }
     [[nodiscard]] bool is_accept(size_t state) const { return accept_mask.test(state); }
-    [[nodiscard]] bool has_accept(const StateMask128& active_states) const {
+    [[nodiscard]] bool has_accept(const mask_type& active_states) const {
         return (active_states & accept_mask).any();
     }
 
@@ -57,23 +62,20 @@ struct BitNFA {
         return result;
     }
 
-    [[gnu::always_inline, gnu::hot]] StateMask128 calculate_successors(const StateMask128& current_states, char c) const {
-        StateMask128 typical_succ = shift_masks.calculate_successors(current_states);
-        StateMask128 all_succ = typical_succ;
+    [[gnu::always_inline, gnu::hot]] mask_type calculate_successors(const mask_type& current_states, char c) const {
+        mask_type typical_succ = shift_masks.calculate_successors(current_states);
+        mask_type all_succ = typical_succ;
 
         if (__builtin_expect((current_states & exception_mask).any(), 0)) {
-            StateMask128 exception_states = current_states & exception_mask;
-            uint64_t low = exception_states.get_low();
-            uint64_t high = exception_states.get_high();
-            StateMask128 exception_succ;
-
-            while (low) {
-                exception_succ = exception_succ | exception_successors[static_cast<size_t>(__builtin_ctzll(low))];
-                low &= (low - 1);
-            }
-            while (high) {
-                exception_succ = exception_succ | exception_successors[64 + static_cast<size_t>(__builtin_ctzll(high))];
-                high &= (high - 1);
+            mask_type exception_states = current_states & exception_mask;
+            mask_type exception_succ;
+
+            for (size_t w = 0; w < mask_type::WORDS; ++w) {
+                uint64_t word = exception_states.get_word(w);
+                while (word) {
+                    exception_succ = exception_succ | exception_successors[w * 64 + static_cast<size_t>(__builtin_ctzll(word))];
+                    word &= (word - 1);
+                }
             }
             all_succ = typical_succ | exception_succ;
         }
@@ -81,15 +83,60 @@ struct BitNFA {
         return reachability.filter_by_char(all_succ, c);
     }
 
-    [[nodiscard]] StateMask128 get_initial_state() const {
-        StateMask128 initial;
+    [[nodiscard]] mask_type get_initial_state() const {
+        mask_type initial;
         return initial.set(0);
     }
     [[nodiscard]] bool has_exceptions() const { return exception_mask.any(); }
     [[nodiscard]] size_t count_exceptions() const { return exception_mask.count(); }
 };
 
+// Same automaton with the reachability table compressed to Classes byte classes
+template <size_t Classes, size_t MaxStates>
+[[nodiscard]] constexpr auto with_byte_classes(const BitNFA<MaxStates>& nfa) {
+    BitNFA<MaxStates, ClassReachabilityTable<typename BitNFA<MaxStates>::mask_type, Classes>> out;
+    out.state_count = nfa.state_count;
+    out.shift_masks = nfa.shift_masks;
+    out.reachability = ClassReachabilityTable<typename BitNFA<MaxStates>::mask_type, Classes>(nfa.reachability);
+    out.accept_mask = nfa.accept_mask;
+    out.exception_mask = nfa.exception_mask;
+    out.exception_successors = nfa.exception_successors;
+    return out;
+}
+
+// Several patterns sharing one BitNFA (see compile_multi_with_charclass);
+// accept_masks[k] holds the accepting states of pattern k, nfa.accept_mask their union
+template <typename NFA, size_t Patterns>
+struct MultiBitNFA {
+    static_assert(Patterns <= 64, "Accepting patterns are reported as a 64-bit mask");
+    static constexpr size_t PATTERNS = Patterns;
+    using mask_type = typename NFA::mask_type;
+
+    NFA nfa;
+    std::array<mask_type, Patterns> accept_masks{};
+
+    // Bit k is set when pattern k accepts in active_states
+    [[nodiscard]] uint64_t has_accept(const mask_type& active_states) const {
+        if (!nfa.has_accept(active_states)) return 0;
+        uint64_t fired = 0;
+        for (size_t k = 0; k < Patterns; ++k) {
+            if ((active_states & accept_masks[k]).any()) fired |= uint64_t{1} << k;
+        }
+        return fired;
+    }
+};
+
+template <size_t Classes, size_t MaxStates, size_t Patterns>
+[[nodiscard]] constexpr auto with_byte_classes(const MultiBitNFA<BitNFA<MaxStates>, Patterns>& multi) {
+    MultiBitNFA<decltype(with_byte_classes<Classes>(multi.nfa)), Patterns> out;
+    out.nfa = with_byte_classes<Classes>(multi.nfa);
+    out.accept_masks = multi.accept_masks;
+    return out;
+}
+
 using BitNFA128 = BitNFA<128>;
+using BitNFA256 = BitNFA<256>;
+using BitNFA512 = BitNFA<512>;
 
 } // namespace ctre::bitnfa
 
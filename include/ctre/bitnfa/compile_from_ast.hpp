@@ -7,13 +7,13 @@
 
 namespace ctre::bitnfa {
 
-template <typename Pattern>
-constexpr void extract_reachability_from_ast(ReachabilityTable& table, size_t offset) {
+template <typename Pattern, typename Table>
+constexpr void extract_reachability_from_ast(Table& table, size_t offset) {
     size_t state = offset + 1;
 
     if constexpr (glushkov::is_empty<Pattern>::value) {
     } else if constexpr (glushkov::is_character<Pattern>::value) {
-        []<auto C>(ctre::character<C>*, ReachabilityTable& tbl, size_t st) {
+        []<auto C>(ctre::character<C>*, Table& tbl, size_t st) {
             tbl.set_reachable_mut(static_cast<char>(C), st);
         }(static_cast<Pattern*>(nullptr), table, state);
     } else if constexpr (glushkov::is_any<Pattern>::value) {
@@ -21,18 +21,18 @@ constexpr void extract_reachability_from_ast(ReachabilityTable& table, size_t of
     } else if constexpr (requires { Pattern::template match_char<char>; }) {
         expand_any_char_class<Pattern>(table, state);
     } else if constexpr (glushkov::is_string<Pattern>::value) {
-        []<auto... Cs>(ctre::string<Cs...>*, ReachabilityTable& tbl, size_t st) {
+        []<auto... Cs>(ctre::string<Cs...>*, Table& tbl, size_t st) {
             size_t pos = st;
             ((tbl.set_reachable_mut(static_cast<char>(Cs), pos++)), ...);
         }(static_cast<Pattern*>(nullptr), table, state);
     } else if constexpr (glushkov::is_sequence<Pattern>::value) {
-        []<typename... Content>(ctre::sequence<Content...>*, ReachabilityTable& tbl, size_t off) {
+        []<typename... Content>(ctre::sequence<Content...>*, Table& tbl, size_t off) {
             size_t current_offset = off;
             ((extract_reachability_from_ast<Content>(tbl, current_offset),
               current_offset += glushkov::count_positions<Content>()), ...);
         }(static_cast<Pattern*>(nullptr), table, offset);
     } else if constexpr (glushkov::is_select<Pattern>::value) {
-        []<typename... Options>(ctre::select<Options...>*, ReachabilityTable& tbl, size_t off) {
+        []<typename... Options>(ctre::select<Options...>*, Table& tbl, size_t off) {
             size_t current_offset = off;
             ((extract_reachability_from_ast<Options>(tbl, current_offset),
               current_offset += glushkov::count_positions<Options>()), ...);
@@ -40,43 +40,107 @@ constexpr void extract_reachability_from_ast(ReachabilityTable& table, size_t of
     } else if constexpr (glushkov::is_repeat<Pattern>::value ||
                           glushkov::is_lazy_repeat<Pattern>::value ||
                           glushkov::is_possessive_repeat<Pattern>::value) {
-        []<size_t A, size_t B, typename... Content>(ctre::repeat<A, B, Content...>*, ReachabilityTable& tbl, size_t off) {
+        []<size_t A, size_t B, typename... Content>(ctre::repeat<A, B, Content...>*, Table& tbl, size_t off) {
             (extract_reachability_from_ast<Content>(tbl, off), ...);
         }(static_cast<Pattern*>(nullptr), table, offset);
     }
 }
 
+// Mask width (128/256/512) needed for the pattern's positions plus the start state
+template <typename Pattern>
+inline constexpr size_t bitnfa_width_v = state_mask_for<glushkov::count_positions<Pattern>() + 1>::BITS;
+
 template <typename Pattern>
-constexpr BitNFA128 compile_with_charclass() {
+inline constexpr bool fits_bitnfa_v = glushkov::count_positions<Pattern>() + 1 <= 512;
+
+// Adds Pattern's positions as states offset + 1 .. offset + count, entered from the
+// shared start state 0; its accepting states (0 when nullable) are marked accepting
+// and returned as a mask of their own
+template <typename Pattern, size_t MaxStates>
+constexpr auto add_pattern_states(BitNFA<MaxStates>& nfa, size_t offset) {
     constexpr auto glushkov_nfa = ctre::glushkov::glushkov_nfa<Pattern>();
-    BitNFA128 nfa;
-    nfa.state_count = glushkov_nfa.state_count;
-
-    for (size_t from = 0; from < glushkov_nfa.state_count; ++from) {
-        const auto& state = glushkov_nfa.states[from];
-        for (size_t i = 0; i < state.successor_count; ++i) {
-            size_t to = state.successors[i];
-            if (to > from) {
-                size_t span = to - from;
-                if (span <= 7) nfa.shift_masks.set_transition(from, to);
-                else { nfa.set_exception(from); nfa.add_exception_successor(from, to); }
-            } else {
-                nfa.set_exception(from);
-                nfa.add_exception_successor(from, to);
+    const auto state_of = [offset](size_t position) { return position == 0 ? size_t{0} : position + offset; };
+
+    // Edges come straight from First() and Follow(): the Glushkov states keep at
+    // most 32 successors, which wide alternations exceed
+    const auto add_edge = [&nfa](size_t from, size_t to) {
+        if (to > from && to - from <= 7) nfa.shift_masks.set_transition(from, to);
+        else { nfa.set_exception(from); nfa.add_exception_successor(from, to); }
+    };
+
+    constexpr auto first = glushkov::first_positions<Pattern>(0);
+    for (size_t i = 0; i < first.second; ++i) add_edge(0, state_of(first.first[i]));
+
+    constexpr auto follow = glushkov::compute_follow_sets<Pattern>();
+    for (size_t local = 1; local < follow.rows.size(); ++local) {
+        for (size_t w = 0; w < follow.WORDS; ++w) {
+            for (uint64_t word = follow.rows[local][w]; word != 0; word &= word - 1) {
+                add_edge(state_of(local), state_of(w * 64 + static_cast<size_t>(__builtin_ctzll(word))));
             }
         }
     }
 
-    extract_reachability_from_ast<Pattern>(nfa.reachability, 0);
+    extract_reachability_from_ast<Pattern>(nfa.reachability, offset);
 
-    for (size_t i = 0; i < glushkov_nfa.accept_count; ++i)
-        nfa.set_accept(glushkov_nfa.accept_states[i]);
+    typename BitNFA<MaxStates>::mask_type accept;
+    for (size_t i = 0; i < glushkov_nfa.accept_count; ++i) {
+        nfa.set_accept(state_of(glushkov_nfa.accept_states[i]));
+        accept = accept.set(state_of(glushkov_nfa.accept_states[i]));
+    }
+    return accept;
+}
 
+template <typename Pattern, size_t MaxStates = bitnfa_width_v<Pattern>>
+constexpr BitNFA<MaxStates> compile_with_charclass() {
+    static_assert(glushkov::count_positions<Pattern>() + 1 <= MaxStates, "Pattern has too many positions for this BitNFA width");
+    BitNFA<MaxStates> nfa;
+    nfa.state_count = ctre::glushkov::glushkov_nfa<Pattern>().state_count;
+    add_pattern_states<Pattern>(nfa, 0);
     return nfa;
 }
 
+// Several patterns in one automaton: pattern k takes the states after those of
+// patterns 0 .. k-1, so one calculate_successors pass advances all of them
+template <typename... Patterns>
+inline constexpr size_t combined_positions_v = (size_t{0} + ... + glushkov::count_positions<Patterns>());
+
+template <typename... Patterns>
+inline constexpr size_t multi_bitnfa_width_v = state_mask_for<combined_positions_v<Patterns...> + 1>::BITS;
+
+template <typename... Patterns>
+inline constexpr bool fits_multi_bitnfa_v = combined_positions_v<Patterns...> + 1 <= 512 && sizeof...(Patterns) <= 64;
+
+template <typename... Patterns>
+constexpr auto compile_multi_with_charclass() {
+    static_assert(fits_multi_bitnfa_v<Patterns...>, "Patterns have too many positions (or are too many) for one BitNFA");
+    constexpr size_t width = multi_bitnfa_width_v<Patterns...>;
+    MultiBitNFA<BitNFA<width>, sizeof...(Patterns)> out;
+    out.nfa.state_count = combined_positions_v<Patterns...> + 1;
+
+    size_t offset = 0;
+    size_t index = 0;
+    ((out.accept_masks[index++] = add_pattern_states<Patterns>(out.nfa, offset),
+      offset += glushkov::count_positions<Patterns>()), ...);
+    return out;
+}
+
+// Runtime automaton: the reachability table compressed to the pattern's byte classes
+template <typename Pattern>
+inline constexpr auto full_bitnfa_v = compile_with_charclass<Pattern>();
+
+template <typename Pattern>
+inline constexpr auto compiled_bitnfa_v =
+    with_byte_classes<byte_class_count(full_bitnfa_v<Pattern>.reachability)>(full_bitnfa_v<Pattern>);
+
+template <typename... Patterns>
+inline constexpr auto full_multi_bitnfa_v = compile_multi_with_charclass<Patterns...>();
+
+template <typename... Patterns>
+inline constexpr auto compiled_multi_bitnfa_v =
+    with_byte_classes<byte_class_count(full_multi_bitnfa_v<Patterns...>.nfa.reachability)>(full_multi_bitnfa_v<Patterns...>);
+
 template <ctll::fixed_string Pattern>
-constexpr BitNFA128 compile_pattern_string_with_charclass() {
+constexpr auto compile_pattern_string_with_charclass() {
     using tmp = typename ctll::parser<ctre::pcre, Pattern, ctre::pcre_actions>::template output<ctre::pcre_context<>>;
     static_assert(tmp(), "Regular Expression contains syntax error.");
     using AST = decltype(ctll::front(typename tmp::output_type::stack_type()));
@@ -2,6 +2,7 @@
 #define CTRE_BITNFA_REACHABILITY_HPP
 
 #include "state_mask.hpp"
+#include "../byte_classes.hpp"
 #include <array>
 
 // Reachability table: 256 state masks (one per ASCII character)
@@ -9,11 +10,14 @@
 
 namespace ctre::bitnfa {
 
-struct ReachabilityTable {
-    std::array<StateMask128, 256> reachable;
+template <typename Mask = StateMask128>
+struct BasicReachabilityTable {
+    using mask_type = Mask;
+
+    std::array<Mask, 256> reachable;
     static constexpr unsigned char idx(char c) { return static_cast<unsigned char>(c); }
 
-    constexpr ReachabilityTable() : reachable{} {}
+    constexpr BasicReachabilityTable() : reachable{} {}
 
     constexpr void set_reachable_mut(char c, size_t state) {
         reachable[idx(c)] = reachable[idx(c)].set(state);
@@ -21,10 +25,10 @@ struct ReachabilityTable {
     constexpr void set_reachable(char c, size_t state) { set_reachable_mut(c, state); }
 
     [[nodiscard]] bool is_reachable(char c, size_t state) const { return reachable[idx(c)].test(state); }
-    [[nodiscard]] const StateMask128& operator[](char c) const { return reachable[idx(c)]; }
-    StateMask128& operator[](char c) { return reachable[idx(c)]; }
-    [[nodiscard]] const StateMask128& get(unsigned char c) const { return reachable[c]; }
-    StateMask128& get(unsigned char c) { return reachable[c]; }
+    [[nodiscard]] const Mask& operator[](char c) const { return reachable[idx(c)]; }
+    Mask& operator[](char c) { return reachable[idx(c)]; }
+    [[nodiscard]] const Mask& get(unsigned char c) const { return reachable[c]; }
+    Mask& get(unsigned char c) { return reachable[c]; }
 
     void set_reachable_range(char from, char to, size_t state) {
         for (unsigned char c = idx(from); c <= idx(to); ++c) {
@@ -39,11 +43,44 @@ struct ReachabilityTable {
 
     [[nodiscard]] size_t count_reachable(char c) const { return reachable[idx(c)].count(); }
     [[nodiscard]] bool has_reachable(char c) const { return reachable[idx(c)].any(); }
-    [[nodiscard]] StateMask128 filter_by_char(const StateMask128& successors, char c) const {
+    [[nodiscard]] Mask filter_by_char(const Mask& successors, char c) const {
         return successors & reachable[idx(c)];
     }
 };
 
+// One table per mask width; wide masks make every row multi-word
+using ReachabilityTable = BasicReachabilityTable<StateMask128>;
+
+template <typename Mask>
+[[nodiscard]] constexpr size_t byte_class_count(const BasicReachabilityTable<Mask>& table) {
+    return partition_bytes(table.reachable).count;
+}
+
+// Runtime form: bytes with equal masks share a row, so a 128-bit table shrinks
+// from 4 KB to a 256-byte class map plus 16 bytes per class
+template <typename Mask, size_t Classes>
+struct ClassReachabilityTable {
+    using mask_type = Mask;
+
+    byte_class_table<Mask, Classes> rows;
+    static constexpr unsigned char idx(char c) { return static_cast<unsigned char>(c); }
+
+    constexpr ClassReachabilityTable() = default;
+    constexpr explicit ClassReachabilityTable(const BasicReachabilityTable<Mask>& table)
+        : rows(byte_class_table<Mask, Classes>::from_rows(table.reachable)) {}
+
+    [[nodiscard]] bool is_reachable(char c, size_t state) const { return rows[idx(c)].test(state); }
+    [[nodiscard]] const Mask& operator[](char c) const { return rows[idx(c)]; }
+    [[nodiscard]] const Mask& get(unsigned char c) const { return rows[c]; }
+    [[nodiscard]] size_t class_count() const { return rows.class_count; }
+
+    [[nodiscard]] size_t count_reachable(char c) const { return rows[idx(c)].count(); }
+    [[nodiscard]] bool has_reachable(char c) const { return rows[idx(c)].any(); }
+    [[nodiscard]] Mask filter_by_char(const Mask& successors, char c) const {
+        return successors & rows[idx(c)];
+    }
+};
+
 } // namespace ctre::bitnfa
 
 #endif // CTRE_BITNFA_REACHABILITY_HPP
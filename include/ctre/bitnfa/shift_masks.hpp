@@ -8,12 +8,12 @@
 
 namespace ctre::bitnfa {
 
-template <size_t ShiftLimit = 7>
+template <size_t ShiftLimit = 7, typename Mask = StateMask128>
 struct ShiftMasks {
     static constexpr size_t SHIFT_LIMIT = ShiftLimit;
     static_assert(ShiftLimit <= 16, "Shift limit too large (max 16)");
 
-    std::array<StateMask128, ShiftLimit + 1> masks;
+    std::array<Mask, ShiftLimit + 1> masks;
 
     constexpr ShiftMasks() : masks{} {}
 
@@ -28,18 +28,18 @@ struct ShiftMasks {
         return span <= ShiftLimit && masks[span].test(from_state);
     }
 
-    [[nodiscard]] const StateMask128& operator[](size_t k) const { return masks[k]; }
-    StateMask128& operator[](size_t k) { return masks[k]; }
-
-    [[gnu::always_inline]] StateMask128 calculate_successors(const StateMask128& current_states) const {
-        StateMask128 succ0 = current_states & masks[0];
-        StateMask128 succ1 = (current_states & masks[1]) << 1;
-        StateMask128 succ2 = (current_states & masks[2]) << 2;
-        StateMask128 succ3 = (current_states & masks[3]) << 3;
-        StateMask128 succ4 = (current_states & masks[4]) << 4;
-        StateMask128 succ5 = (current_states & masks[5]) << 5;
-        StateMask128 succ6 = (current_states & masks[6]) << 6;
-        StateMask128 succ7 = (current_states & masks[7]) << 7;
+    [[nodiscard]] const Mask& operator[](size_t k) const { return masks[k]; }
+    Mask& operator[](size_t k) { return masks[k]; }
+
+    [[gnu::always_inline]] Mask calculate_successors(const Mask& current_states) const {
+        Mask succ0 = current_states & masks[0];
+        Mask succ1 = (current_states & masks[1]) << 1;
+        Mask succ2 = (current_states & masks[2]) << 2;
+        Mask succ3 = (current_states & masks[3]) << 3;
+        Mask succ4 = (current_states & masks[4]) << 4;
+        Mask succ5 = (current_states & masks[5]) << 5;
+        Mask succ6 = (current_states & masks[6]) << 6;
+        Mask succ7 = (current_states & masks[7]) << 7;
 
         return (succ0 | succ1 | succ2 | succ3) | (succ4 | succ5 | succ6 | succ7);
     }
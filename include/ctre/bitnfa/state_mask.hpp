@@ -5,18 +5,33 @@
 #ifdef CTRE_ARCH_X86
 #include <immintrin.h> // For __m128i intrinsics
 #endif
+#include <array>       // For multi-word masks
 #include <cstddef>     // For size_t
 #include <cstdint>     // For uint64_t
 
 namespace ctre::bitnfa {
 
+// A set of up to Bits NFA states, one bit per state.
+// StateMask<128> is the SSE specialization below; wider masks (256/512)
+// use the generic multi-word form. The vector paths are chosen at compile
+// time from the target flags (__SSE4_1__, __AVX2__, __AVX512F__), with a
+// word-at-a-time fallback when the build does not enable them.
+template <size_t Bits>
+struct StateMask;
+
+using StateMask128 = StateMask<128>;
+
 // A wrapper to represent a set of up to 128 NFA states.
 // Each bit corresponds to an NFA state.
 //
 // Design:
 // - Construction: constexpr-friendly (no SIMD intrinsics)
 // - Matching: SIMD-accelerated on x86 (runtime intrinsics)
-struct StateMask128 {
+template <>
+struct StateMask<128> {
+    static constexpr size_t BITS = 128;
+    static constexpr size_t WORDS = 2;
+
 #ifdef CTRE_ARCH_X86
     __m128i bits;
 #else
@@ -28,26 +43,26 @@ struct StateMask128 {
 
     // Default constructor - all zeros
 #ifdef CTRE_ARCH_X86
-    constexpr StateMask128() : bits{} {}
+    constexpr StateMask() : bits{} {}
 #else
-    constexpr StateMask128() : low_bits(0), high_bits(0) {}
+    constexpr StateMask() : low_bits(0), high_bits(0) {}
 #endif
 
 #ifdef CTRE_ARCH_X86
     // Constructor from raw __m128i (for SIMD operations)
-    constexpr StateMask128(__m128i val) : bits(val) {}
+    constexpr StateMask(__m128i val) : bits(val) {}
 #endif
 
     // Constexpr constructor from two 64-bit values
 #ifdef CTRE_ARCH_X86
-    constexpr StateMask128(uint64_t low, uint64_t high) : bits{} {
+    constexpr StateMask(uint64_t low, uint64_t high) : bits{} {
         // Use GCC/Clang vector extension for constexpr
         #if defined(__GNUC__) || defined(__clang__)
         bits = __extension__ (__m128i)(__v2di){(long long)low, (long long)high};
         #endif
     }
 #else
-    constexpr StateMask128(uint64_t low, uint64_t high) : low_bits(low), high_bits(high) {}
+    constexpr StateMask(uint64_t low, uint64_t high) : low_bits(low), high_bits(high) {}
 #endif
 
     constexpr uint64_t get_low() const {
@@ -74,8 +89,10 @@ struct StateMask128 {
 #endif
     }
 
+    constexpr uint64_t get_word(size_t i) const { return i == 0 ? get_low() : get_high(); }
+
     // Set a bit - CONSTEXPR (returns new mask)
-    constexpr StateMask128 set(size_t bit_pos) const {
+    constexpr StateMask set(size_t bit_pos) const {
         if (bit_pos >= 128) return *this;
 
         uint64_t low = get_low();
@@ -87,11 +104,11 @@ struct StateMask128 {
             high |= (1ULL << (bit_pos - 64));
         }
 
-        return StateMask128(low, high);
+        return StateMask(low, high);
     }
 
     // Clear a bit - CONSTEXPR (returns new mask)
-    constexpr StateMask128 clear(size_t bit_pos) const {
+    constexpr StateMask clear(size_t bit_pos) const {
         if (bit_pos >= 128) return *this;
 
         uint64_t low = get_low();
@@ -103,7 +120,7 @@ struct StateMask128 {
             high &= ~(1ULL << (bit_pos - 64));
         }
 
-        return StateMask128(low, high);
+        return StateMask(low, high);
     }
 
     // Test a bit - CONSTEXPR
@@ -121,8 +138,10 @@ struct StateMask128 {
 
     // Check if any bit is set
     inline bool any() const {
-#ifdef CTRE_ARCH_X86
+#if defined(CTRE_ARCH_X86) && defined(__SSE4_1__)
         return !_mm_testz_si128(bits, bits);
+#elif defined(CTRE_ARCH_X86)
+        return _mm_movemask_epi8(_mm_cmpeq_epi8(bits, _mm_setzero_si128())) != 0xFFFF;
 #else
         return (low_bits | high_bits) != 0;
 #endif
@@ -130,43 +149,45 @@ struct StateMask128 {
 
     // Check if all bits are zero
     inline bool none() const {
-#ifdef CTRE_ARCH_X86
+#if defined(CTRE_ARCH_X86) && defined(__SSE4_1__)
         return _mm_testz_si128(bits, bits);
+#elif defined(CTRE_ARCH_X86)
+        return _mm_movemask_epi8(_mm_cmpeq_epi8(bits, _mm_setzero_si128())) == 0xFFFF;
 #else
         return (low_bits | high_bits) == 0;
 #endif
     }
 
     // Bitwise AND
-    inline StateMask128 operator&(const StateMask128& other) const {
+    inline StateMask operator&(const StateMask& other) const {
 #ifdef CTRE_ARCH_X86
-        return StateMask128(_mm_and_si128(bits, other.bits));
+        return StateMask(_mm_and_si128(bits, other.bits));
 #else
-        return StateMask128(low_bits & other.low_bits, high_bits & other.high_bits);
+        return StateMask(low_bits & other.low_bits, high_bits & other.high_bits);
 #endif
     }
 
     // Bitwise OR
-    inline StateMask128 operator|(const StateMask128& other) const {
+    inline StateMask operator|(const StateMask& other) const {
 #ifdef CTRE_ARCH_X86
-        return StateMask128(_mm_or_si128(bits, other.bits));
+        return StateMask(_mm_or_si128(bits, other.bits));
 #else
-        return StateMask128(low_bits | other.low_bits, high_bits | other.high_bits);
+        return StateMask(low_bits | other.low_bits, high_bits | other.high_bits);
 #endif
     }
 
     // Bitwise XOR
-    inline StateMask128 operator^(const StateMask128& other) const {
+    inline StateMask operator^(const StateMask& other) const {
 #ifdef CTRE_ARCH_X86
-        return StateMask128(_mm_xor_si128(bits, other.bits));
+        return StateMask(_mm_xor_si128(bits, other.bits));
 #else
-        return StateMask128(low_bits ^ other.low_bits, high_bits ^ other.high_bits);
+        return StateMask(low_bits ^ other.low_bits, high_bits ^ other.high_bits);
 #endif
     }
 
     // Left shift (constexpr for compile-time, optimized for runtime)
-    constexpr StateMask128 operator<<(size_t shift_amount) const {
-        if (shift_amount >= 128) return StateMask128();
+    constexpr StateMask operator<<(size_t shift_amount) const {
+        if (shift_amount >= 128) return StateMask();
         if (shift_amount == 0) return *this;
 
         uint64_t low = get_low();
@@ -175,21 +196,21 @@ struct StateMask128 {
         if (shift_amount >= 64) {
             // Shift >= 64: low bits move to high, low becomes 0
             uint64_t new_high = low << (shift_amount - 64);
-            return StateMask128(0, new_high);
+            return StateMask(0, new_high);
         } else {
             // Shift < 64: bits shift within and across boundaries
             uint64_t new_low = low << shift_amount;
             uint64_t new_high = (high << shift_amount) | (low >> (64 - shift_amount));
-            return StateMask128(new_low, new_high);
+            return StateMask(new_low, new_high);
         }
     }
 
     // Fast runtime shift
-    [[nodiscard]] inline StateMask128 shift_runtime(size_t shift_amount) const noexcept {
+    [[nodiscard]] inline StateMask shift_runtime(size_t shift_amount) const noexcept {
         if (shift_amount == 0) return *this;
-        if (shift_amount >= 128) return StateMask128{};
+        if (shift_amount >= 128) return StateMask{};
 
-#ifdef CTRE_ARCH_X86
+#if defined(CTRE_ARCH_X86) && defined(__SSE4_1__)
         const int shift = static_cast<int>(shift_amount);
         if (shift_amount < 64) {
             __m128i shifted = _mm_slli_epi64(bits, shift);
@@ -197,10 +218,10 @@ struct StateMask128 {
             uint64_t carry = low >> (64 - shift_amount);
             uint64_t high = static_cast<uint64_t>(_mm_extract_epi64(shifted, 1));
             shifted = _mm_insert_epi64(shifted, static_cast<long long>(high | carry), 1);
-            return StateMask128(shifted);
+            return StateMask(shifted);
         } else {
             uint64_t low = static_cast<uint64_t>(_mm_extract_epi64(bits, 0));
-            return StateMask128(_mm_insert_epi64(_mm_setzero_si128(), static_cast<long long>(low << (shift_amount - 64)), 1));
+            return StateMask(_mm_insert_epi64(_mm_setzero_si128(), static_cast<long long>(low << (shift_amount - 64)), 1));
         }
 #else
         // Use the constexpr implementation
@@ -209,12 +230,12 @@ struct StateMask128 {
     }
 
     // Equality (constexpr-friendly)
-    constexpr bool operator==(const StateMask128& other) const {
+    constexpr bool operator==(const StateMask& other) const {
         return get_low() == other.get_low() && get_high() == other.get_high();
     }
 
     // Inequality
-    constexpr bool operator!=(const StateMask128& other) const {
+    constexpr bool operator!=(const StateMask& other) const {
         return !(*this == other);
     }
 
@@ -224,6 +245,150 @@ struct StateMask128 {
     }
 };
 
+// Generic multi-word mask (256 or 512 states); AVX2 / AVX-512 only when the
+// build targets them
+template <size_t Bits>
+struct StateMask {
+    static_assert(Bits % 64 == 0 && Bits > 128, "StateMask width must be a multiple of 64 above 128");
+    static constexpr size_t BITS = Bits;
+    static constexpr size_t WORDS = Bits / 64;
+
+    alignas(Bits >= 512 ? 64 : 32) std::array<uint64_t, WORDS> words;
+
+    // CONSTRUCTION (constexpr-friendly)
+
+    constexpr StateMask() : words{} {}
+
+    constexpr uint64_t get_word(size_t i) const { return words[i]; }
+    constexpr uint64_t get_low() const { return words[0]; }
+    constexpr uint64_t get_high() const { return words[1]; }
+
+    constexpr StateMask set(size_t bit_pos) const {
+        if (bit_pos >= Bits) return *this;
+        StateMask result = *this;
+        result.words[bit_pos / 64] |= (1ULL << (bit_pos % 64));
+        return result;
+    }
+
+    constexpr StateMask clear(size_t bit_pos) const {
+        if (bit_pos >= Bits) return *this;
+        StateMask result = *this;
+        result.words[bit_pos / 64] &= ~(1ULL << (bit_pos % 64));
+        return result;
+    }
+
+    constexpr bool test(size_t bit_pos) const {
+        if (bit_pos >= Bits) return false;
+        return (words[bit_pos / 64] & (1ULL << (bit_pos % 64))) != 0;
+    }
+
+    // RUNTIME OPERATIONS
+
+    inline bool any() const {
+#if defined(CTRE_ARCH_X86) && defined(__AVX512F__)
+        if constexpr (Bits % 512 == 0) {
+            __m512i acc = _mm512_setzero_si512();
+            for (size_t i = 0; i < WORDS; i += 8)
+                acc = _mm512_or_si512(acc, _mm512_load_si512(static_cast<const void*>(&words[i])));
+            return _mm512_test_epi64_mask(acc, acc) != 0;
+        }
+#endif
+#if defined(CTRE_ARCH_X86) && defined(__AVX2__)
+        if constexpr (Bits % 256 == 0) {
+            __m256i acc = _mm256_setzero_si256();
+            for (size_t i = 0; i < WORDS; i += 4)
+                acc = _mm256_or_si256(acc, _mm256_load_si256(reinterpret_cast<const __m256i*>(&words[i])));
+            return !_mm256_testz_si256(acc, acc);
+        }
+#endif
+        uint64_t acc = 0;
+        for (size_t i = 0; i < WORDS; ++i) acc |= words[i];
+        return acc != 0;
+    }
+
+    inline bool none() const { return !any(); }
+
+    inline StateMask operator&(const StateMask& other) const {
+        return combine(other, [](auto a, auto b) { return a & b; });
+    }
+
+    inline StateMask operator|(const StateMask& other) const {
+        return combine(other, [](auto a, auto b) { return a | b; });
+    }
+
+    inline StateMask operator^(const StateMask& other) const {
+        return combine(other, [](auto a, auto b) { return a ^ b; });
+    }
+
+    // Left shift across words (constexpr for compile-time and runtime)
+    constexpr StateMask operator<<(size_t shift_amount) const {
+        if (shift_amount >= Bits) return StateMask();
+        if (shift_amount == 0) return *this;
+
+        const size_t word_shift = shift_amount / 64;
+        const size_t bit_shift = shift_amount % 64;
+        StateMask result;
+        for (size_t i = WORDS; i-- > word_shift;) {
+            uint64_t value = words[i - word_shift] << bit_shift;
+            if (bit_shift != 0 && i > word_shift) value |= words[i - word_shift - 1] >> (64 - bit_shift);
+            result.words[i] = value;
+        }
+        return result;
+    }
+
+    [[nodiscard]] inline StateMask shift_runtime(size_t shift_amount) const noexcept { return *this << shift_amount; }
+
+    constexpr bool operator==(const StateMask& other) const {
+        for (size_t i = 0; i < WORDS; ++i)
+            if (words[i] != other.words[i]) return false;
+        return true;
+    }
+
+    constexpr bool operator!=(const StateMask& other) const { return !(*this == other); }
+
+    constexpr size_t count() const {
+        size_t total = 0;
+        for (size_t i = 0; i < WORDS; ++i) total += static_cast<size_t>(__builtin_popcountll(words[i]));
+        return total;
+    }
+
+private:
+    // Vector ops are applied to the integer lanes (uint64_t or __m256i/__m512i)
+    template <typename Op>
+    [[gnu::always_inline]] inline StateMask combine(const StateMask& other, Op op) const {
+        StateMask result;
+#if defined(CTRE_ARCH_X86) && defined(__AVX512F__)
+        if constexpr (Bits % 512 == 0) {
+            for (size_t i = 0; i < WORDS; i += 8) {
+                __m512i a = _mm512_load_si512(static_cast<const void*>(&words[i]));
+                __m512i b = _mm512_load_si512(static_cast<const void*>(&other.words[i]));
+                _mm512_store_si512(static_cast<void*>(&result.words[i]), op(a, b));
+            }
+            return result;
+        }
+#endif
+#if defined(CTRE_ARCH_X86) && defined(__AVX2__)
+        if constexpr (Bits % 256 == 0) {
+            for (size_t i = 0; i < WORDS; i += 4) {
+                __m256i a = _mm256_load_si256(reinterpret_cast<const __m256i*>(&words[i]));
+                __m256i b = _mm256_load_si256(reinterpret_cast<const __m256i*>(&other.words[i]));
+                _mm256_store_si256(reinterpret_cast<__m256i*>(&result.words[i]), op(a, b));
+            }
+            return result;
+        }
+#endif
+        for (size_t i = 0; i < WORDS; ++i) result.words[i] = op(words[i], other.words[i]);
+        return result;
+    }
+};
+
+using StateMask256 = StateMask<256>;
+using StateMask512 = StateMask<512>;
+
+// Narrowest mask able to hold the given number of states
+template <size_t States>
+using state_mask_for = StateMask<(States <= 128 ? 128 : States <= 256 ? 256 : 512)>;
+
 } // namespace ctre::bitnfa
 
 #endif // CTRE__BITNFA__STATE_MASK__HPP
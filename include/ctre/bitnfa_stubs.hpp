@@ -11,6 +11,8 @@ struct match_result {
     std::size_t length = 0;
 };
 
+template <typename RE> inline constexpr bool fits_bitnfa_v = false;
+
 template <typename RE>
 [[nodiscard]] match_result match_from_ast(std::string_view) noexcept {
     return {};
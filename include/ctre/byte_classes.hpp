@@ -0,0 +1,54 @@
+#ifndef CTRE__BYTE_CLASSES__HPP
+#define CTRE__BYTE_CLASSES__HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// Byte equivalence classes: bytes whose rows in a per-byte table are equal share a
+// class, so the table becomes one 256-byte class map plus one row per class.
+// Shared by the BitNFA reachability table, the shift-or masks and the DFA tables.
+
+namespace ctre {
+
+struct byte_partition {
+    std::array<uint8_t, 256> class_of{};
+    std::array<uint8_t, 256> representative{}; // smallest byte of each class
+    size_t count = 0;
+};
+
+// Classes are numbered in order of their smallest byte
+template <typename Row>
+[[nodiscard]] constexpr byte_partition partition_bytes(const std::array<Row, 256>& rows) noexcept {
+    byte_partition p;
+    for (size_t c = 0; c < 256; ++c) {
+        size_t k = 0;
+        while (k < p.count && !(rows[p.representative[k]] == rows[c])) ++k;
+        if (k == p.count) p.representative[p.count++] = static_cast<uint8_t>(c);
+        p.class_of[c] = static_cast<uint8_t>(k);
+    }
+    return p;
+}
+
+// Per-byte table stored by class; Capacity must cover the class count
+template <typename Row, size_t Capacity>
+struct byte_class_table {
+    std::array<uint8_t, 256> class_of{};
+    std::array<Row, Capacity> rows{};
+    size_t class_count = 0;
+
+    [[nodiscard]] constexpr const Row& operator[](unsigned char c) const noexcept { return rows[class_of[c]]; }
+
+    [[nodiscard]] static constexpr byte_class_table from_rows(const std::array<Row, 256>& full) noexcept {
+        const byte_partition p = partition_bytes(full);
+        byte_class_table t;
+        t.class_of = p.class_of;
+        t.class_count = p.count;
+        for (size_t k = 0; k < p.count; ++k) t.rows[k] = full[p.representative[k]];
+        return t;
+    }
+};
+
+} // namespace ctre
+
+#endif // CTRE__BYTE_CLASSES__HPP
@@ -5,8 +5,12 @@
 
 #include "dominator_analysis.hpp"
 #include "glushkov_nfa.hpp"
+#include "literal_extraction_prefix.hpp"
 #include "literal_extraction_simple_multi.hpp"
+#include "possessify.hpp"
 #include "region_analysis.hpp"
+#include "simd/literal_search.hpp"
+#include "simd/teddy.hpp"
 
 namespace ctre {
 template <typename RE, typename Method, typename Modifier>
@@ -110,6 +114,36 @@ inline constexpr bool has_prefilter_literal = dominators::has_extractable_litera
 template <typename Pattern>
 inline constexpr auto prefilter_literal = dominators::extract_literal<unwrap_regex_t<Pattern>>();
 
+// The literal is matched ignoring ASCII case under the case-insensitive modifier or an
+// inline (?i): the extraction keeps the pattern's own case, which may not be the subject's
+template <typename Pattern, typename Modifier>
+inline constexpr bool prefilter_ignores_case =
+    is_case_insensitive(flags{Modifier{}}) || has_mode_switch<unwrap_regex_t<Pattern>>::value;
+
+// Whether [begin, end) contains the prefilter literal, a match needs it somewhere
+template <typename Pattern, typename Modifier>
+[[nodiscard]] inline bool contains_prefilter_literal(const char* begin, const char* end) noexcept {
+    constexpr auto literal = prefilter_literal<Pattern>;
+    return [&]<size_t... Is>(std::index_sequence<Is...>) {
+        constexpr char lit[] = {literal.chars[Is]..., '\0'};
+        if constexpr (prefilter_ignores_case<Pattern, Modifier>) {
+            return simd::search_literal_caseless(begin, end, lit);
+        } else {
+            return simd::search_literal(begin, end, lit);
+        }
+    }(std::make_index_sequence<literal.length>{});
+}
+
+// Prefix literal set (every match starts with one of them) for Teddy prefiltering
+template <typename Pattern>
+inline constexpr auto prefilter_literal_set = extraction::extract_prefix_literals<unwrap_regex_t<Pattern>>();
+
+template <typename Pattern>
+inline constexpr bool has_prefilter_literal_set = prefilter_literal_set<Pattern>.has_literals;
+
+template <typename Pattern>
+inline constexpr auto prefilter_teddy = simd::make_teddy_masks(prefilter_literal_set<Pattern>);
+
 template <typename Pattern>
 inline auto prefilter_literal_with_fallback = extract_literal_with_fallback<unwrap_regex_t<Pattern>>();
 
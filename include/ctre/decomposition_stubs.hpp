@@ -14,6 +14,13 @@ struct prefilter_literal_type {
 
 template <typename RE> inline constexpr prefilter_literal_type<RE> prefilter_literal{};
 
+template <typename RE, typename Modifier> inline constexpr bool prefilter_ignores_case = false;
+
+template <typename RE, typename Modifier>
+[[nodiscard]] inline bool contains_prefilter_literal(const char*, const char*) noexcept {
+    return true;
+}
+
 } // namespace ctre::decomposition
 
 #endif
@@ -0,0 +1,426 @@
+#ifndef CTRE_DFA_COMPILE_DFA_HPP
+#define CTRE_DFA_COMPILE_DFA_HPP
+
+#include "../byte_classes.hpp"
+#include "../glushkov_nfa.hpp"
+#include <array>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+// Compile-time DFA: the pattern is brought to a form the Glushkov construction
+// handles exactly, every position gets its byte set, and subset construction over
+// byte classes yields flat uint16_t transition tables.
+
+namespace ctre::dfa {
+
+using namespace ctre::traits;
+
+inline constexpr size_t DFA_MAX_POSITIONS = 256;
+inline constexpr size_t DFA_MAX_STATES = 256;
+
+// No assertions, lookarounds, backreferences, lazy or possessive repeats
+template <typename T> struct is_dfa_compatible : std::bool_constant<CharacterLike<T>> {};
+template <> struct is_dfa_compatible<any> : std::true_type {};
+template <> struct is_dfa_compatible<empty> : std::true_type {};
+template <auto... Str> struct is_dfa_compatible<string<Str...>> : std::true_type {};
+template <typename... Content> struct is_dfa_compatible<sequence<Content...>> : std::bool_constant<(is_dfa_compatible<Content>::value && ...)> {};
+template <typename... Content> struct is_dfa_compatible<select<Content...>> : std::bool_constant<(is_dfa_compatible<Content>::value && ...)> {};
+template <size_t Index, typename... Content> struct is_dfa_compatible<capture<Index, Content...>> : std::bool_constant<(is_dfa_compatible<Content>::value && ...)> {};
+template <size_t Index, typename Name, typename... Content> struct is_dfa_compatible<capture_with_name<Index, Name, Content...>> : std::bool_constant<(is_dfa_compatible<Content>::value && ...)> {};
+template <size_t A, size_t B, typename... Content> struct is_dfa_compatible<repeat<A, B, Content...>> : std::bool_constant<(is_dfa_compatible<Content>::value && ...)> {};
+
+// Capture groups only matter to evaluate; the DFA matches them as plain groups
+template <typename T> struct has_capture : std::false_type {};
+template <size_t Index, typename... Content> struct has_capture<capture<Index, Content...>> : std::true_type {};
+template <size_t Index, typename Name, typename... Content> struct has_capture<capture_with_name<Index, Name, Content...>> : std::true_type {};
+template <typename... Content> struct has_capture<sequence<Content...>> : std::bool_constant<(has_capture<Content>::value || ...)> {};
+template <typename... Content> struct has_capture<select<Content...>> : std::bool_constant<(has_capture<Content>::value || ...)> {};
+template <size_t A, size_t B, typename... Content> struct has_capture<repeat<A, B, Content...>> : std::bool_constant<(has_capture<Content>::value || ...)> {};
+
+// Normal form: captures become plain sequences and counted repeats are unrolled,
+// so only ?, * and + remain (Glushkov follow sets treat any repeat as a loop)
+template <typename T> struct normalize { using type = T; };
+template <typename T> using normalize_t = typename normalize<T>::type;
+
+template <typename T, size_t> using repeated = T;
+
+template <typename Content, size_t K> struct optional_chain {
+    using type = repeat<0, 1, sequence<Content, typename optional_chain<Content, K - 1>::type>>;
+};
+template <typename Content> struct optional_chain<Content, 1> { using type = repeat<0, 1, Content>; };
+
+template <size_t A, size_t B, typename Content, size_t... Is>
+auto unroll_repeat(std::index_sequence<Is...>) {
+    if constexpr (B == 0) return sequence<repeated<Content, Is>..., repeat<0, 0, Content>>{};
+    else if constexpr (B == A) return sequence<repeated<Content, Is>...>{};
+    else return sequence<repeated<Content, Is>..., typename optional_chain<Content, B - A>::type>{};
+}
+
+template <typename... Content> struct normalize<sequence<Content...>> { using type = sequence<normalize_t<Content>...>; };
+template <typename... Content> struct normalize<select<Content...>> { using type = select<normalize_t<Content>...>; };
+template <size_t Index, typename... Content> struct normalize<capture<Index, Content...>> { using type = sequence<normalize_t<Content>...>; };
+template <size_t Index, typename Name, typename... Content> struct normalize<capture_with_name<Index, Name, Content...>> { using type = sequence<normalize_t<Content>...>; };
+template <size_t A, size_t B, typename... Content> struct normalize<repeat<A, B, Content...>> {
+    using content = sequence<normalize_t<Content>...>;
+    using type = std::conditional_t<(A <= 1 && B <= 1), repeat<A, B, content>,
+                                    decltype(unroll_repeat<A, B, content>(std::make_index_sequence<A>{}))>;
+};
+
+// Positions after unrolling, computed without instantiating the unrolled type
+template <typename T> struct unrolled_positions : std::integral_constant<size_t, 1> {};
+template <typename T> inline constexpr size_t unrolled_positions_v = unrolled_positions<T>::value;
+template <> struct unrolled_positions<empty> : std::integral_constant<size_t, 0> {};
+template <auto... Str> struct unrolled_positions<string<Str...>> : std::integral_constant<size_t, sizeof...(Str)> {};
+template <typename... Content> struct unrolled_positions<sequence<Content...>> : std::integral_constant<size_t, (unrolled_positions_v<Content> + ... + 0)> {};
+template <typename... Content> struct unrolled_positions<select<Content...>> : std::integral_constant<size_t, (unrolled_positions_v<Content> + ... + 0)> {};
+template <size_t Index, typename... Content> struct unrolled_positions<capture<Index, Content...>> : std::integral_constant<size_t, (unrolled_positions_v<Content> + ... + 0)> {};
+template <size_t Index, typename Name, typename... Content> struct unrolled_positions<capture_with_name<Index, Name, Content...>> : std::integral_constant<size_t, (unrolled_positions_v<Content> + ... + 0)> {};
+template <size_t A, size_t B, typename... Content> struct unrolled_positions<repeat<A, B, Content...>>
+    : std::integral_constant<size_t, (unrolled_positions_v<Content> + ... + 0) * (B == 0 ? A + 1 : (B > 1 ? B : 1))> {};
+
+// Reversal of a normalized pattern, for finding where a match starts by scanning backwards
+// (rotate_for_lookbehind cannot rotate sequences nested in repeats)
+template <typename T> struct reverse { using type = T; };
+template <typename T> using reverse_t = typename reverse<T>::type;
+
+template <typename Reversed, typename... Rest> struct reverse_sequence { using type = Reversed; };
+template <typename... Done, typename Head, typename... Rest> struct reverse_sequence<sequence<Done...>, Head, Rest...> {
+    using type = typename reverse_sequence<sequence<reverse_t<Head>, Done...>, Rest...>::type;
+};
+template <typename Reversed, auto... Rest> struct reverse_string { using type = Reversed; };
+template <auto... Done, auto Head, auto... Rest> struct reverse_string<string<Done...>, Head, Rest...> {
+    using type = typename reverse_string<string<Head, Done...>, Rest...>::type;
+};
+template <typename... Content> struct reverse<sequence<Content...>> { using type = typename reverse_sequence<sequence<>, Content...>::type; };
+template <auto... Str> struct reverse<string<Str...>> { using type = typename reverse_string<string<>, Str...>::type; };
+template <typename... Content> struct reverse<select<Content...>> { using type = select<reverse_t<Content>...>; };
+template <size_t A, size_t B, typename Content> struct reverse<repeat<A, B, Content>> { using type = repeat<A, B, reverse_t<Content>>; };
+
+template <typename T> using reversed_t = reverse_t<normalize_t<T>>;
+
+// Set of byte values, one bit per byte
+struct byte_set {
+    std::array<uint64_t, 4> words{};
+
+    constexpr byte_set& set(unsigned char c) noexcept {
+        words[c >> 6] |= uint64_t{1} << (c & 63);
+        return *this;
+    }
+
+    [[nodiscard]] constexpr bool test(unsigned char c) const noexcept {
+        return (words[c >> 6] >> (c & 63)) & 1;
+    }
+
+    [[nodiscard]] static constexpr byte_set all() noexcept {
+        byte_set s;
+        for (auto& w : s.words) w = ~uint64_t{0};
+        return s;
+    }
+};
+
+using position_set = std::array<uint64_t, DFA_MAX_POSITIONS / 64>;
+
+constexpr void insert(position_set& s, size_t p) noexcept { s[p / 64] |= uint64_t{1} << (p % 64); }
+[[nodiscard]] constexpr bool contains(const position_set& s, size_t p) noexcept { return (s[p / 64] >> (p % 64)) & 1; }
+
+// Position automaton: position 0 is the start, follow[0] the first positions
+struct position_nfa {
+    size_t count = 1;
+    std::array<byte_set, DFA_MAX_POSITIONS> bytes{};
+    std::array<position_set, DFA_MAX_POSITIONS> follow{};
+    position_set accept{};
+
+    template <typename Positions>
+    constexpr void add_edges(size_t from, const Positions& to) noexcept {
+        for (size_t i = 0; i < to.second; ++i) insert(follow[from], to.first[i]);
+    }
+};
+
+template <typename T> constexpr void assign_bytes(position_nfa& nfa, size_t offset) noexcept;
+
+template <typename... Content>
+constexpr void assign_bytes_pack([[maybe_unused]] position_nfa& nfa, [[maybe_unused]] size_t offset) noexcept {
+    ((assign_bytes<Content>(nfa, offset), offset += glushkov::count_positions<Content>()), ...);
+}
+
+template <typename T> constexpr void assign_bytes(position_nfa& nfa, size_t offset) noexcept {
+    if constexpr (is_empty_v<T>) {
+    } else if constexpr (is_any_v<T>) {
+        nfa.bytes[offset + 1] = byte_set::all();
+    } else if constexpr (is_string_v<T>) {
+        [&]<auto... Str>(string<Str...>*) { assign_bytes_pack<character<Str>...>(nfa, offset); }(static_cast<T*>(nullptr));
+    } else if constexpr (is_sequence_v<T>) {
+        [&]<typename... Content>(sequence<Content...>*) { assign_bytes_pack<Content...>(nfa, offset); }(static_cast<T*>(nullptr));
+    } else if constexpr (is_select_v<T>) {
+        [&]<typename... Content>(select<Content...>*) { assign_bytes_pack<Content...>(nfa, offset); }(static_cast<T*>(nullptr));
+    } else if constexpr (is_repeat_v<T>) {
+        [&]<size_t A, size_t B, typename... Content>(repeat<A, B, Content...>*) { assign_bytes_pack<Content...>(nfa, offset); }(static_cast<T*>(nullptr));
+    } else {
+        // Same test evaluate() applies to char input
+        for (size_t c = 0; c < 256; ++c)
+            if (T::match_char(static_cast<char>(c), flags{})) nfa.bytes[offset + 1].set(static_cast<unsigned char>(c));
+    }
+}
+
+template <typename T> constexpr void build_follow(position_nfa& nfa, size_t offset) noexcept;
+
+template <typename... Content> constexpr void build_follow_sequence(position_nfa& nfa, size_t offset) noexcept {
+    if constexpr (sizeof...(Content) > 0) {
+        [&]<typename Head, typename... Tail>(Head*, Tail*...) {
+            build_follow<Head>(nfa, offset);
+            if constexpr (sizeof...(Tail) > 0) {
+                const size_t tail_offset = offset + glushkov::count_positions<Head>();
+                const auto head_last = glushkov::last_positions<Head>(offset);
+                const auto tail_first = glushkov::first_pack<Tail...>(tail_offset);
+                for (size_t i = 0; i < head_last.second; ++i) nfa.add_edges(head_last.first[i], tail_first);
+                build_follow_sequence<Tail...>(nfa, tail_offset);
+            }
+        }(static_cast<Content*>(nullptr)...);
+    }
+}
+
+template <typename T> constexpr void build_follow(position_nfa& nfa, size_t offset) noexcept {
+    if constexpr (is_string_v<T>) {
+        for (size_t i = 1; i < is_string<T>::length; ++i) insert(nfa.follow[offset + i], offset + i + 1);
+    } else if constexpr (is_sequence_v<T>) {
+        [&]<typename... Content>(sequence<Content...>*) { build_follow_sequence<Content...>(nfa, offset); }(static_cast<T*>(nullptr));
+    } else if constexpr (is_select_v<T>) {
+        [&]<typename... Content>(select<Content...>*) {
+            ((build_follow<Content>(nfa, offset), offset += glushkov::count_positions<Content>()), ...);
+        }(static_cast<T*>(nullptr));
+    } else if constexpr (is_repeat_v<T>) {
+        // Normalized repeats hold a single sequence and are ?, * or +
+        [&]<size_t A, size_t B, typename Content>(repeat<A, B, Content>*) {
+            build_follow<Content>(nfa, offset);
+            if constexpr (B != 1) {
+                const auto last = glushkov::last_positions<Content>(offset);
+                const auto first = glushkov::first_positions<Content>(offset);
+                for (size_t i = 0; i < last.second; ++i) nfa.add_edges(last.first[i], first);
+            }
+        }(static_cast<T*>(nullptr));
+    }
+}
+
+template <typename Pattern>
+[[nodiscard]] constexpr position_nfa make_position_nfa() noexcept {
+    position_nfa nfa;
+    nfa.count = glushkov::count_positions<Pattern>() + 1;
+    assign_bytes<Pattern>(nfa, 0);
+    build_follow<Pattern>(nfa, 0);
+    nfa.add_edges(0, glushkov::first_positions<Pattern>(0));
+    const auto last = glushkov::last_positions<Pattern>(0);
+    for (size_t i = 0; i < last.second; ++i) insert(nfa.accept, last.first[i]);
+    if constexpr (glushkov::nullable<Pattern>()) insert(nfa.accept, 0);
+    return nfa;
+}
+
+// Subset construction result at full capacity; state 0 is dead, state 1 the start
+template <size_t MaxStates>
+struct dfa_builder {
+    byte_partition classes{};
+    std::array<position_set, MaxStates> sets{};
+    std::array<std::array<uint16_t, 256>, MaxStates> next{};
+    std::array<bool, MaxStates> accepting{};
+    size_t state_count = 2;
+    bool overflow = false;
+};
+
+// Unanchored DFAs keep the start position in every state, so a match may begin anywhere
+template <typename Pattern, bool Unanchored, size_t MaxStates = DFA_MAX_STATES>
+[[nodiscard]] constexpr auto build_dfa() noexcept {
+    static_assert(MaxStates >= 2 && MaxStates <= 65536, "uint16_t state ids");
+    const position_nfa nfa = make_position_nfa<Pattern>();
+
+    // Positions each byte can enter; bytes with the same positions share a class
+    std::array<position_set, 256> byte_positions{};
+    for (size_t p = 1; p < nfa.count; ++p)
+        for (size_t c = 0; c < 256; ++c)
+            if (nfa.bytes[p].test(static_cast<unsigned char>(c))) insert(byte_positions[c], p);
+
+    dfa_builder<MaxStates> dfa;
+    dfa.classes = partition_bytes(byte_positions);
+
+    std::array<position_set, 256> class_positions{};
+    for (size_t k = 0; k < dfa.classes.count; ++k) class_positions[k] = byte_positions[dfa.classes.representative[k]];
+
+    const auto is_accepting = [&](const position_set& s) {
+        for (size_t w = 0; w < s.size(); ++w)
+            if (s[w] & nfa.accept[w]) return true;
+        return false;
+    };
+
+    insert(dfa.sets[1], 0);
+    dfa.accepting[1] = is_accepting(dfa.sets[1]);
+
+    for (size_t state = 1; state < dfa.state_count; ++state) {
+        position_set reachable{};
+        for (size_t p = 0; p < nfa.count; ++p)
+            if (contains(dfa.sets[state], p))
+                for (size_t w = 0; w < reachable.size(); ++w) reachable[w] |= nfa.follow[p][w];
+
+        for (size_t k = 0; k < dfa.classes.count; ++k) {
+            position_set target{};
+            bool empty_target = true;
+            for (size_t w = 0; w < target.size(); ++w) {
+                target[w] = reachable[w] & class_positions[k][w];
+                empty_target = empty_target && target[w] == 0;
+            }
+            if constexpr (Unanchored) {
+                insert(target, 0);
+                empty_target = false;
+            }
+            if (empty_target) continue; // dead state
+
+            size_t found = 1;
+            while (found < dfa.state_count && dfa.sets[found] != target) ++found;
+            if (found == dfa.state_count) {
+                if (dfa.state_count == MaxStates) {
+                    dfa.overflow = true;
+                    return dfa;
+                }
+                dfa.sets[found] = target;
+                dfa.accepting[found] = is_accepting(target);
+                ++dfa.state_count;
+            }
+            dfa.next[state][k] = static_cast<uint16_t>(found);
+        }
+    }
+    return dfa;
+}
+
+// Final table, sized exactly: next[state * Classes + class_of[byte]]
+template <size_t States, size_t Classes>
+struct dfa_table {
+    static constexpr size_t state_count = States;
+    static constexpr size_t class_count = Classes;
+    static constexpr uint16_t dead_state = 0;
+    static constexpr uint16_t start_state = 1;
+
+    std::array<uint8_t, 256> class_of{};
+    std::array<uint16_t, States * Classes> next{};
+    std::array<bool, States> accepting{};
+
+    [[nodiscard]] constexpr uint16_t step(uint16_t state, char c) const noexcept {
+        return next[state * Classes + class_of[static_cast<unsigned char>(c)]];
+    }
+};
+
+template <typename Pattern, bool Unanchored>
+inline constexpr auto dfa_builder_v = build_dfa<normalize_t<Pattern>, Unanchored>();
+
+template <typename Pattern, bool Unanchored>
+[[nodiscard]] constexpr auto make_dfa_table() noexcept {
+    constexpr auto& built = dfa_builder_v<Pattern, Unanchored>;
+    dfa_table<built.state_count, built.classes.count> table;
+    table.class_of = built.classes.class_of;
+    for (size_t s = 0; s < built.state_count; ++s) {
+        table.accepting[s] = built.accepting[s];
+        for (size_t k = 0; k < built.classes.count; ++k) table.next[s * built.classes.count + k] = built.next[s][k];
+    }
+    return table;
+}
+
+// Whether Pattern compiles to a DFA within the position and state caps
+template <typename Pattern, bool Unanchored = false>
+[[nodiscard]] consteval bool dfa_viable() noexcept {
+    if constexpr (!is_dfa_compatible<Pattern>::value) return false;
+    else if constexpr (unrolled_positions_v<Pattern> + 1 > DFA_MAX_POSITIONS) return false;
+    else return !dfa_builder_v<Pattern, Unanchored>.overflow;
+}
+
+template <typename Pattern> inline constexpr bool dfa_viable_v = dfa_viable<Pattern>();
+
+// Anchored DFA of the pattern, and unanchored DFA of the reversed pattern
+template <typename Pattern> inline constexpr auto forward_dfa = make_dfa_table<Pattern, false>();
+template <typename Pattern> inline constexpr auto reverse_dfa = make_dfa_table<reversed_t<Pattern>, true>();
+
+// Whether the whole of [begin, end) is accepted
+template <typename Table>
+[[nodiscard]] constexpr bool run_anchored(const Table& dfa, const char* begin, const char* end) noexcept {
+    uint16_t state = Table::start_state;
+    for (const char* p = begin; p != end; ++p) {
+        state = dfa.step(state, *p);
+        if (state == Table::dead_state) return false;
+    }
+    return dfa.accepting[state];
+}
+
+// End of the longest match starting at begin, or nullptr
+template <typename Table>
+[[nodiscard]] constexpr const char* longest_from(const Table& dfa, const char* begin, const char* end) noexcept {
+    uint16_t state = Table::start_state;
+    const char* last_accept = dfa.accepting[state] ? begin : nullptr;
+    for (const char* p = begin; p != end; ++p) {
+        state = dfa.step(state, *p);
+        if (state == Table::dead_state) break;
+        if (dfa.accepting[state]) last_accept = p + 1;
+    }
+    return last_accept;
+}
+
+// Start of the longest match of a reversed pattern's anchored DFA ending at end, scanning
+// back no further than begin, or nullptr
+template <typename Table>
+[[nodiscard]] constexpr const char* longest_to(const Table& reverse, const char* begin, const char* end) noexcept {
+    uint16_t state = Table::start_state;
+    const char* first_accept = reverse.accepting[state] ? end : nullptr;
+    for (const char* p = end; p != begin;) {
+        state = reverse.step(state, *--p);
+        if (state == Table::dead_state) break;
+        if (reverse.accepting[state]) first_accept = p;
+    }
+    return first_accept;
+}
+
+// Whether a match starts at begin: the walk ends at the first accepting or the dead state
+template <typename Table>
+[[nodiscard]] constexpr bool match_starts_at(const Table& dfa, const char* begin, const char* end) noexcept {
+    uint16_t state = Table::start_state;
+    if (dfa.accepting[state]) return true;
+    for (const char* p = begin; p != end; ++p) {
+        state = dfa.step(state, *p);
+        if (state == Table::dead_state) return false;
+        if (dfa.accepting[state]) return true;
+    }
+    return false;
+}
+
+// Leftmost start of any match, found by one backward pass of the reversed
+// pattern's unanchored DFA, or nullptr
+template <typename Table>
+[[nodiscard]] constexpr const char* leftmost_start(const Table& reverse, const char* begin, const char* end) noexcept {
+    uint16_t state = Table::start_state;
+    const char* start = reverse.accepting[state] ? end : nullptr;
+    for (const char* p = end; p != begin;) {
+        state = reverse.step(state, *--p);
+        if (reverse.accepting[state]) start = p;
+    }
+    return start;
+}
+
+// Leftmost start of any match, or nullptr. The anchored DFA runs from each start in
+// turn until it accepts or dies, so the work ends near the match instead of covering
+// the input; when those runs grow long (bytes that keep many starts alive) one backward
+// pass of the reversed DFA over the rest takes over, which keeps the search linear
+template <typename Forward, typename Reverse>
+[[nodiscard]] constexpr const char* first_match_start(const Forward& forward, const Reverse& reverse,
+                                                      const char* begin, const char* end) noexcept {
+    size_t budget = 256; // DFA steps, plus a few per start tried
+    for (const char* start = begin;; ++start) {
+        uint16_t state = Forward::start_state;
+        if (forward.accepting[state]) return start;
+        for (const char* p = start; p != end; ++p) {
+            if (budget-- == 0) return leftmost_start(reverse, start, end);
+            state = forward.step(state, *p);
+            if (state == Forward::dead_state) break;
+            if (forward.accepting[state]) return start;
+        }
+        if (start == end) return nullptr;
+        budget += 8;
+    }
+}
+
+} // namespace ctre::dfa
+
+#endif // CTRE_DFA_COMPILE_DFA_HPP
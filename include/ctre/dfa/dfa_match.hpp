@@ -0,0 +1,63 @@
+#ifndef CTRE_DFA_DFA_MATCH_HPP
+#define CTRE_DFA_DFA_MATCH_HPP
+
+#include "compile_dfa.hpp"
+#include "../../ctre.hpp"
+#include <string_view>
+
+namespace ctre::dfa {
+
+// Results carry only the whole match
+using dfa_result = return_type<const char*, empty>;
+
+template <typename AST>
+[[nodiscard]] constexpr auto match_from_ast(std::string_view input) noexcept {
+    static_assert(dfa_viable_v<AST>, "Pattern has no DFA: it uses assertions, lookarounds, backreferences, "
+                                     "lazy/possessive repeats or exceeds the state cap");
+    dfa_result result;
+    const char* begin = input.data();
+    const char* end = begin + input.size();
+    if (run_anchored(forward_dfa<AST>, begin, end)) result.set_start_mark(begin).set_end_mark(end).matched();
+    return result;
+}
+
+// Leftmost-longest search in O(n): the backward pass fixes the start, the forward
+// pass from there the longest end
+template <typename AST>
+[[nodiscard]] constexpr auto search_from_ast(std::string_view input) noexcept {
+    static_assert(dfa_viable_v<AST> && dfa_viable<reversed_t<AST>, true>(),
+                  "Pattern has no DFA: it uses assertions, lookarounds, backreferences, "
+                  "lazy/possessive repeats or exceeds the state cap");
+    dfa_result result;
+    const char* begin = input.data();
+    const char* end = begin + input.size();
+    if (const char* start = leftmost_start(reverse_dfa<AST>, begin, end))
+        result.set_start_mark(start).set_end_mark(longest_from(forward_dfa<AST>, start, end)).matched();
+    return result;
+}
+
+} // namespace ctre::dfa
+
+namespace ctre {
+
+// Whole-input match on the compile-time DFA; capture groups are matched but not reported
+template <ctll::fixed_string Pattern>
+[[nodiscard]] constexpr auto dfa_match(std::string_view input) noexcept {
+    using tmp = typename ctll::parser<pcre, Pattern, pcre_actions>::template output<pcre_context<>>;
+    static_assert(tmp(), "Regular Expression contains syntax error.");
+    using AST = decltype(ctll::front(typename tmp::output_type::stack_type()));
+    return dfa::match_from_ast<AST>(input);
+}
+
+// Leftmost-longest search on the compile-time DFA
+template <ctll::fixed_string Pattern>
+[[nodiscard]] constexpr auto dfa_search(std::string_view input) noexcept {
+    using tmp = typename ctll::parser<pcre, Pattern, pcre_actions>::template output<pcre_context<>>;
+    static_assert(tmp(), "Regular Expression contains syntax error.");
+    using AST = decltype(ctll::front(typename tmp::output_type::stack_type()));
+    return dfa::search_from_ast<AST>(input);
+}
+
+} // namespace ctre
+
+#endif // CTRE_DFA_DFA_MATCH_HPP
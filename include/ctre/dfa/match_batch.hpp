@@ -0,0 +1,208 @@
+#ifndef CTRE_DFA_MATCH_BATCH_HPP
+#define CTRE_DFA_MATCH_BATCH_HPP
+
+#include "sheng.hpp"
+#include "../../ctre.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <string_view>
+
+// Whole-input matching of many short strings at once. 16 (SSSE3) or 32 (AVX2)
+// inputs are transposed into byte lanes, already mapped to byte classes, and every
+// lane steps its own Sheng DFA state: each class row is shuffled by the state vector
+// and kept in the lanes whose byte has that class. Lanes whose input has ended see
+// a class no row answers to, so their state is left alone.
+
+namespace ctre::dfa {
+
+// Every step costs one shuffle per class; beyond this one lane per input is cheaper
+inline constexpr size_t SHENG_BATCH_MAX_CLASSES = 8;
+// Positions transposed at a time
+inline constexpr size_t SHENG_BATCH_BLOCK = 64;
+
+template <typename Pattern>
+[[nodiscard]] consteval bool sheng_batch_viable() noexcept {
+    if constexpr (!sheng_fits<Pattern>()) return false;
+    else return sheng_v<Pattern>.class_count <= SHENG_BATCH_MAX_CLASSES;
+}
+
+template <typename Pattern> inline constexpr bool sheng_batch_v = sheng_batch_viable<Pattern>();
+
+// classes[j][i]: class of byte base + j of input i, or Classes past its end
+template <size_t Classes, size_t Lanes>
+inline void sheng_transpose(const sheng_table<Classes>& t, const std::string_view* inputs, size_t count, size_t base,
+                            size_t block, uint8_t (&classes)[SHENG_BATCH_BLOCK][Lanes]) noexcept {
+    std::memset(classes, static_cast<int>(Classes), block * Lanes);
+    for (size_t i = 0; i < count; ++i) {
+        const auto* s = reinterpret_cast<const unsigned char*>(inputs[i].data());
+        const size_t stop = std::min(inputs[i].size(), base + block);
+        for (size_t j = base; j < stop; ++j) classes[j - base][i] = t.class_of[s[j]];
+    }
+}
+
+template <size_t Classes>
+[[nodiscard]] constexpr auto sheng_accept_row(const sheng_table<Classes>& t) noexcept {
+    std::array<uint8_t, SHENG_MAX_STATES> row{};
+    for (size_t s = 0; s < SHENG_MAX_STATES; ++s) row[s] = t.accepts(static_cast<uint8_t>(s)) ? 0xFF : 0x00;
+    return row;
+}
+
+[[nodiscard]] inline size_t longest_input(const std::string_view* inputs, size_t count) noexcept {
+    size_t longest = 0;
+    for (size_t i = 0; i < count; ++i) longest = std::max(longest, inputs[i].size());
+    return longest;
+}
+
+#ifdef CTRE_ARCH_X86
+// Bit i set if inputs[i] matches; count <= 32
+template <size_t Classes>
+[[nodiscard]] CTRE_TARGET_AVX2 inline uint32_t sheng_batch_avx2(const sheng_table<Classes>& t,
+                                                                const std::string_view* inputs, size_t count) noexcept {
+    __m256i rows[Classes];
+    for (size_t k = 0; k < Classes; ++k)
+        rows[k] = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(t.rows[k].data())));
+
+    alignas(32) uint8_t classes[SHENG_BATCH_BLOCK][32];
+    __m256i state = _mm256_set1_epi8(static_cast<char>(t.start_state));
+    const size_t length = longest_input(inputs, count);
+    for (size_t base = 0; base < length; base += SHENG_BATCH_BLOCK) {
+        const size_t block = std::min(SHENG_BATCH_BLOCK, length - base);
+        sheng_transpose(t, inputs, count, base, block, classes);
+        for (size_t j = 0; j < block; ++j) {
+            const __m256i c = _mm256_load_si256(reinterpret_cast<const __m256i*>(classes[j]));
+            __m256i next = state;
+            for (size_t k = 0; k < Classes; ++k) {
+                const __m256i lanes = _mm256_cmpeq_epi8(c, _mm256_set1_epi8(static_cast<char>(k)));
+                next = _mm256_blendv_epi8(next, _mm256_shuffle_epi8(rows[k], state), lanes);
+            }
+            state = next;
+        }
+        if (static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(state, _mm256_setzero_si256()))) == ~0u)
+            return 0;
+    }
+
+    const auto accept = sheng_accept_row(t);
+    const __m256i accept_row = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(accept.data())));
+    const auto matched = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_shuffle_epi8(accept_row, state)));
+    return count == 32 ? matched : matched & ((1u << count) - 1);
+}
+
+// Bit i set if inputs[i] matches; count <= 16
+template <size_t Classes>
+[[nodiscard]] CTRE_TARGET_SSE42 inline uint32_t sheng_batch_ssse3(const sheng_table<Classes>& t,
+                                                                  const std::string_view* inputs,
+                                                                  size_t count) noexcept {
+    __m128i rows[Classes];
+    for (size_t k = 0; k < Classes; ++k) rows[k] = _mm_load_si128(reinterpret_cast<const __m128i*>(t.rows[k].data()));
+
+    alignas(16) uint8_t classes[SHENG_BATCH_BLOCK][16];
+    __m128i state = _mm_set1_epi8(static_cast<char>(t.start_state));
+    const size_t length = longest_input(inputs, count);
+    for (size_t base = 0; base < length; base += SHENG_BATCH_BLOCK) {
+        const size_t block = std::min(SHENG_BATCH_BLOCK, length - base);
+        sheng_transpose(t, inputs, count, base, block, classes);
+        for (size_t j = 0; j < block; ++j) {
+            const __m128i c = _mm_load_si128(reinterpret_cast<const __m128i*>(classes[j]));
+            __m128i next = state;
+            for (size_t k = 0; k < Classes; ++k) {
+                const __m128i lanes = _mm_cmpeq_epi8(c, _mm_set1_epi8(static_cast<char>(k)));
+                next = _mm_or_si128(_mm_andnot_si128(lanes, next), _mm_and_si128(lanes, _mm_shuffle_epi8(rows[k], state)));
+            }
+            state = next;
+        }
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(state, _mm_setzero_si128())) == 0xFFFF) return 0;
+    }
+
+    const auto accept = sheng_accept_row(t);
+    const __m128i accept_row = _mm_loadu_si128(reinterpret_cast<const __m128i*>(accept.data()));
+    const auto matched = static_cast<uint32_t>(_mm_movemask_epi8(_mm_shuffle_epi8(accept_row, state)));
+    return matched & ((1u << count) - 1);
+}
+
+// Whole lanes of inputs from i on; returns the first input left over
+template <size_t Classes>
+[[nodiscard]] CTRE_TARGET_SSE42 inline size_t sheng_batch_lanes_sse42(const sheng_table<Classes>& t,
+                                                                      const std::string_view* inputs, size_t count,
+                                                                      uint64_t* matched, size_t i) noexcept {
+    for (; count - i >= 16; i += 16) matched[i / 64] |= uint64_t{sheng_batch_ssse3(t, inputs + i, 16)} << (i % 64);
+    return i;
+}
+
+template <size_t Classes>
+[[nodiscard]] CTRE_TARGET_AVX2 inline size_t sheng_batch_lanes_avx2(const sheng_table<Classes>& t,
+                                                                    const std::string_view* inputs, size_t count,
+                                                                    uint64_t* matched, size_t i) noexcept {
+    for (; count - i >= 32; i += 32) matched[i / 64] |= uint64_t{sheng_batch_avx2(t, inputs + i, 32)} << (i % 64);
+    return sheng_batch_lanes_sse42(t, inputs, count, matched, i);
+}
+#else
+template <size_t Classes>
+[[nodiscard]] inline size_t sheng_batch_lanes_sse42(const sheng_table<Classes>&, const std::string_view*, size_t,
+                                                    uint64_t*, size_t i) noexcept {
+    return i;
+}
+
+template <size_t Classes>
+[[nodiscard]] inline size_t sheng_batch_lanes_avx2(const sheng_table<Classes>&, const std::string_view*, size_t,
+                                                   uint64_t*, size_t i) noexcept {
+    return i;
+}
+#endif // CTRE_ARCH_X86
+
+template <size_t Classes>
+[[nodiscard]] inline size_t sheng_batch_lanes_scalar(const sheng_table<Classes>&, const std::string_view*, size_t,
+                                                     uint64_t*, size_t i) noexcept {
+    return i;
+}
+
+// Bit i set if inputs[i] matches, for any count; lanes of 32, 16 or one input
+template <size_t Classes>
+inline void sheng_batch(const sheng_table<Classes>& t, const std::string_view* inputs, size_t count,
+                        uint64_t* matched) noexcept {
+    size_t i = simd::dispatch_kernel<&sheng_batch_lanes_avx2<Classes>, &sheng_batch_lanes_sse42<Classes>,
+                                     &sheng_batch_lanes_scalar<Classes>>(t, inputs, count, matched, size_t{0});
+    for (; i < count; ++i)
+        if (t.accepts(sheng_run(t, inputs[i].data(), inputs[i].data() + inputs[i].size())))
+            matched[i / 64] |= uint64_t{1} << (i % 64);
+}
+
+} // namespace ctre::dfa
+
+namespace ctre {
+
+// Whole-input match of every string in inputs: bit i of matched (word i / 64) tells
+// whether inputs[i] matches. matched needs (inputs.size() + 63) / 64 words, a shorter
+// span only gets the first matched.size() * 64 inputs tested; returns the number of
+// matching inputs. Patterns outside the Sheng DFA fall back to one ctre::match per input.
+template <ctll::fixed_string Pattern>
+size_t match_batch(std::span<const std::string_view> inputs, std::span<uint64_t> matched) noexcept {
+    using tmp = typename ctll::parser<pcre, Pattern, pcre_actions>::template output<pcre_context<>>;
+    static_assert(tmp(), "Regular Expression contains syntax error.");
+    using AST = decltype(ctll::front(typename tmp::output_type::stack_type()));
+
+    if (inputs.size() > matched.size() * 64) inputs = inputs.first(matched.size() * 64);
+    const size_t words = (inputs.size() + 63) / 64;
+    std::fill_n(matched.begin(), words, uint64_t{0});
+
+    if constexpr (dfa::sheng_batch_v<AST>) {
+        dfa::sheng_batch(dfa::sheng_v<AST>, inputs.data(), inputs.size(), matched.data());
+    } else if constexpr (dfa::sheng_fits<AST>()) {
+        constexpr auto& table = dfa::sheng_v<AST>;
+        for (size_t i = 0; i < inputs.size(); ++i)
+            if (table.accepts(dfa::sheng_run(table, inputs[i].data(), inputs[i].data() + inputs[i].size())))
+                matched[i / 64] |= uint64_t{1} << (i % 64);
+    } else {
+        for (size_t i = 0; i < inputs.size(); ++i)
+            if (ctre::match<Pattern>(inputs[i])) matched[i / 64] |= uint64_t{1} << (i % 64);
+    }
+
+    size_t total = 0;
+    for (size_t w = 0; w < words; ++w) total += static_cast<size_t>(__builtin_popcountll(matched[w]));
+    return total;
+}
+
+} // namespace ctre
+
+#endif // CTRE_DFA_MATCH_BATCH_HPP
@@ -0,0 +1,132 @@
+#ifndef CTRE_DFA_SHENG_HPP
+#define CTRE_DFA_SHENG_HPP
+
+#include "compile_dfa.hpp"
+#include "../simd/detection.hpp"
+#include <array>
+#include <cstdint>
+#include <type_traits>
+#ifdef CTRE_ARCH_X86
+#include <immintrin.h>
+#endif
+
+// Sheng (Hyperscan): a DFA of at most 16 states keeps its state in a byte lane, and
+// every byte class owns a 16-byte row of successor states, so one transition is a
+// single PSHUFB of the row by the state. The loop-carried dependency is that shuffle
+// alone; the class and row loads only depend on the input.
+
+namespace ctre::dfa {
+
+inline constexpr size_t SHENG_MAX_STATES = 16;
+// Bounds the compile-time subset construction done for every candidate pattern
+inline constexpr size_t SHENG_MAX_POSITIONS = 64;
+
+template <typename Pattern>
+inline constexpr auto sheng_builder_v = build_dfa<normalize_t<Pattern>, false, SHENG_MAX_STATES>();
+
+// Patterns whose anchored DFA (dead state included) fits 16 states; capture groups
+// are matched as plain groups
+template <typename Pattern>
+[[nodiscard]] consteval bool sheng_fits() noexcept {
+    if constexpr (!is_dfa_compatible<Pattern>::value) return false;
+    else if constexpr (unrolled_positions_v<Pattern> + 1 > SHENG_MAX_POSITIONS) return false;
+    else return !sheng_builder_v<Pattern>.overflow;
+}
+
+// Only capture-free patterns replace evaluate: they need no capture positions
+template <typename Pattern>
+[[nodiscard]] consteval bool sheng_viable() noexcept {
+    if constexpr (has_capture<Pattern>::value) return false;
+    else return sheng_fits<Pattern>();
+}
+
+template <typename Pattern> inline constexpr bool sheng_viable_v = sheng_viable<Pattern>();
+
+// rows[class][state] is the successor of state on any byte of class
+template <size_t Classes>
+struct sheng_table {
+    static constexpr size_t class_count = Classes;
+    static constexpr uint8_t dead_state = 0;
+    static constexpr uint8_t start_state = 1;
+
+    alignas(16) std::array<std::array<uint8_t, SHENG_MAX_STATES>, Classes> rows{};
+    std::array<uint8_t, 256> class_of{};
+    uint16_t accepting = 0; // bit per state
+    size_t state_count = 0;
+
+    [[nodiscard]] constexpr bool accepts(uint8_t state) const noexcept { return (accepting >> state) & 1u; }
+};
+
+template <typename Pattern>
+[[nodiscard]] constexpr auto make_sheng_table() noexcept {
+    constexpr auto& built = sheng_builder_v<Pattern>;
+    sheng_table<built.classes.count> table;
+    table.class_of = built.classes.class_of;
+    table.state_count = built.state_count;
+    for (size_t s = 0; s < built.state_count; ++s) {
+        if (built.accepting[s]) table.accepting |= static_cast<uint16_t>(1u << s);
+        for (size_t k = 0; k < built.classes.count; ++k) table.rows[k][s] = static_cast<uint8_t>(built.next[s][k]);
+    }
+    return table;
+}
+
+template <typename Pattern> inline constexpr auto sheng_v = make_sheng_table<Pattern>();
+
+template <size_t Classes>
+[[nodiscard]] constexpr uint8_t sheng_run_scalar(const sheng_table<Classes>& t, const char* begin,
+                                                 const char* end) noexcept {
+    uint8_t state = t.start_state;
+    for (const char* p = begin; p != end && state != t.dead_state; ++p)
+        state = t.rows[t.class_of[static_cast<unsigned char>(*p)]][state];
+    return state;
+}
+
+#ifdef CTRE_ARCH_X86
+// Every lane holds the state; the dead state is only checked once per 16 bytes
+template <size_t Classes>
+[[nodiscard]] CTRE_TARGET_SSE42 inline uint8_t sheng_run_ssse3(const sheng_table<Classes>& t, const char* begin,
+                                                               const char* end) noexcept {
+    const uint8_t* __restrict cls = t.class_of.data();
+    const auto row = [&](char c) {
+        return _mm_load_si128(reinterpret_cast<const __m128i*>(t.rows[cls[static_cast<unsigned char>(c)]].data()));
+    };
+
+    __m128i state = _mm_set1_epi8(static_cast<char>(t.start_state));
+    const char* p = begin;
+    while (end - p >= 16) {
+        for (int i = 0; i < 16; ++i) state = _mm_shuffle_epi8(row(p[i]), state);
+        p += 16;
+        if (static_cast<uint8_t>(_mm_cvtsi128_si32(state)) == t.dead_state) return t.dead_state;
+    }
+    for (; p != end; ++p) state = _mm_shuffle_epi8(row(*p), state);
+    return static_cast<uint8_t>(_mm_cvtsi128_si32(state));
+}
+#else
+template <size_t Classes>
+[[nodiscard]] inline uint8_t sheng_run_ssse3(const sheng_table<Classes>& t, const char* begin,
+                                             const char* end) noexcept {
+    return sheng_run_scalar(t, begin, end);
+}
+#endif
+
+// Final state after consuming [begin, end) from the start state; the 128-bit
+// shuffle is the widest step, AVX2 machines run it too
+template <size_t Classes>
+[[nodiscard]] constexpr uint8_t sheng_run(const sheng_table<Classes>& t, const char* begin, const char* end) noexcept {
+    if (!std::is_constant_evaluated()) {
+        return simd::dispatch_kernel<&sheng_run_ssse3<Classes>, &sheng_run_ssse3<Classes>, &sheng_run_scalar<Classes>>(
+            t, begin, end);
+    }
+    return sheng_run_scalar(t, begin, end);
+}
+
+// Whole-input match
+template <typename Pattern>
+[[nodiscard]] constexpr bool sheng_accepts(const char* begin, const char* end) noexcept {
+    constexpr auto& table = sheng_v<Pattern>;
+    return table.accepts(sheng_run(table, begin, end));
+}
+
+} // namespace ctre::dfa
+
+#endif // CTRE_DFA_SHENG_HPP
@@ -0,0 +1,118 @@
+#ifndef CTRE_DFA_STREAM_MATCHER_HPP
+#define CTRE_DFA_STREAM_MATCHER_HPP
+
+#include "compile_dfa.hpp"
+#include "../../ctre.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+// Streaming search over chunked input. The anchored DFA is run from every offset at
+// once; runs that reach the same state behave alike from then on, so only the one
+// with the earliest start is kept. That bounds the carried state by the DFA's state
+// count and lets every chunk be scanned in place.
+
+namespace ctre {
+
+// Global byte offsets of a match, end exclusive
+struct stream_match {
+    size_t start = 0;
+    size_t end = 0;
+
+    friend constexpr bool operator==(const stream_match&, const stream_match&) noexcept = default;
+};
+
+// Reports, for every offset where a match ends, the leftmost start of a match ending
+// there (Hyperscan's leftmost start-of-match semantics): matches may overlap, and the
+// match is reported as soon as its last byte has been fed, even across chunks.
+// Capture groups are matched but not reported.
+template <ctll::fixed_string Pattern>
+class stream_matcher {
+    using tmp = typename ctll::parser<pcre, Pattern, pcre_actions>::template output<pcre_context<>>;
+    static_assert(tmp(), "Regular Expression contains syntax error.");
+    using AST = decltype(ctll::front(typename tmp::output_type::stack_type()));
+    static_assert(dfa::dfa_viable_v<AST>, "Pattern has no DFA: it uses assertions, lookarounds, backreferences, "
+                                          "lazy/possessive repeats or exceeds the state cap");
+    static_assert(!glushkov::nullable<dfa::normalize_t<AST>>(),
+                  "A pattern matching the empty string would match at every offset");
+
+    static constexpr auto& table = dfa::forward_dfa<AST>;
+    static constexpr size_t max_runs = table.state_count;
+
+    // Bytes on which a run can leave the start state
+    static constexpr auto starting_bytes = [] {
+        std::array<bool, 256> bytes{};
+        for (size_t c = 0; c < 256; ++c)
+            bytes[c] = table.step(table.start_state, static_cast<char>(c)) != table.dead_state;
+        return bytes;
+    }();
+
+    // Live runs ordered by start
+    std::array<uint16_t, max_runs> run_state{};
+    std::array<size_t, max_runs> run_start{};
+    size_t run_count = 0;
+    std::array<uint32_t, max_runs> seen{};
+    uint32_t generation = 0;
+    size_t position = 0;
+
+    template <typename Callback>
+    void step(char c, size_t offset, Callback& on_match) {
+        if (++generation == 0) {
+            seen.fill(0);
+            generation = 1;
+        }
+        size_t live = 0;
+        bool reported = false;
+        const auto advance = [&](uint16_t from, size_t start) {
+            const uint16_t next = table.step(from, c);
+            if (next == table.dead_state || seen[next] == generation) return;
+            seen[next] = generation;
+            run_state[live] = next;
+            run_start[live] = start;
+            ++live;
+            if (table.accepting[next] && !reported) {
+                reported = true;
+                on_match(stream_match{start, offset + 1});
+            }
+        };
+        for (size_t i = 0; i < run_count; ++i) advance(run_state[i], run_start[i]);
+        // The run starting here comes last: it has the latest start
+        advance(table.start_state, offset);
+        run_count = live;
+    }
+
+public:
+    // Scan the next chunk; on_match(stream_match) is called in order of match end
+    template <typename Callback>
+    void feed(std::string_view chunk, Callback&& on_match) {
+        const char* const begin = chunk.data();
+        const char* const end = begin + chunk.size();
+        const char* p = begin;
+        while (p != end) {
+            if (run_count == 0) {
+                // Nothing in flight: skip bytes no match can start with
+                while (p != end && !starting_bytes[static_cast<unsigned char>(*p)]) ++p;
+                if (p == end) break;
+            }
+            step(*p, position + static_cast<size_t>(p - begin), on_match);
+            ++p;
+        }
+        position += chunk.size();
+    }
+
+    // End of stream: drops partial runs and returns the stream length; the matcher
+    // can then be reused for a new stream
+    size_t finish() noexcept {
+        const size_t length = position;
+        run_count = 0;
+        position = 0;
+        return length;
+    }
+
+    [[nodiscard]] size_t offset() const noexcept { return position; }
+};
+
+} // namespace ctre
+
+#endif // CTRE_DFA_STREAM_MATCHER_HPP
@@ -0,0 +1,58 @@
+#ifndef CTRE_DFA_TWO_PHASE_HPP
+#define CTRE_DFA_TWO_PHASE_HPP
+
+#include "compile_dfa.hpp"
+#include "sheng.hpp"
+#include <cstddef>
+
+// Two-phase execution for patterns with capture groups. The DFA (captures matched
+// as plain groups by normalize) decides first whether and where a match can be;
+// evaluate then only runs to fill the captures of subjects that have one. A DFA
+// match is regular-language membership, so rejecting is exact, while accepting
+// still defers to evaluate for the result.
+
+namespace ctre::dfa {
+
+// Bounds the compile-time subset construction done for every capture pattern
+inline constexpr size_t TWO_PHASE_MAX_POSITIONS = 64;
+
+template <typename Pattern>
+[[nodiscard]] consteval bool two_phase_bounded() noexcept {
+    if constexpr (!has_capture<Pattern>::value || !is_dfa_compatible<Pattern>::value) return false;
+    else return unrolled_positions_v<Pattern> + 1 <= TWO_PHASE_MAX_POSITIONS;
+}
+
+template <typename Pattern>
+[[nodiscard]] consteval bool two_phase_match() noexcept {
+    if constexpr (!two_phase_bounded<Pattern>()) return false;
+    else if constexpr (sheng_fits<Pattern>()) return true;
+    else return !dfa_builder_v<Pattern, false>.overflow;
+}
+
+template <typename Pattern>
+[[nodiscard]] consteval bool two_phase_search() noexcept {
+    if constexpr (!two_phase_bounded<Pattern>()) return false;
+    else return !dfa_builder_v<Pattern, false>.overflow && !dfa_builder_v<reversed_t<Pattern>, true>.overflow;
+}
+
+template <typename Pattern> inline constexpr bool two_phase_match_v = two_phase_match<Pattern>();
+template <typename Pattern> inline constexpr bool two_phase_search_v = two_phase_search<Pattern>();
+
+// Whether evaluate can match the whole of [begin, end); small DFAs run on Sheng
+template <typename Pattern>
+[[nodiscard]] constexpr bool two_phase_accepts(const char* begin, const char* end) noexcept {
+    if constexpr (sheng_fits<Pattern>()) return sheng_accepts<Pattern>(begin, end);
+    else return run_anchored(forward_dfa<Pattern>, begin, end);
+}
+
+// First position evaluate can match at, or nullptr; the end is left to evaluate,
+// the DFA's longest end is not the leftmost-first one. search_all calls this once
+// per match, so the work has to stop near the match rather than cover the input
+template <typename Pattern>
+[[nodiscard]] constexpr const char* two_phase_start(const char* begin, const char* end) noexcept {
+    return first_match_start(forward_dfa<Pattern>, reverse_dfa<Pattern>, begin, end);
+}
+
+} // namespace ctre::dfa
+
+#endif // CTRE_DFA_TWO_PHASE_HPP
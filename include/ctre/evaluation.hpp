@@ -17,6 +17,7 @@
 #include "simd/shufti.hpp"
 #include "simd/single_char.hpp"
 #include "simd/string_matching.hpp"
+#include "simd/wide_classes.hpp"
 #else
 #include "simd/stubs.hpp"
 #endif
@@ -147,8 +148,8 @@ constexpr CTRE_FORCE_INLINE bool match_string([[maybe_unused]] Iterator& current
     [[maybe_unused]] constexpr size_t string_length = sizeof...(String);
 
     // SIMD for long strings
-    if constexpr (string_length >= simd::SIMD_STRING_THRESHOLD) {
-        if (!std::is_constant_evaluated() && simd::can_use_simd()) {
+    if constexpr (simd::can_use_simd() && string_length >= simd::SIMD_STRING_THRESHOLD) {
+        if (!std::is_constant_evaluated()) {
             return simd::match_string_simd<String...>(current, last, f);
         }
     }
@@ -655,6 +656,30 @@ constexpr CTRE_FORCE_INLINE R evaluate(const BeginIterator begin, Iterator curre
         }
     }
 
+    // Single character content (also greedy repeats turned possessive, like [a-z]+@):
+    // nothing to backtrack into and no captures to update, so just scan
+    if constexpr (sizeof...(Content) == 1) {
+        using ContentType = std::tuple_element_t<0, std::tuple<Content...>>;
+        if constexpr (MatchesCharacter<ContentType>::template value<decltype(*current)>) {
+            const auto backup_current = current;
+            size_t count = 0;
+            // wchar_t, char16_t and char32_t runs on 16/32-bit lanes, the loop takes what is left
+            if constexpr (simd::wide_repeat_viable<ContentType, Iterator, EndIterator>()) {
+                if (!std::is_constant_evaluated()) {
+                    count = simd::wide_class_run<ContentType>(current, last, B, f);
+                    current += static_cast<std::ptrdiff_t>(count);
+                }
+            }
+            while (current != last && less_than_or_infinite<B>(count) && ContentType::match_char(*current, f)) {
+                ++current;
+                ++count;
+            }
+            if (count < A) return not_matched;
+            return evaluate(begin, current, last, consumed_something(f, backup_current != current), captures,
+                            ctll::list<Tail...>());
+        }
+    }
+
     // Fallback for non-SIMD patterns
     {
         const auto backup_current = current;
@@ -786,6 +811,8 @@ constexpr CTRE_FORCE_INLINE R evaluate(const BeginIterator begin, Iterator curre
 
                 if constexpr (simd::can_use_simd() && (B == 0 || B >= simd::SIMD_REPETITION_THRESHOLD) &&
                               !has_literal_after2 && can_use_pointer_arithmetic2) {
+                    // The kernels give the longest run; when the rest fails after it, the
+                    // backtracking loop below tries the shorter ones
                     // Try multi-range SIMD for patterns like [a-zA-Z], [0-9a-fA-F]
                     const auto remaining_input = last - current;
                     if constexpr (simd::is_multi_range<ContentType>::is_valid) {
@@ -793,7 +820,8 @@ constexpr CTRE_FORCE_INLINE R evaluate(const BeginIterator begin, Iterator curre
                             Iterator multirange_result =
                                 simd::match_multirange_repeat<ContentType, A, B>(current, last, f);
                             if (multirange_result != current) {
-                                return evaluate(begin, multirange_result, last, f, captures, ctll::list<Tail...>());
+                                if (auto r = evaluate(begin, multirange_result, last, f, captures, ctll::list<Tail...>()))
+                                    return r;
                             }
                         }
                     }
@@ -804,7 +832,8 @@ constexpr CTRE_FORCE_INLINE R evaluate(const BeginIterator begin, Iterator curre
                             Iterator shufti_result =
                                 simd::match_pattern_repeat_shufti<ContentType, A, B>(current, last, f);
                             if (shufti_result != current) {
-                                return evaluate(begin, shufti_result, last, f, captures, ctll::list<Tail...>());
+                                if (auto r = evaluate(begin, shufti_result, last, f, captures, ctll::list<Tail...>()))
+                                    return r;
                             }
                         }
                     }
@@ -843,7 +872,8 @@ constexpr CTRE_FORCE_INLINE R evaluate(const BeginIterator begin, Iterator curre
                                 Iterator simd_result =
                                     simd::match_pattern_repeat_simd<ContentType, A, B>(current, last, f);
                                 if (simd_result != current) {
-                                    return evaluate(begin, simd_result, last, f, captures, ctll::list<Tail...>());
+                                    if (auto r = evaluate(begin, simd_result, last, f, captures, ctll::list<Tail...>()))
+                                        return r;
                                 }
                             }
                         }
@@ -856,7 +886,8 @@ constexpr CTRE_FORCE_INLINE R evaluate(const BeginIterator begin, Iterator curre
                             if (remaining >= simd::SIMD_REPETITION_THRESHOLD) {
                                 Iterator simd_result = simd::match_pattern_repeat_simd<ContentType, A, B>(current, last, f);
                                 if (simd_result != current) {
-                                    return evaluate(begin, simd_result, last, f, captures, ctll::list<Tail...>());
+                                    if (auto r = evaluate(begin, simd_result, last, f, captures, ctll::list<Tail...>()))
+                                        return r;
                                 }
                             }
                         }
@@ -867,9 +898,11 @@ constexpr CTRE_FORCE_INLINE R evaluate(const BeginIterator begin, Iterator curre
     }
 
 #ifndef CTRE_DISABLE_GREEDY_OPT
+    // first sets are case-sensitive, so the proof doesn't hold under case folding
     if constexpr (!collides(calculate_first(Content{}...), calculate_first(Tail{}...))) {
-        return evaluate(begin, current, last, f, captures, ctll::list<possessive_repeat<A, B, Content...>, Tail...>());
-    } else
+        if (!is_case_insensitive(f))
+            return evaluate(begin, current, last, f, captures, ctll::list<possessive_repeat<A, B, Content...>, Tail...>());
+    }
 #endif
     {
         // A..B
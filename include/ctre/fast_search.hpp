@@ -3,34 +3,141 @@
 
 #include "wrapper.hpp"
 #include "evaluation.hpp"
+#include "match_length.hpp"
 #ifndef CTRE_DISABLE_SIMD
 #include "decomposition.hpp"
+#include "dfa/compile_dfa.hpp"
 #include "simd/shift_or.hpp"
+#include "multi_literal.hpp"
 #endif
 #include <iterator>
+#include <tuple>
 
 namespace ctre {
 
 #ifndef CTRE_DISABLE_SIMD
+// Prefix atoms whose longest match max_match_length knows. Assertions, lookarounds,
+// backreferences and non-greedy repeats are excluded.
+template <typename T> struct is_plain_prefix : std::false_type {};
+template <auto V> struct is_plain_prefix<character<V>> : std::true_type {};
+template <auto... Str> struct is_plain_prefix<string<Str...>> : std::true_type {};
+template <auto... Cs> struct is_plain_prefix<enumeration<Cs...>> : std::true_type {};
+template <auto A, auto B> struct is_plain_prefix<char_range<A, B>> : std::true_type {};
+template <typename... Content> struct is_plain_prefix<set<Content...>> : std::true_type {};
+template <typename... Content> struct is_plain_prefix<negative_set<Content...>> : std::true_type {};
+template <typename... Content> struct is_plain_prefix<negate<Content...>> : std::true_type {};
+template <> struct is_plain_prefix<any> : std::true_type {};
+template <> struct is_plain_prefix<empty> : std::true_type {};
+template <typename... Content> struct is_plain_prefix<sequence<Content...>> : std::bool_constant<(is_plain_prefix<Content>::value && ...)> {};
+template <typename... Content> struct is_plain_prefix<select<Content...>> : std::bool_constant<(is_plain_prefix<Content>::value && ...)> {};
+template <size_t Index, typename... Content> struct is_plain_prefix<capture<Index, Content...>> : std::bool_constant<(is_plain_prefix<Content>::value && ...)> {};
+template <size_t Index, typename Name, typename... Content> struct is_plain_prefix<capture_with_name<Index, Name, Content...>> : std::bool_constant<(is_plain_prefix<Content>::value && ...)> {};
+template <size_t A, size_t B, typename... Content> struct is_plain_prefix<repeat<A, B, Content...>> : std::bool_constant<(is_plain_prefix<Content>::value && ...)> {};
+
+template <typename T> inline constexpr size_t ascii_string_length = 0;
+template <auto... Str> inline constexpr size_t ascii_string_length<string<Str...>> =
+    ((static_cast<long long>(Str) >= 0 && static_cast<long long>(Str) < 128) && ...) ? sizeof...(Str) : 0;
+
+// Split of a top-level sequence at its longest ASCII string: prefix, literal, rest.
+template <typename RE> struct inner_literal_split {
+    static constexpr bool value = false;
+};
+
+template <typename... Content> struct inner_literal_split<sequence<Content...>> {
+    static constexpr size_t index = [] {
+        constexpr size_t lengths[] = {ascii_string_length<Content>...};
+        size_t best = 0;
+        for (size_t i = 1; i < sizeof...(Content); ++i)
+            if (lengths[i] > lengths[best]) best = i;
+        return best;
+    }();
+
+    using element = std::tuple_element_t<index, std::tuple<Content...>>;
+
+    template <size_t... Is>
+    static auto make_prefix(std::index_sequence<Is...>) -> sequence<std::tuple_element_t<Is, std::tuple<Content...>>...>;
+    using prefix = decltype(make_prefix(std::make_index_sequence<index>{}));
+
+    // Empty when the sequence has no string at all
+    template <typename T> static constexpr auto literal_of(T*) {
+        return literal_result<simd::MAX_SHIFT_OR_PATTERN_LENGTH>{};
+    }
+    template <auto... Str> static constexpr auto literal_of(string<Str...>*) {
+        literal_result<simd::MAX_SHIFT_OR_PATTERN_LENGTH> r;
+        (r.add_char(static_cast<char>(Str)), ...);
+        return r;
+    }
+    static constexpr auto literal = literal_of(static_cast<element*>(nullptr));
+
+    static constexpr bool value = ascii_string_length<element> >= 2 && is_plain_prefix<prefix>::value;
+};
+
+// A prefix that never consumes the literal's first byte cannot run across a hit, so the
+// starts a hit reaches are exactly the prefix matches scanned backwards from it
+template <typename Split>
+[[nodiscard]] consteval bool reverse_prefix_viable() noexcept {
+    using prefix = typename Split::prefix;
+    if constexpr (!dfa::dfa_viable<dfa::reversed_t<prefix>>()) {
+        return false;
+    } else {
+        const auto nfa = dfa::make_position_nfa<dfa::normalize_t<prefix>>();
+        for (size_t p = 1; p < nfa.count; ++p)
+            if (nfa.bytes[p].test(static_cast<unsigned char>(Split::literal.chars[0]))) return false;
+        return true;
+    }
+}
+
+template <typename Prefix> inline constexpr auto reverse_prefix_dfa = dfa::make_dfa_table<dfa::reversed_t<Prefix>, false>();
+
+// The shift-or state keeps one mask row per position plus one; overlapping classes
+// can split the bytes into more partitions, and such sequences take the generic path
+template <typename Segments>
+[[nodiscard]] consteval bool segment_shift_or_viable() noexcept {
+    if constexpr (!Segments::value || Segments::length > simd::MAX_WIDE_SHIFT_OR_PATTERN_LENGTH) {
+        return false;
+    } else {
+        using state = simd::shift_or_state_for<Segments::length>;
+        using row = std::remove_cvref_t<decltype(state{}.char_masks.rows[0])>;
+        constexpr size_t capacity = std::tuple_size_v<decltype(state{}.char_masks.rows)>;
+        const auto masks = simd::position_set_masks<row, Segments::length>(Segments::position_sets());
+        return partition_bytes(masks).count <= capacity;
+    }
+}
+
+// Shift-or masks of a fixed segment sequence (see sequence_fusion.hpp)
+template <typename Segments>
+inline constexpr auto segment_shift_or = [] {
+    simd::shift_or_state_for<Segments::length> state;
+    state.init_position_sets(Segments::position_sets());
+    return state;
+}();
+
 struct fast_search_method {
-    template <auto Literal, size_t... Is>
+    template <auto Literal, bool Caseless, size_t... Is>
     [[nodiscard]] static constexpr auto make_simd_finder(std::index_sequence<Is...>) noexcept {
         return []<typename Iterator, typename EndIterator>(Iterator& it, EndIterator end) -> bool {
-            return simd::match_string_shift_or<Literal.chars[Is]...>(it, end, flags{});
+            constexpr flags f = Caseless ? flags{case_insensitive{}} : flags{};
+            return simd::match_string_shift_or<Literal.chars[Is]...>(it, end, f);
         };
     }
 
-    template <typename Iterator, typename EndIterator, size_t LitLength>
+    template <bool Caseless, typename Iterator, typename EndIterator, size_t LitLength>
     [[nodiscard]] static constexpr bool find_literal_naive(Iterator& it, EndIterator end,
                                                             const char (&literal)[LitLength]) noexcept {
         if (it == end) return false;
+        using char_type = std::iter_value_t<Iterator>;
         const size_t len = LitLength - 1;
 
         for (auto search_it = it; search_it != end; ++search_it) {
             bool match = true;
             auto check_it = search_it;
             for (size_t i = 0; i < len && check_it != end; ++i, ++check_it) {
-                if (*check_it != literal[i]) { match = false; break; }
+                const auto fold = static_cast<char_type>(Caseless ? simd::case_fold_bit(literal[i]) : 0);
+                const auto want = static_cast<char_type>(literal[i]);
+                if (static_cast<char_type>(*check_it | fold) != static_cast<char_type>(want | fold)) {
+                    match = false;
+                    break;
+                }
             }
             if (match && std::distance(search_it, check_it) == static_cast<std::ptrdiff_t>(len)) {
                 it = search_it;
@@ -40,52 +147,57 @@ struct fast_search_method {
         return false;
     }
 
+    // Moves it to the start of the next occurrence of Literal; byte pointers use shift-or
+    template <auto Literal, bool Caseless, typename Iterator, typename EndIterator>
+    [[nodiscard]] static constexpr bool find_literal(Iterator& it, EndIterator end) noexcept {
+        if constexpr (std::is_pointer_v<Iterator> && std::is_same_v<Iterator, EndIterator> &&
+                      sizeof(std::iter_value_t<Iterator>) == 1) {
+            if (!std::is_constant_evaluated()) {
+                constexpr auto simd_finder =
+                    make_simd_finder<Literal, Caseless>(std::make_index_sequence<Literal.length>{});
+                if (!simd_finder(it, end)) return false;
+                it = it - Literal.length;
+                return true;
+            }
+        }
+        char lit_array[Literal.length + 1];
+        for (size_t i = 0; i < Literal.length; ++i) lit_array[i] = Literal.chars[i];
+        lit_array[Literal.length] = '\0';
+        return find_literal_naive<Caseless>(it, end, lit_array);
+    }
+
     template <typename Modifier = singleline, typename ResultIterator = void, typename RE,
               typename IteratorBegin, typename IteratorEnd>
     [[nodiscard]] static constexpr CTRE_FORCE_INLINE auto exec(IteratorBegin orig_begin, IteratorBegin begin,
                                                                 IteratorEnd end, RE) noexcept {
         using result_iterator = std::conditional_t<std::is_same_v<ResultIterator, void>, IteratorBegin, ResultIterator>;
-        constexpr bool has_literal = decomposition::has_prefilter_literal<RE>;
+        // Literal prefilters need a range with no sentinel, the shift-or segment scan a pointer range
+        constexpr bool plain_range = std::is_same_v<IteratorBegin, IteratorEnd>;
+        constexpr bool pointer_range = plain_range && std::is_pointer_v<IteratorBegin>;
+        using split = inner_literal_split<RE>;
+        using segments = simd::fixed_segment_sequence<RE>;
 
-        if constexpr (has_literal) {
+        if constexpr (pointer_range && segment_shift_or_viable<segments>() && !is_case_insensitive(flags{Modifier{}})) {
+            if (!std::is_constant_evaluated()) {
+                return exec_segments<Modifier, result_iterator, segments>(orig_begin, begin, end, RE{});
+            }
+        } else if constexpr (plain_range && split::value) {
+            // A match reaches back from the literal at most as far as the prefix can match
+            return exec_prefiltered<Modifier, result_iterator, split::literal,
+                                    decomposition::prefilter_ignores_case<RE, Modifier>,
+                                    max_match_length_v<typename split::prefix>, split>(orig_begin, begin, end, RE{});
+        } else if constexpr (plain_range && decomposition::has_prefilter_literal<RE>) {
             constexpr auto literal = decomposition::prefilter_literal<RE>;
-
-            if constexpr (literal.length >= 2) {
-                auto it = begin;
-                constexpr auto simd_finder = make_simd_finder<literal>(std::make_index_sequence<literal.length>{});
-
-                while (it != end) {
-                    bool found;
-                    if (std::is_constant_evaluated()) {
-                        char lit_array[literal.length + 1];
-                        for (size_t i = 0; i < literal.length; ++i) lit_array[i] = literal.chars[i];
-                        lit_array[literal.length] = '\0';
-                        found = find_literal_naive(it, end, lit_array);
-                    } else {
-                        found = simd_finder(it, end);
-                        if (found && literal.length > 0) it = it - literal.length;
-                    }
-
-                    if (!found) break;
-
-                    constexpr size_t max_lookback = 64;
-                    auto search_start = (it > begin + max_lookback) ? (it - max_lookback) : begin;
-
-                    for (auto try_pos = it; try_pos >= search_start; --try_pos) {
-                        if (auto out = evaluate(orig_begin, try_pos, end, Modifier{},
-                                                return_type<result_iterator, RE>{},
-                                                ctll::list<start_mark, RE, end_mark, accept>())) {
-                            return out;
-                        }
-                        if (try_pos == search_start) break;
-                    }
-                    ++it;
-                }
-
-                auto out = evaluate(orig_begin, end, end, Modifier{}, return_type<result_iterator, RE>{},
-                                    ctll::list<start_mark, RE, end_mark, accept>());
-                out.set_end_mark(end);
-                return out;
+            // Wider code units are compared with the literal's chars, which only holds for ASCII
+            constexpr bool comparable = sizeof(std::iter_value_t<IteratorBegin>) == 1 || [] {
+                for (size_t i = 0; i < decomposition::prefilter_literal<RE>.length; ++i)
+                    if (static_cast<unsigned char>(decomposition::prefilter_literal<RE>.chars[i]) >= 0x80) return false;
+                return true;
+            }();
+            if constexpr (literal.length >= 2 && comparable) {
+                return exec_prefiltered<Modifier, result_iterator, literal,
+                                        decomposition::prefilter_ignores_case<RE, Modifier>,
+                                        max_match_length_v<RE>, void>(orig_begin, begin, end, RE{});
             }
         }
 
@@ -105,6 +217,76 @@ struct fast_search_method {
         return out;
     }
 
+    // A fixed segment sequence matches exactly length bytes: one shift-or scan stops at
+    // the end of its leftmost occurrence, evaluate then fills the result from its start
+    template <typename Modifier, typename ResultIterator, typename Segments, typename RE, typename Iterator>
+    [[nodiscard]] static auto exec_segments(Iterator orig_begin, Iterator begin, Iterator end, RE) noexcept {
+        constexpr size_t length = Segments::length;
+        auto it = begin;
+        while (simd::match_shift_or(it, end, segment_shift_or<Segments>)) {
+            const auto start = it - length;
+            if (auto out = evaluate(orig_begin, start, end, Modifier{}, return_type<ResultIterator, RE>{},
+                                    ctll::list<start_mark, RE, end_mark, accept>())) {
+                return out;
+            }
+            it = start + 1;
+        }
+
+        auto out = evaluate(orig_begin, end, end, Modifier{}, return_type<ResultIterator, RE>{},
+                            ctll::list<start_mark, RE, end_mark, accept>());
+        out.set_end_mark(end);
+        return out;
+    }
+
+    // Every match contains Literal, starting at most Reach positions after the match
+    // does, so each hit bounds the starts worth evaluating. Starts are tried once each in
+    // increasing order: the first match found is the leftmost, and ends the scan there.
+    // A later hit can reach back past an earlier one, so without Split's reversed prefix
+    // every start between hits is tried; with it the starts begin where the prefix's
+    // longest match ending at the hit does.
+    template <typename Modifier, typename ResultIterator, auto Literal, bool Caseless, size_t Reach, typename Split,
+              typename RE, typename Iterator>
+    [[nodiscard]] static constexpr auto exec_prefiltered(Iterator orig_begin, Iterator begin, Iterator end, RE) noexcept {
+        constexpr bool dfa_range = std::is_same_v<Iterator, const char*> && !Caseless && !multiline_mode(flags{Modifier{}});
+        // The anchored DFA rules out most starts for a fraction of an evaluate call
+        constexpr bool dfa_filter = dfa_range && dfa::dfa_viable<RE>();
+        constexpr bool reverse_prefix = [] {
+            if constexpr (dfa_range && !std::is_void_v<Split>) return reverse_prefix_viable<Split>();
+            else return false;
+        }();
+
+        const auto may_start = [end](Iterator start) {
+            if constexpr (dfa_filter) return dfa::match_starts_at(dfa::forward_dfa<RE>, start, end);
+            else return true;
+        };
+
+        auto it = begin;
+        auto tried_until = begin; // every start below this was tried
+        while (find_literal<Literal, Caseless>(it, end)) {
+            auto start = tried_until;
+            if constexpr (reverse_prefix) {
+                start = dfa::longest_to(reverse_prefix_dfa<typename Split::prefix>, tried_until, it);
+                if (start == nullptr) start = it + 1;
+            } else if constexpr (Reach != unbounded_match_length && std::random_access_iterator<Iterator>) {
+                if (static_cast<size_t>(it - tried_until) > Reach) start = it - Reach;
+            }
+            for (const auto past_hit = std::next(it); start != past_hit; ++start) {
+                if (may_start(start)) {
+                    if (auto out = evaluate(orig_begin, start, end, Modifier{}, return_type<ResultIterator, RE>{},
+                                            ctll::list<start_mark, RE, end_mark, accept>())) {
+                        return out;
+                    }
+                }
+            }
+            tried_until = ++it;
+        }
+
+        auto out = evaluate(orig_begin, end, end, Modifier{}, return_type<ResultIterator, RE>{},
+                            ctll::list<start_mark, RE, end_mark, accept>());
+        out.set_end_mark(end);
+        return out;
+    }
+
     template <typename Modifier = singleline, typename ResultIterator = void, typename RE,
               typename IteratorBegin, typename IteratorEnd>
     [[nodiscard]] static constexpr CTRE_FORCE_INLINE auto exec(IteratorBegin begin, IteratorEnd end, RE) noexcept {
@@ -51,6 +51,17 @@ constexpr auto first(ctll::list<Content...> l, ctll::list<boundary<CharLike>, Ta
 	return first(l, ctll::list<Tail...>{});
 }
 
+template <typename... Content, typename CharLike, typename... Tail> 
+constexpr auto first(ctll::list<Content...> l, ctll::list<not_boundary<CharLike>, Tail...>) noexcept {
+	return first(l, ctll::list<Tail...>{});
+}
+
+// mode switch (e.g. case insensitivity) changes what the characters after it match
+template <typename... Content, typename Mode, typename... Tail> 
+constexpr auto first(ctll::list<Content...>, ctll::list<mode_switch<Mode>, Tail...>) noexcept {
+	return ctll::list<can_be_anything>{};
+}
+
 // asserts
 template <typename... Content, typename... Tail> 
 constexpr auto first(ctll::list<Content...> l, ctll::list<assert_subject_begin, Tail...>) noexcept {
@@ -194,6 +205,18 @@ constexpr auto first(ctll::list<Content...>, ctll::list<lookahead_negative<Seq..
 	return ctll::list<can_be_anything>{};
 }
 
+// memoization point
+template <typename... Content, size_t Id, typename Node, typename... Tail> 
+constexpr auto first(ctll::list<Content...> l, ctll::list<memo_point<Id, Node>, Tail...>) noexcept {
+	return first(l, ctll::list<Node, Tail...>{});
+}
+
+// step counter
+template <typename... Content, typename... Tail> 
+constexpr auto first(ctll::list<Content...> l, ctll::list<step_tick, Tail...>) noexcept {
+	return first(l, ctll::list<Tail...>{});
+}
+
 // capture
 template <typename... Content, size_t Id, typename... Seq, typename... Tail> 
 constexpr auto first(ctll::list<Content...> l, ctll::list<capture<Id, Seq...>, Tail...>) noexcept {
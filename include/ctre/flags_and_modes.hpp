@@ -12,12 +12,26 @@ struct case_insensitive { };
 using ci = case_insensitive;
 using cs = case_sensitive;
 
+// opt-in memoized backtracking (see memoization.hpp)
+struct memoized { };
+
+// opt-in offset-based capture storage (see compact_regex_results in return_type.hpp)
+struct compact_captures { };
+
+// opt-in POSIX leftmost-longest matching (see longest.hpp)
+struct longest { };
+
+struct memo_arena;
+struct match_limits;
+
 template <typename... Flags> struct flag_list { };
 
 struct flags {
 	bool block_empty_match = false;
 	bool multiline = false;
 	bool case_insensitive = false;
+	memo_arena * memo = nullptr;
+	match_limits * limits = nullptr;
 	
 	constexpr flags() = default;
 	constexpr flags(const flags &) = default;
@@ -27,6 +41,9 @@ struct flags {
 	constexpr CTRE_FORCE_INLINE flags(ctre::multiline v) noexcept { set_flag(v); }
 	constexpr CTRE_FORCE_INLINE flags(ctre::case_sensitive v) noexcept { set_flag(v); }
 	constexpr CTRE_FORCE_INLINE flags(ctre::case_insensitive v) noexcept { set_flag(v); }
+	constexpr CTRE_FORCE_INLINE flags(ctre::memoized v) noexcept { set_flag(v); }
+	constexpr CTRE_FORCE_INLINE flags(ctre::compact_captures v) noexcept { set_flag(v); }
+	constexpr CTRE_FORCE_INLINE flags(ctre::longest v) noexcept { set_flag(v); }
 	
 	
 	template <typename... Args> constexpr CTRE_FORCE_INLINE flags(ctll::list<Args...>) noexcept {
@@ -68,6 +85,15 @@ struct flags {
 	constexpr CTRE_FORCE_INLINE void set_flag(ctre::case_sensitive) noexcept {
 		case_insensitive = false;
 	}
+	
+	// the arena itself is attached by the match methods
+	constexpr CTRE_FORCE_INLINE void set_flag(ctre::memoized) noexcept { }
+	
+	// only changes the result type the match methods return
+	constexpr CTRE_FORCE_INLINE void set_flag(ctre::compact_captures) noexcept { }
+	
+	// routes search and starts_with to the DFA, evaluate keeps its semantics
+	constexpr CTRE_FORCE_INLINE void set_flag(ctre::longest) noexcept { }
 };
 
 constexpr CTRE_FORCE_INLINE auto not_empty_match(flags f) {
@@ -9,6 +9,7 @@
 #include "ctll.hpp"
 #include <array>
 #include <cstddef>
+#include <cstdint>
 #include <utility>
 
 namespace ctre::glushkov {
@@ -289,8 +290,8 @@ constexpr auto last_sequence_reverse(size_t offset) {
     else {
         size_t head_size = count_positions<Head>();
         auto [tail_last, tail_count] = last_sequence_reverse<Tail...>(offset + head_size);
-        using LastType = typename std::tuple_element<sizeof...(Tail) - 1, std::tuple<Tail...>>::type;
-        if constexpr (nullable<LastType>()) {
+        // Head can end the sequence only if everything after it may be empty
+        if constexpr (all_nullable<Tail...>()) {
             auto [head_last, head_count] = last_positions<Head>(offset);
             return merge_position_sets(tail_last, tail_count, head_last, head_count);
         } else {
@@ -333,10 +334,11 @@ struct follow_map {
     }
 };
 
-template <typename Pattern, size_t MaxPositions> constexpr void build_follow(follow_map<MaxPositions>& fmap, size_t offset);
-template <typename... Content, size_t MaxPositions> constexpr void build_follow_sequence(follow_map<MaxPositions>& fmap, size_t offset);
-template <typename... Options, size_t MaxPositions> constexpr void build_follow_select(follow_map<MaxPositions>& fmap, size_t offset);
-template <size_t A, size_t B, typename... Content, size_t MaxPositions> constexpr void build_follow_repeat(follow_map<MaxPositions>& fmap, size_t offset);
+template <typename Pattern, typename Map> constexpr void build_follow(Map& fmap, size_t offset);
+template <typename... Content, typename Map> constexpr void build_follow_sequence(Map& fmap, size_t offset);
+template <typename... Options, typename Map> constexpr void build_follow_select(Map& fmap, size_t offset);
+template <size_t A, size_t B, typename... Content, typename Map>
+constexpr void build_follow_repeat(Map& fmap, size_t offset);
 
 template <typename Pattern, size_t MaxPositions = 512>
 constexpr follow_map<MaxPositions> compute_follow() {
@@ -345,40 +347,63 @@ constexpr follow_map<MaxPositions> compute_follow() {
     return fmap;
 }
 
-template <typename Pattern, size_t MaxPositions>
-constexpr void build_follow(follow_map<MaxPositions>& fmap, size_t offset) {
+// Follow() as one bit row per position. follow_map keeps at most 32 successors, while
+// in (?:a|b|...)+ every alternative is followed by all of them
+template <size_t MaxPositions>
+struct follow_sets {
+    static constexpr size_t WORDS = (MaxPositions + 63) / 64;
+    std::array<std::array<uint64_t, WORDS>, MaxPositions> rows{};
+
+    constexpr void add_edge(size_t from, size_t to) {
+        if (from < MaxPositions && to < MaxPositions) rows[from][to / 64] |= uint64_t{1} << (to % 64);
+    }
+
+    constexpr void add_edges(size_t from, const auto& to_positions, size_t to_count) {
+        for (size_t i = 0; i < to_count; ++i) add_edge(from, to_positions[i]);
+    }
+};
+
+template <typename Pattern, size_t MaxPositions = count_positions<Pattern>() + 1>
+constexpr follow_sets<MaxPositions> compute_follow_sets() {
+    follow_sets<MaxPositions> sets{};
+    build_follow<Pattern>(sets, 0);
+    return sets;
+}
+
+template <typename Pattern, typename Map>
+constexpr void build_follow(Map& fmap, size_t offset) {
     if constexpr (is_empty<Pattern>::value || is_character<Pattern>::value || is_any<Pattern>::value) { }
     else if constexpr (is_string<Pattern>::value) {
         constexpr size_t len = is_string<Pattern>::length;
         for (size_t i = 1; i < len; ++i) fmap.add_edge(offset + i, offset + i + 1);
     }
     else if constexpr (is_sequence<Pattern>::value) {
-        []<typename... Content>(sequence<Content...>*, follow_map<MaxPositions>& fm, size_t off) {
+        []<typename... Content>(sequence<Content...>*, Map& fm, size_t off) {
             build_follow_sequence<Content...>(fm, off);
         }(static_cast<Pattern*>(nullptr), fmap, offset);
     }
     else if constexpr (is_select<Pattern>::value) {
-        []<typename... Options>(select<Options...>*, follow_map<MaxPositions>& fm, size_t off) {
+        []<typename... Options>(select<Options...>*, Map& fm, size_t off) {
             build_follow_select<Options...>(fm, off);
         }(static_cast<Pattern*>(nullptr), fmap, offset);
     }
     else if constexpr (is_capture<Pattern>::value) {
-        []<size_t Index, typename... Content>(capture<Index, Content...>*, follow_map<MaxPositions>& fm, size_t off) {
+        []<size_t Index, typename... Content>(capture<Index, Content...>*, Map& fm, size_t off) {
             if constexpr (sizeof...(Content) == 1) (build_follow<Content>(fm, off), ...);
             else build_follow_sequence<Content...>(fm, off);
         }(static_cast<Pattern*>(nullptr), fmap, offset);
     }
     else if constexpr (is_any_repeat_v<Pattern>) {
         if constexpr (is_repeat<Pattern>::value) {
-            []<size_t A, size_t B, typename... Content>(repeat<A, B, Content...>*, follow_map<MaxPositions>& fm, size_t off) {
+            []<size_t A, size_t B, typename... Content>(repeat<A, B, Content...>*, Map& fm, size_t off) {
                 build_follow_repeat<A, B, Content...>(fm, off);
             }(static_cast<Pattern*>(nullptr), fmap, offset);
         } else if constexpr (is_lazy_repeat<Pattern>::value) {
-            []<size_t A, size_t B, typename... Content>(lazy_repeat<A, B, Content...>*, follow_map<MaxPositions>& fm, size_t off) {
+            []<size_t A, size_t B, typename... Content>(lazy_repeat<A, B, Content...>*, Map& fm, size_t off) {
                 build_follow_repeat<A, B, Content...>(fm, off);
             }(static_cast<Pattern*>(nullptr), fmap, offset);
         } else if constexpr (is_possessive_repeat<Pattern>::value) {
-            []<size_t A, size_t B, typename... Content>(possessive_repeat<A, B, Content...>*, follow_map<MaxPositions>& fm, size_t off) {
+            []<size_t A, size_t B, typename... Content>(possessive_repeat<A, B, Content...>*, Map& fm, size_t off) {
                 build_follow_repeat<A, B, Content...>(fm, off);
             }(static_cast<Pattern*>(nullptr), fmap, offset);
         }
@@ -386,14 +411,14 @@ constexpr void build_follow(follow_map<MaxPositions>& fmap, size_t offset) {
     else if constexpr (CharacterLike<Pattern>) { }
 }
 
-template <typename... Content, size_t MaxPositions>
-constexpr void build_follow_sequence(follow_map<MaxPositions>& fmap, size_t offset) {
+template <typename... Content, typename Map>
+constexpr void build_follow_sequence(Map& fmap, size_t offset) {
     if constexpr (sizeof...(Content) == 0) return;
     else if constexpr (sizeof...(Content) == 1) {
-        []<typename T>(follow_map<MaxPositions>& fm, size_t off) { build_follow<T>(fm, off); }
+        []<typename T>(Map& fm, size_t off) { build_follow<T>(fm, off); }
             .template operator()<Content...>(fmap, offset);
     } else {
-        []<typename Head, typename... Tail>(follow_map<MaxPositions>& fm, size_t off) {
+        []<typename Head, typename... Tail>(Map& fm, size_t off) {
             build_follow<Head>(fm, off);
             auto [head_last, head_last_count] = last_positions<Head>(off);
             size_t tail_offset = off + count_positions<Head>();
@@ -405,11 +430,11 @@ constexpr void build_follow_sequence(follow_map<MaxPositions>& fmap, size_t offs
     }
 }
 
-template <typename... Options, size_t MaxPositions>
-constexpr void build_follow_select(follow_map<MaxPositions>& fmap, size_t offset) {
+template <typename... Options, typename Map>
+constexpr void build_follow_select(Map& fmap, size_t offset) {
     if constexpr (sizeof...(Options) == 0) return;
     else {
-        []<typename Head, typename... Tail>(follow_map<MaxPositions>& fm, size_t off) {
+        []<typename Head, typename... Tail>(Map& fm, size_t off) {
             build_follow<Head>(fm, off);
             if constexpr (sizeof...(Tail) > 0) {
                 size_t next_offset = off + count_positions<Head>();
@@ -419,11 +444,11 @@ constexpr void build_follow_select(follow_map<MaxPositions>& fmap, size_t offset
     }
 }
 
-template <size_t A, size_t B, typename... Content, size_t MaxPositions>
-constexpr void build_follow_repeat(follow_map<MaxPositions>& fmap, size_t offset) {
+template <size_t A, size_t B, typename... Content, typename Map>
+constexpr void build_follow_repeat(Map& fmap, size_t offset) {
     if constexpr (sizeof...(Content) == 0) return;
     else if constexpr (sizeof...(Content) == 1) {
-        []<typename T>(follow_map<MaxPositions>& fm, size_t off) {
+        []<typename T>(Map& fm, size_t off) {
             build_follow<T>(fm, off);
             if constexpr (B != 1) { // Add loop back (not for '?' quantifier)
                 auto [content_first, first_count] = first_positions<T>(off);
@@ -433,7 +458,7 @@ constexpr void build_follow_repeat(follow_map<MaxPositions>& fmap, size_t offset
             }
         }.template operator()<Content...>(fmap, offset);
     } else {
-        []<typename... All>(follow_map<MaxPositions>& fm, size_t off) {
+        []<typename... All>(Map& fm, size_t off) {
             build_follow_sequence<All...>(fm, off);
             if constexpr (B != 1) {
                 auto [content_first, first_count] = first_pack<All...>(off);
@@ -516,7 +541,8 @@ struct glushkov_nfa {
     std::array<State, MAX_POSITIONS> states{};
     size_t state_count = 0;
     size_t start_state = 0;
-    std::array<size_t, MAX_SUCCESSORS> accept_states{};
+    // Sized by positions: wide alternations can end on many positions
+    std::array<size_t, MAX_POSITIONS> accept_states{};
     size_t accept_count = 0;
 
     constexpr glushkov_nfa() {
@@ -554,7 +580,7 @@ struct glushkov_nfa {
         for (size_t i = 0; i < last_count; ++i) accept_states[i] = last_set[i];
 
         if constexpr (nullable<Pattern>()) {
-            if (accept_count < MAX_SUCCESSORS) accept_states[accept_count++] = 0;
+            if (accept_count < MAX_POSITIONS) accept_states[accept_count++] = 0;
         }
     }
 };
@@ -1,8 +1,12 @@
 #ifndef CTRE__GLUSHKOV_STUBS__HPP
 #define CTRE__GLUSHKOV_STUBS__HPP
 
+#include "pattern_traits.hpp"
+
+// The real trait, so that glushkov_nfa.hpp (pulled in by the DFA headers) still sees
+// selects; the BitNFA paths are already off through fits_bitnfa_v
 namespace ctre::glushkov {
-template <typename T> inline constexpr bool is_select_v = false;
+using traits::is_select_v;
 }
 
 #endif
@@ -0,0 +1,113 @@
+#ifndef CTRE__LEXER__HPP
+#define CTRE__LEXER__HPP
+
+#include "dfa/compile_dfa.hpp"
+#include "wrapper.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+
+// Maximal-munch lexer over several token patterns. All tokens go into one anchored
+// DFA (their alternation); a DFA state carries the first token with an accepting
+// position in it. Each step runs the DFA from the current position to the dead
+// state and takes the longest accepted prefix, the earliest listed token winning
+// ties. Tokens are DFA patterns: no assertions, lookarounds, backreferences, lazy
+// or possessive repeats, and together within the DFA position and state caps.
+
+namespace ctre {
+
+struct lexeme {
+    size_t token;
+    std::string_view span;
+};
+
+namespace lexer_detail {
+
+template <typename... Tokens> using combined_t = select<Tokens...>;
+
+template <typename Token> constexpr void add_accepts(dfa::position_set& accepts, size_t offset) noexcept {
+    const auto last = glushkov::last_positions<Token>(offset);
+    for (size_t i = 0; i < last.second; ++i) dfa::insert(accepts, last.first[i]);
+}
+
+// Token accepted in every DFA state, or sizeof...(Tokens); position 0 is left
+// out, an empty lexeme would never advance
+template <typename... Tokens> constexpr auto token_of_states() noexcept {
+    constexpr auto& built = dfa::dfa_builder_v<combined_t<Tokens...>, false>;
+    constexpr size_t count = sizeof...(Tokens);
+
+    std::array<dfa::position_set, count> accepts{};
+    size_t offset = 0;
+    size_t k = 0;
+    ((add_accepts<dfa::normalize_t<Tokens>>(accepts[k++], offset), offset += glushkov::count_positions<dfa::normalize_t<Tokens>>()), ...);
+
+    std::array<uint16_t, built.state_count> token{};
+    for (size_t s = 0; s < built.state_count; ++s) {
+        token[s] = static_cast<uint16_t>(count);
+        for (size_t t = 0; t < count && token[s] == count; ++t) {
+            for (size_t w = 0; w < accepts[t].size(); ++w) {
+                if (built.sets[s][w] & accepts[t][w]) token[s] = static_cast<uint16_t>(t);
+            }
+        }
+    }
+    return token;
+}
+
+template <typename... Tokens> inline constexpr auto table = dfa::forward_dfa<combined_t<Tokens...>>;
+template <typename... Tokens> inline constexpr auto token_of = token_of_states<Tokens...>();
+
+// Longest token at the start of [begin, end)
+template <typename... Tokens> constexpr lexeme next(const char* begin, const char* end) noexcept {
+    constexpr auto& dfa = table<Tokens...>;
+    constexpr auto& token = token_of<Tokens...>;
+    using table_type = std::remove_cvref_t<decltype(dfa)>;
+
+    lexeme best{sizeof...(Tokens), std::string_view{begin, 0}};
+    uint16_t state = table_type::start_state;
+    for (const char* p = begin; p != end; ++p) {
+        state = dfa.step(state, *p);
+        if (state == table_type::dead_state) break;
+        if (token[state] != sizeof...(Tokens)) best = lexeme{token[state], std::string_view{begin, static_cast<size_t>(p + 1 - begin)}};
+    }
+    return best;
+}
+
+} // namespace lexer_detail
+
+// ctre::lexer<"[a-z]+", "[0-9]+", "\\s+", ...>: token ids are the pattern indices
+CTRE_EXPORT template <CTRE_REGEX_INPUT_TYPE... tokens> struct lexer {
+    static_assert(sizeof...(tokens) > 0, "A lexer needs at least one token");
+    static_assert(dfa::dfa_viable_v<lexer_detail::combined_t<typename regex_builder<tokens>::type...>>,
+                  "Tokens have no DFA: they use assertions, lookarounds, backreferences, "
+                  "lazy/possessive repeats or exceed the state cap");
+
+    // Token id of a failed lexeme
+    static constexpr size_t no_token = sizeof...(tokens);
+
+    static constexpr size_t size() noexcept {
+        return sizeof...(tokens);
+    }
+
+    // Longest token at the start of input, or no_token with an empty span
+    static constexpr lexeme next(std::string_view input) noexcept {
+        return lexer_detail::next<typename regex_builder<tokens>::type...>(input.data(), input.data() + input.size());
+    }
+
+    // Calls f(lexeme) for every token from the start of input on; returns the rest
+    // of input from where no token matches, empty once all of it is lexed
+    template <typename F> static constexpr std::string_view tokenize(std::string_view input, F&& f) {
+        while (!input.empty()) {
+            const lexeme l = next(input);
+            if (l.token == no_token) break;
+            f(l);
+            input.remove_prefix(l.span.size());
+        }
+        return input;
+    }
+};
+
+} // namespace ctre
+
+#endif // CTRE__LEXER__HPP
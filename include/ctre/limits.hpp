@@ -0,0 +1,158 @@
+#ifndef CTRE__LIMITS__HPP
+#define CTRE__LIMITS__HPP
+
+#include "evaluation.hpp"
+#include "return_type.hpp"
+#include "rotate.hpp"
+#include "starts_with_anchor.hpp"
+#include "wrapper.hpp"
+#ifndef CTRE_IN_A_MODULE
+#include <chrono>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#endif
+
+// Work-limited matching. The pattern is rewritten with a step_tick at the head of
+// every alternative and every repeat iteration, and search adds one per start
+// position; each tick counts a step against a match_limits reached through the
+// flags. Once the step budget or the deadline runs out every tick fails, so the
+// backtracking unwinds at once and the caller gets limit_exceeded rather than a
+// mismatch. Only the plain evaluator runs here: prefilters and DFA shortcuts skip
+// the ticks and would make the budget meaningless.
+
+namespace ctre {
+
+struct match_limits {
+    using clock = std::chrono::steady_clock;
+
+    // The clock is only read every this many steps
+    static constexpr size_t deadline_interval = 1024;
+
+    size_t max_steps = std::numeric_limits<size_t>::max();
+    clock::time_point deadline = clock::time_point::max();
+    size_t steps = 0;
+    bool exceeded = false;
+
+    match_limits() = default;
+    explicit match_limits(size_t max_steps_) noexcept: max_steps(max_steps_) { }
+    explicit match_limits(clock::time_point deadline_) noexcept: deadline(deadline_) { }
+    match_limits(size_t max_steps_, clock::time_point deadline_) noexcept: max_steps(max_steps_), deadline(deadline_) { }
+
+    // false once the budget is spent
+    bool step() noexcept {
+        if (exceeded) return false;
+        if (++steps > max_steps) {
+            exceeded = true;
+        } else if (steps % deadline_interval == 0 && deadline != clock::time_point::max() && clock::now() >= deadline) {
+            exceeded = true;
+        }
+        return !exceeded;
+    }
+};
+
+enum class match_status { matched, not_matched, limit_exceeded };
+
+template <typename Result> struct limited_result {
+    Result result;
+    match_status status;
+
+    constexpr explicit operator bool() const noexcept { return status == match_status::matched; }
+    [[nodiscard]] constexpr bool limit_exceeded() const noexcept { return status == match_status::limit_exceeded; }
+};
+
+template <typename R, typename BeginIterator, typename Iterator, typename EndIterator, typename... Tail>
+constexpr CTRE_FORCE_INLINE R evaluate(const BeginIterator begin, Iterator current, const EndIterator last,
+                                       const flags& f, R captures, ctll::list<step_tick, Tail...>) noexcept {
+    if (f.limits != nullptr && !f.limits->step()) return not_matched;
+    return evaluate(begin, current, last, f, captures, ctll::list<Tail...>());
+}
+
+// Puts a step_tick before every alternative and into every repeat body
+template <typename T> struct limit_rewrite { using type = T; };
+template <typename T> using limited_t = typename limit_rewrite<T>::type;
+
+template <typename... Content> struct limit_rewrite<sequence<Content...>> { using type = sequence<limited_t<Content>...>; };
+template <typename... Content> struct limit_rewrite<atomic_group<Content...>> { using type = atomic_group<limited_t<Content>...>; };
+template <typename... Options> struct limit_rewrite<select<Options...>> { using type = select<sequence<step_tick, limited_t<Options>>...>; };
+template <size_t Index, typename... Content> struct limit_rewrite<capture<Index, Content...>> { using type = capture<Index, limited_t<Content>...>; };
+template <size_t Index, typename Name, typename... Content> struct limit_rewrite<capture_with_name<Index, Name, Content...>> { using type = capture_with_name<Index, Name, limited_t<Content>...>; };
+template <size_t A, size_t B, typename... Content> struct limit_rewrite<repeat<A, B, Content...>> { using type = repeat<A, B, step_tick, limited_t<Content>...>; };
+template <size_t A, size_t B, typename... Content> struct limit_rewrite<lazy_repeat<A, B, Content...>> { using type = lazy_repeat<A, B, step_tick, limited_t<Content>...>; };
+template <size_t A, size_t B, typename... Content> struct limit_rewrite<possessive_repeat<A, B, Content...>> { using type = possessive_repeat<A, B, step_tick, limited_t<Content>...>; };
+template <typename... Content> struct limit_rewrite<lookahead_positive<Content...>> { using type = lookahead_positive<limited_t<Content>...>; };
+template <typename... Content> struct limit_rewrite<lookahead_negative<Content...>> { using type = lookahead_negative<limited_t<Content>...>; };
+template <typename... Content> struct limit_rewrite<lookbehind_positive<Content...>> { using type = lookbehind_positive<limited_t<Content>...>; };
+template <typename... Content> struct limit_rewrite<lookbehind_negative<Content...>> { using type = lookbehind_negative<limited_t<Content>...>; };
+
+// A spent budget wins over the result: failing ticks inside a negative lookahead
+// make it succeed, so a match found after that point may not exist at all
+template <typename Result>
+[[nodiscard]] constexpr auto make_limited_result(Result result, const match_limits& limits) noexcept {
+    const match_status status = limits.exceeded ? match_status::limit_exceeded
+                                : result        ? match_status::matched
+                                                : match_status::not_matched;
+    return limited_result<Result>{result, status};
+}
+
+template <typename RE, typename Modifier, typename Iterator>
+auto limited_match_exec(match_limits& limits, Iterator begin, Iterator end) noexcept {
+    flags f{Modifier{}};
+    f.limits = &limits;
+    auto out = evaluate(begin, begin, end, f, return_type<Iterator, RE>{},
+                        ctll::list<start_mark, limited_t<RE>, assert_subject_end, end_mark, accept>());
+    return make_limited_result(out, limits);
+}
+
+template <typename RE, typename Modifier, typename Iterator>
+auto limited_starts_with_exec(match_limits& limits, Iterator begin, Iterator end) noexcept {
+    flags f{Modifier{}};
+    f.limits = &limits;
+    auto out = evaluate(begin, begin, end, f, return_type<Iterator, RE>{},
+                        ctll::list<start_mark, limited_t<RE>, end_mark, accept>());
+    return make_limited_result(out, limits);
+}
+
+// Every start position is a step too, so a long subject can't dodge the budget
+template <typename RE, typename Modifier, typename Iterator>
+auto limited_search_exec(match_limits& limits, Iterator begin, Iterator end) noexcept {
+    constexpr bool fixed = starts_with_anchor(Modifier{}, ctll::list<RE>{});
+    flags f{Modifier{}};
+    f.limits = &limits;
+    auto it = begin;
+    for (; end != it && !fixed && !limits.exceeded; ++it) {
+        if (auto out = evaluate(begin, it, end, f, return_type<Iterator, RE>{},
+                                ctll::list<step_tick, start_mark, limited_t<RE>, end_mark, accept>())) {
+            return make_limited_result(out, limits);
+        }
+    }
+    auto out = evaluate(begin, it, end, f, return_type<Iterator, RE>{},
+                        ctll::list<step_tick, start_mark, limited_t<RE>, end_mark, accept>());
+    if (!out) out.set_end_mark(it);
+    return make_limited_result(out, limits);
+}
+
+// ctre::limited_match<"pattern">(limits, subject) and friends: like match, search
+// and starts_with, but give up with match_status::limit_exceeded once the limits
+// are spent. The limits keep counting across calls sharing them.
+CTRE_EXPORT template <CTRE_REGEX_INPUT_TYPE input, typename... Modifiers, typename Range>
+auto limited_match(match_limits& limits, const Range& range) noexcept {
+    return limited_match_exec<typename regex_builder<input>::type, ctll::list<singleline, Modifiers...>>(
+        limits, std::begin(range), std::end(range));
+}
+
+CTRE_EXPORT template <CTRE_REGEX_INPUT_TYPE input, typename... Modifiers, typename Range>
+auto limited_search(match_limits& limits, const Range& range) noexcept {
+    return limited_search_exec<typename regex_builder<input>::type, ctll::list<singleline, Modifiers...>>(
+        limits, std::begin(range), std::end(range));
+}
+
+CTRE_EXPORT template <CTRE_REGEX_INPUT_TYPE input, typename... Modifiers, typename Range>
+auto limited_starts_with(match_limits& limits, const Range& range) noexcept {
+    return limited_starts_with_exec<typename regex_builder<input>::type, ctll::list<singleline, Modifiers...>>(
+        limits, std::begin(range), std::end(range));
+}
+
+} // namespace ctre
+
+#endif
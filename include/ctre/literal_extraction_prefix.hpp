@@ -0,0 +1,137 @@
+#ifndef CTRE__LITERAL_EXTRACTION_PREFIX__HPP
+#define CTRE__LITERAL_EXTRACTION_PREFIX__HPP
+
+#include "char_class_expansion.hpp"
+#include "multi_literal.hpp"
+#include "pattern_traits.hpp"
+
+// Prefix literal set: every match of the pattern starts with one of the literals.
+// Unlike extract_literals_simple_multi, extraction stops at the first element that
+// is not an exact string (repeat, any, assertion, ...), so the set can be used to
+// skip ahead to candidate match starts without losing matches.
+
+namespace ctre::extraction {
+
+using namespace ctre::traits;
+
+// Only ASCII is taken literally: other code points depend on the input encoding
+template <auto V>
+inline constexpr bool is_ascii_value = static_cast<long long>(V) >= 0 && static_cast<long long>(V) < 128;
+
+// Character classes whose every member is known (no \w, \d, negations, ...)
+template <typename T> struct is_exact_char_class : std::false_type {};
+template <auto V> struct is_exact_char_class<character<V>> : std::bool_constant<is_ascii_value<V>> {};
+template <auto A, auto B> struct is_exact_char_class<char_range<A, B>> : std::bool_constant<is_ascii_value<A> && is_ascii_value<B>> {};
+template <auto... Cs> struct is_exact_char_class<enumeration<Cs...>> : std::bool_constant<(is_ascii_value<Cs> && ...)> {};
+template <typename... Content> struct is_exact_char_class<set<Content...>> : std::bool_constant<(is_exact_char_class<Content>::value && ...)> {};
+
+template <size_t MaxPaths, size_t MaxLiteralLen>
+struct prefix_paths {
+    std::array<literal_result<MaxLiteralLen>, MaxPaths> paths{};
+    size_t count = 1;
+    bool open = true; // paths still extend into the next element
+
+    constexpr void add_char_to_all(char c) noexcept {
+        for (size_t i = 0; i < count; ++i) paths[i].add_char(c);
+    }
+
+    constexpr void multiply(const char* chars, size_t char_count) noexcept {
+        if (count * char_count > MaxPaths) { open = false; return; }
+        std::array<literal_result<MaxLiteralLen>, MaxPaths> next{};
+        size_t n = 0;
+        for (size_t i = 0; i < count; ++i) {
+            for (size_t j = 0; j < char_count; ++j) {
+                next[n] = paths[i];
+                next[n++].add_char(chars[j]);
+            }
+        }
+        paths = next;
+        count = n;
+    }
+};
+
+template <typename T, size_t MaxPaths, size_t MaxLiteralLen>
+constexpr void extract_prefix(prefix_paths<MaxPaths, MaxLiteralLen>& p) noexcept;
+
+template <typename... Content, size_t MaxPaths, size_t MaxLiteralLen>
+constexpr void extract_prefix_sequence(prefix_paths<MaxPaths, MaxLiteralLen>& p) noexcept {
+    (extract_prefix<Content>(p), ...);
+}
+
+template <auto... Str, size_t MaxPaths, size_t MaxLiteralLen>
+constexpr void extract_prefix_string(prefix_paths<MaxPaths, MaxLiteralLen>& p, string<Str...>*) noexcept {
+    ([&] {
+        if (!p.open) return;
+        if constexpr (is_ascii_value<Str>) p.add_char_to_all(static_cast<char>(Str));
+        else p.open = false;
+    }(), ...);
+}
+
+template <typename... Opts, size_t MaxPaths, size_t MaxLiteralLen>
+constexpr void extract_prefix_select(prefix_paths<MaxPaths, MaxLiteralLen>& p, select<Opts...>*) noexcept {
+    prefix_paths<MaxPaths, MaxLiteralLen> merged;
+    merged.count = 0;
+    bool fits = true;
+    ([&] {
+        prefix_paths<MaxPaths, MaxLiteralLen> branch = p;
+        extract_prefix<Opts>(branch);
+        if (merged.count + branch.count > MaxPaths) { fits = false; return; }
+        for (size_t i = 0; i < branch.count; ++i) merged.paths[merged.count++] = branch.paths[i];
+        merged.open = merged.open && branch.open;
+    }(), ...);
+    if (fits) p = merged;
+    else p.open = false;
+}
+
+template <typename T, size_t MaxPaths, size_t MaxLiteralLen>
+constexpr void extract_prefix(prefix_paths<MaxPaths, MaxLiteralLen>& p) noexcept {
+    if (!p.open) return;
+    if constexpr (is_empty_v<T>) {
+    } else if constexpr (is_string_v<T>) {
+        extract_prefix_string(p, static_cast<T*>(nullptr));
+    } else if constexpr (is_sequence_v<T>) {
+        [&]<typename... Content>(sequence<Content...>*) {
+            extract_prefix_sequence<Content...>(p);
+        }(static_cast<T*>(nullptr));
+    } else if constexpr (is_capture_v<T>) {
+        [&]<size_t Index, typename... Content>(capture<Index, Content...>*) {
+            extract_prefix_sequence<Content...>(p);
+        }(static_cast<T*>(nullptr));
+    } else if constexpr (is_select_v<T>) {
+        extract_prefix_select(p, static_cast<T*>(nullptr));
+    } else if constexpr (is_any_repeat_v<T>) {
+        // At least one copy of the content is required; what follows it is not exact
+        [&]<template <size_t, size_t, typename...> typename Repeat, size_t A, size_t B, typename... Content>(Repeat<A, B, Content...>*) {
+            if constexpr (A >= 1) extract_prefix_sequence<Content...>(p);
+            if constexpr (!(A == 1 && B == 1)) p.open = false;
+        }(static_cast<T*>(nullptr));
+    } else if constexpr (is_exact_char_class<T>::value && char_class_size_v<T> <= MAX_CHAR_CLASS_EXPANSION) {
+        constexpr auto expanded = expand_char_class<T>();
+        if constexpr (expanded.is_expandable && expanded.count == char_class_size_v<T>) {
+            if (expanded.count == 1) p.add_char_to_all(expanded.chars[0]);
+            else p.multiply(expanded.chars.data(), expanded.count);
+        } else {
+            p.open = false;
+        }
+    } else {
+        p.open = false;
+    }
+}
+
+// Public API: has_literals is set only when no path is empty
+template <typename AST, size_t MaxLiterals = 16, size_t MaxLiteralLen = 64>
+[[nodiscard]] constexpr auto extract_prefix_literals() noexcept {
+    prefix_paths<MaxLiterals, MaxLiteralLen> paths;
+    extract_prefix<AST>(paths);
+
+    multi_literal_result<MaxLiterals, MaxLiteralLen> result;
+    for (size_t i = 0; i < paths.count; ++i) {
+        if (paths.paths[i].length == 0) return multi_literal_result<MaxLiterals, MaxLiteralLen>{};
+        result.add_literal(paths.paths[i]);
+    }
+    return result;
+}
+
+} // namespace ctre::extraction
+
+#endif // CTRE__LITERAL_EXTRACTION_PREFIX__HPP
@@ -0,0 +1,94 @@
+#ifndef CTRE__LONGEST__HPP
+#define CTRE__LONGEST__HPP
+
+#include "dfa/compile_dfa.hpp"
+#include "evaluation.hpp"
+#include "return_type.hpp"
+#ifndef CTRE_IN_A_MODULE
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#endif
+
+// POSIX leftmost-longest matching, opted into with the ctre::longest modifier.
+// evaluate commits to the first alternative that lets the rest match; here the
+// pattern's DFAs fix the span instead: search takes the leftmost start (one
+// backward pass of the reversed DFA) and the longest end from it, starts_with
+// the longest prefix. evaluate then only fills the captures within that span.
+// match is unaffected, a whole-subject match is the same under both rules.
+
+namespace ctre {
+
+template <typename Modifier> struct is_longest : std::is_same<Modifier, longest> {};
+template <typename... Modifiers> struct is_longest<ctll::list<Modifiers...>> : std::bool_constant<(std::is_same_v<Modifiers, longest> || ...)> {};
+
+// The DFA is built for case-sensitive, singleline char matching
+template <typename Modifier, typename RE, typename Iterator>
+inline constexpr bool longest_viable = !is_case_insensitive(flags{Modifier{}}) && !multiline_mode(flags{Modifier{}}) &&
+    std::is_same_v<std::remove_cvref_t<decltype(*std::declval<Iterator>())>, char> && dfa::dfa_viable_v<RE>;
+
+// Result for the span [from, to); should evaluate split it differently than the DFA
+// (a repeat nested in a repeat is not backtracked into), only the whole match is set
+template <typename RE, typename Modifier, typename R, typename BeginIterator, typename Iterator>
+constexpr R longest_result(BeginIterator orig_begin, Iterator from, Iterator to) noexcept {
+    if constexpr (dfa::has_capture<RE>::value) {
+        if (auto out = evaluate(orig_begin, from, to, Modifier{}, R{},
+                                ctll::list<start_mark, RE, assert_subject_end, end_mark, accept>())) {
+            return out;
+        }
+    }
+    R out;
+    out.set_start_mark(from).set_end_mark(to).matched();
+    return out;
+}
+
+// End of the longest match starting at it, for any iterator
+template <typename Table, typename Iterator, typename EndIterator>
+constexpr std::pair<bool, Iterator> longest_end(const Table& dfa, Iterator it, const EndIterator end) noexcept {
+    uint16_t state = Table::start_state;
+    std::pair<bool, Iterator> last{dfa.accepting[state], it};
+    while (it != end) {
+        state = dfa.step(state, *it);
+        if (state == Table::dead_state) break;
+        ++it;
+        if (dfa.accepting[state]) last = {true, it};
+    }
+    return last;
+}
+
+template <typename RE, typename Modifier, typename R, typename BeginIterator, typename Iterator, typename EndIterator>
+constexpr R longest_starts_with(BeginIterator orig_begin, Iterator begin, EndIterator end) noexcept {
+    const auto [found, to] = longest_end(dfa::forward_dfa<RE>, begin, end);
+    if (!found) return R{};
+    return longest_result<RE, Modifier, R>(orig_begin, begin, to);
+}
+
+template <typename RE, typename Modifier, typename R, typename BeginIterator, typename Iterator, typename EndIterator>
+constexpr R longest_search(BeginIterator orig_begin, Iterator begin, EndIterator end) noexcept {
+    if constexpr (std::is_pointer_v<Iterator> && std::is_same_v<EndIterator, const char*> && dfa::dfa_viable<dfa::reversed_t<RE>, true>()) {
+        // Stops near the match, search_all must not pay for the rest of the input per match
+        const char* start = dfa::first_match_start(dfa::forward_dfa<RE>, dfa::reverse_dfa<RE>, begin, end);
+        if (start == nullptr) {
+            R out;
+            out.set_end_mark(end);
+            return out;
+        }
+        return longest_result<RE, Modifier, R>(orig_begin, start, dfa::longest_from(dfa::forward_dfa<RE>, start, end));
+    } else {
+        // Without the reversed DFA every start is tried, leftmost first
+        for (Iterator it = begin;; ++it) {
+            if (const auto [found, to] = longest_end(dfa::forward_dfa<RE>, it, end); found) {
+                return longest_result<RE, Modifier, R>(orig_begin, it, to);
+            }
+            if (it == end) {
+                R out;
+                out.set_end_mark(it);
+                return out;
+            }
+        }
+    }
+}
+
+} // namespace ctre
+
+#endif
@@ -0,0 +1,54 @@
+#ifndef CTRE__MATCH_LENGTH__HPP
+#define CTRE__MATCH_LENGTH__HPP
+
+#include "atoms.hpp"
+#include "pattern_traits.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+
+namespace ctre {
+
+inline constexpr size_t unbounded_match_length = std::numeric_limits<size_t>::max();
+
+// Longest possible match, or unbounded_match_length; assertions, lookarounds and
+// backreferences count as unbounded, since they may inspect input past the match
+template <typename T> struct max_match_length : std::integral_constant<size_t, traits::CharacterLike<T> ? 1 : unbounded_match_length> {};
+template <typename T> inline constexpr size_t max_match_length_v = max_match_length<T>::value;
+
+namespace match_length_detail {
+constexpr size_t saturating_add(size_t a, size_t b) noexcept {
+    return (a == unbounded_match_length || b > unbounded_match_length - a) ? unbounded_match_length : a + b;
+}
+constexpr size_t saturating_mul(size_t a, size_t n) noexcept {
+    return (a != 0 && n > unbounded_match_length / a) ? unbounded_match_length : a * n;
+}
+template <size_t B, typename... Content>
+constexpr size_t repeat_length() noexcept {
+    constexpr size_t content = (size_t{0} + ... + max_match_length_v<Content>);
+    if constexpr (B == 0) return content == 0 ? 0 : unbounded_match_length;
+    else return saturating_mul(content, B);
+}
+template <typename... Content>
+constexpr size_t sequence_length() noexcept {
+    size_t total = 0;
+    ((total = saturating_add(total, max_match_length_v<Content>)), ...);
+    return total;
+}
+} // namespace match_length_detail
+
+template <> struct max_match_length<any> : std::integral_constant<size_t, 1> {};
+template <> struct max_match_length<empty> : std::integral_constant<size_t, 0> {};
+template <auto... Str> struct max_match_length<string<Str...>> : std::integral_constant<size_t, sizeof...(Str)> {};
+template <typename... Content> struct max_match_length<sequence<Content...>> : std::integral_constant<size_t, match_length_detail::sequence_length<Content...>()> {};
+template <typename... Content> struct max_match_length<select<Content...>> : std::integral_constant<size_t, std::max({size_t{0}, max_match_length_v<Content>...})> {};
+template <size_t Index, typename... Content> struct max_match_length<capture<Index, Content...>> : max_match_length<sequence<Content...>> {};
+template <size_t Index, typename Name, typename... Content> struct max_match_length<capture_with_name<Index, Name, Content...>> : max_match_length<sequence<Content...>> {};
+template <size_t A, size_t B, typename... Content> struct max_match_length<repeat<A, B, Content...>> : std::integral_constant<size_t, match_length_detail::repeat_length<B, Content...>()> {};
+template <size_t A, size_t B, typename... Content> struct max_match_length<lazy_repeat<A, B, Content...>> : std::integral_constant<size_t, match_length_detail::repeat_length<B, Content...>()> {};
+template <size_t A, size_t B, typename... Content> struct max_match_length<possessive_repeat<A, B, Content...>> : std::integral_constant<size_t, match_length_detail::repeat_length<B, Content...>()> {};
+
+} // namespace ctre
+
+#endif // CTRE__MATCH_LENGTH__HPP
@@ -0,0 +1,298 @@
+#ifndef CTRE__MEMOIZATION__HPP
+#define CTRE__MEMOIZATION__HPP
+
+#include "evaluation.hpp"
+#include "return_type.hpp"
+#include "rotate.hpp"
+#include "starts_with_anchor.hpp"
+#ifndef CTRE_IN_A_MODULE
+#include <cstdint>
+#include <iterator>
+#include <vector>
+#endif
+
+// Memoized backtracking (RE2's BitState), opted into with the ctre::memoized
+// modifier. Every select and repeat of the pattern is wrapped in a memo_point with
+// its own id; without backreferences or inline mode switches, whether the rest of
+// the pattern can match from a point depends on the position alone, so a failed
+// (point, position) pair is recorded in a bitset and never explored again. Greedy
+// unbounded repeats record their loop state rather than their entry, which makes
+// nested quantifiers linear in the input. Capture semantics are unchanged: only
+// failures are remembered.
+
+namespace ctre {
+
+// One bit per (memo point, position), positions relative to the subject start
+struct memo_arena {
+    std::vector<uint64_t> bits;
+    size_t stride = 0;
+
+    memo_arena(size_t points, size_t positions): bits((points * positions + 63) / 64), stride(positions) { }
+
+    [[nodiscard]] bool seen(size_t id, size_t position) const noexcept {
+        const size_t bit = id * stride + position;
+        return (bits[bit / 64] >> (bit % 64)) & 1u;
+    }
+    void mark(size_t id, size_t position) noexcept {
+        const size_t bit = id * stride + position;
+        bits[bit / 64] |= uint64_t{1} << (bit % 64);
+    }
+};
+
+// Failures only depend on the position outside of repeat bodies which have not
+// consumed anything yet (end_cycle_mark rejects empty iterations there)
+constexpr CTRE_FORCE_INLINE bool memo_active(const flags& f) noexcept {
+    return f.memo != nullptr && !cannot_be_empty_match(f);
+}
+
+// Patterns where a failure depends on more than the position are not memoized
+template <typename T> struct memo_safe : std::true_type {};
+template <size_t Id> struct memo_safe<back_reference<Id>> : std::false_type {};
+template <typename Name> struct memo_safe<back_reference_with_name<Name>> : std::false_type {};
+template <typename Mode> struct memo_safe<mode_switch<Mode>> : std::false_type {};
+template <typename... Content> struct memo_safe<sequence<Content...>> : std::bool_constant<(memo_safe<Content>::value && ...)> {};
+template <typename... Content> struct memo_safe<select<Content...>> : std::bool_constant<(memo_safe<Content>::value && ...)> {};
+template <typename... Content> struct memo_safe<atomic_group<Content...>> : std::bool_constant<(memo_safe<Content>::value && ...)> {};
+template <typename... Content> struct memo_safe<lookahead_positive<Content...>> : std::bool_constant<(memo_safe<Content>::value && ...)> {};
+template <typename... Content> struct memo_safe<lookahead_negative<Content...>> : std::bool_constant<(memo_safe<Content>::value && ...)> {};
+template <typename... Content> struct memo_safe<lookbehind_positive<Content...>> : std::bool_constant<(memo_safe<Content>::value && ...)> {};
+template <typename... Content> struct memo_safe<lookbehind_negative<Content...>> : std::bool_constant<(memo_safe<Content>::value && ...)> {};
+template <size_t Index, typename... Content> struct memo_safe<capture<Index, Content...>> : std::bool_constant<(memo_safe<Content>::value && ...)> {};
+template <size_t Index, typename Name, typename... Content> struct memo_safe<capture_with_name<Index, Name, Content...>> : std::bool_constant<(memo_safe<Content>::value && ...)> {};
+template <size_t A, size_t B, typename... Content> struct memo_safe<repeat<A, B, Content...>> : std::bool_constant<(memo_safe<Content>::value && ...)> {};
+template <size_t A, size_t B, typename... Content> struct memo_safe<lazy_repeat<A, B, Content...>> : std::bool_constant<(memo_safe<Content>::value && ...)> {};
+template <size_t A, size_t B, typename... Content> struct memo_safe<possessive_repeat<A, B, Content...>> : std::bool_constant<(memo_safe<Content>::value && ...)> {};
+
+template <typename Modifier> struct is_memoized : std::is_same<Modifier, memoized> {};
+template <typename... Modifiers> struct is_memoized<ctll::list<Modifiers...>> : std::bool_constant<(std::is_same_v<Modifiers, memoized> || ...)> {};
+
+template <typename Modifier, typename RE, typename IteratorBegin, typename IteratorEnd>
+inline constexpr bool use_memoization = is_memoized<Modifier>::value && memo_safe<RE>::value &&
+                                        std::random_access_iterator<IteratorBegin> &&
+                                        std::is_same_v<IteratorBegin, IteratorEnd>;
+
+// Wraps selects and repeats into memo points numbered from Next in pre-order;
+// lookarounds are left alone (lookbehinds run on reversed iterators)
+template <size_t Next, typename T> struct memo_rewrite {
+    using type = T;
+    static constexpr size_t next = Next;
+};
+
+template <size_t Next, typename Done, typename... Rest> struct memo_rewrite_each {
+    using type = Done;
+    static constexpr size_t next = Next;
+};
+
+template <size_t Next, typename... Done, typename Head, typename... Rest>
+struct memo_rewrite_each<Next, ctll::list<Done...>, Head, Rest...> {
+    using head = memo_rewrite<Next, Head>;
+    using rest = memo_rewrite_each<head::next, ctll::list<Done..., typename head::type>, Rest...>;
+    using type = typename rest::type;
+    static constexpr size_t next = rest::next;
+};
+
+template <size_t Next, typename... Content> struct memo_rewrite<Next, sequence<Content...>> {
+    using content = memo_rewrite_each<Next, ctll::list<>, Content...>;
+    using type = decltype(convert_to_basic_list<sequence>(typename content::type{}));
+    static constexpr size_t next = content::next;
+};
+
+template <size_t Next, typename... Content> struct memo_rewrite<Next, atomic_group<Content...>> {
+    using content = memo_rewrite_each<Next, ctll::list<>, Content...>;
+    using type = decltype(convert_to_basic_list<atomic_group>(typename content::type{}));
+    static constexpr size_t next = content::next;
+};
+
+template <size_t Next, typename... Options> struct memo_rewrite<Next, select<Options...>> {
+    using content = memo_rewrite_each<Next + 1, ctll::list<>, Options...>;
+    using type = memo_point<Next, decltype(convert_to_basic_list<select>(typename content::type{}))>;
+    static constexpr size_t next = content::next;
+};
+
+template <size_t Next, size_t Index, typename... Content> struct memo_rewrite<Next, capture<Index, Content...>> {
+    using content = memo_rewrite_each<Next, ctll::list<>, Content...>;
+    using type = decltype(convert_to_capture<Index>(typename content::type{}));
+    static constexpr size_t next = content::next;
+};
+
+template <size_t Next, size_t Index, typename Name, typename... Content>
+struct memo_rewrite<Next, capture_with_name<Index, Name, Content...>> {
+    using content = memo_rewrite_each<Next, ctll::list<>, Content...>;
+    using type = decltype(convert_to_named_capture<Index, Name>(typename content::type{}));
+    static constexpr size_t next = content::next;
+};
+
+template <size_t Next, size_t A, size_t B, typename... Content> struct memo_rewrite<Next, repeat<A, B, Content...>> {
+    using content = memo_rewrite_each<Next + 1, ctll::list<>, Content...>;
+    using type = memo_point<Next, decltype(convert_to_repeat<repeat, A, B>(typename content::type{}))>;
+    static constexpr size_t next = content::next;
+};
+
+template <size_t Next, size_t A, size_t B, typename... Content> struct memo_rewrite<Next, lazy_repeat<A, B, Content...>> {
+    using content = memo_rewrite_each<Next + 1, ctll::list<>, Content...>;
+    using type = memo_point<Next, decltype(convert_to_repeat<lazy_repeat, A, B>(typename content::type{}))>;
+    static constexpr size_t next = content::next;
+};
+
+// Possessive repeats never backtrack into their content, only the content is wrapped
+template <size_t Next, size_t A, size_t B, typename... Content>
+struct memo_rewrite<Next, possessive_repeat<A, B, Content...>> {
+    using content = memo_rewrite_each<Next, ctll::list<>, Content...>;
+    using type = decltype(convert_to_repeat<possessive_repeat, A, B>(typename content::type{}));
+    static constexpr size_t next = content::next;
+};
+
+template <typename RE> using memoized_t = typename memo_rewrite<0, RE>::type;
+template <typename RE> inline constexpr size_t memo_point_count = memo_rewrite<0, RE>::next;
+
+// any memo point: remember failed entries
+template <typename R, typename BeginIterator, typename Iterator, typename EndIterator, size_t Id, typename Node,
+          typename... Tail>
+constexpr CTRE_FORCE_INLINE R evaluate(const BeginIterator begin, Iterator current, const EndIterator last,
+                                       const flags& f, R captures,
+                                       ctll::list<memo_point<Id, Node>, Tail...>) noexcept {
+    if constexpr (std::is_same_v<Iterator, BeginIterator>) {
+        if (memo_active(f)) {
+            const auto position = static_cast<size_t>(current - begin);
+            if (f.memo->seen(Id, position)) return not_matched;
+            auto out = evaluate(begin, current, last, f, captures, ctll::list<Node, Tail...>());
+            if (!out) f.memo->mark(Id, position);
+            return out;
+        }
+    }
+    return evaluate(begin, current, last, f, captures, ctll::list<Node, Tail...>());
+}
+
+// greedy unbounded loop from `current`, after the mandatory iterations
+template <size_t Id, typename R, typename BeginIterator, typename Iterator, typename EndIterator, size_t A,
+          typename... Content, typename... Tail>
+constexpr inline R memo_repeat_loop(const BeginIterator begin, Iterator current, const EndIterator last,
+                                    const flags& f, R captures,
+                                    ctll::list<repeat<A, 0, Content...>, Tail...> stack) noexcept {
+    const auto position = static_cast<size_t>(current - begin);
+    if (f.memo->seen(Id, position)) return not_matched;
+
+    if (auto inner_result = evaluate(begin, current, last, not_empty_match(f), captures,
+                                     ctll::list<Content..., end_cycle_mark>())) {
+        if (auto rec_result =
+                memo_repeat_loop<Id>(begin, inner_result.get_end_position(), last, f, inner_result.unmatch(), stack)) {
+            return rec_result;
+        }
+    }
+    if (auto out = evaluate(begin, current, last, consumed_something(f), captures, ctll::list<Tail...>())) {
+        return out;
+    }
+    f.memo->mark(Id, position);
+    return not_matched;
+}
+
+// repeat turned possessive: every position the loop passes through ends the loop
+// at the same place, so once the rest fails there they are all remembered
+template <size_t Id, typename R, typename BeginIterator, typename Iterator, typename EndIterator, size_t A,
+          typename... Content, typename... Tail>
+constexpr inline R memo_possessive_loop(const BeginIterator begin, Iterator current, const EndIterator last,
+                                        const flags& f, R captures,
+                                        ctll::list<repeat<A, 0, Content...>, Tail...>) noexcept {
+    Iterator it = current;
+    bool known = false;
+    for (;;) {
+        if (f.memo->seen(Id, static_cast<size_t>(it - begin))) {
+            known = true;
+            break;
+        }
+        auto inner_result =
+            evaluate(begin, it, last, not_empty_match(f), captures, ctll::list<Content..., end_cycle_mark>());
+        if (!inner_result) break;
+        captures = inner_result.unmatch();
+        it = inner_result.get_end_position();
+    }
+    if (!known) {
+        if (auto out = evaluate(begin, it, last, consumed_something(f, current != it), captures, ctll::list<Tail...>())) {
+            return out;
+        }
+        f.memo->mark(Id, static_cast<size_t>(it - begin));
+    }
+    // walk the same iterations again to record the positions in between
+    while (current != it) {
+        f.memo->mark(Id, static_cast<size_t>(current - begin));
+        current = evaluate(begin, current, last, not_empty_match(f), captures, ctll::list<Content..., end_cycle_mark>())
+                      .get_end_position();
+    }
+    return not_matched;
+}
+
+// greedy unbounded repeat: the loop state is only the position, whatever the
+// iteration count, so it is the loop and not the entry which is remembered
+template <typename R, typename BeginIterator, typename Iterator, typename EndIterator, size_t Id, size_t A,
+          typename... Content, typename... Tail>
+constexpr CTRE_FORCE_INLINE R evaluate(const BeginIterator begin, Iterator current, const EndIterator last,
+                                       const flags& f, R captures,
+                                       ctll::list<memo_point<Id, repeat<A, 0, Content...>>, Tail...>) noexcept {
+    using stack = ctll::list<repeat<A, 0, Content...>, Tail...>;
+    // repeats turned possessive don't backtrack
+    constexpr bool possessive = !collides(calculate_first(Content{}...), calculate_first(Tail{}...));
+    if constexpr (std::is_same_v<Iterator, BeginIterator>) {
+        if (memo_active(f)) {
+            for (size_t i = 0; i < A; ++i) {
+                auto inner_result = evaluate(begin, current, last, not_empty_match(f), captures,
+                                             ctll::list<Content..., end_cycle_mark>());
+                if (!inner_result) return not_matched;
+                captures = inner_result.unmatch();
+                current = inner_result.get_end_position();
+            }
+            if constexpr (possessive) return memo_possessive_loop<Id>(begin, current, last, f, captures, stack());
+            else return memo_repeat_loop<Id>(begin, current, last, f, captures, stack());
+        }
+    }
+    return evaluate(begin, current, last, f, captures, stack());
+}
+
+// Entry points used by the match methods: attach an arena sized for every memo
+// point at every position of the subject, then run the rewritten pattern
+template <typename RE, typename Modifier, typename BeginIterator, typename Run>
+inline auto memo_run(BeginIterator orig_begin, BeginIterator end, Run&& run) noexcept {
+    memo_arena arena{memo_point_count<RE>, static_cast<size_t>(end - orig_begin) + 1};
+    flags f{Modifier{}};
+    f.memo = &arena;
+    return run(f, memoized_t<RE>{});
+}
+
+template <typename RE, typename Modifier, typename ResultIterator, typename BeginIterator>
+inline auto memo_match(BeginIterator orig_begin, BeginIterator begin, BeginIterator end) noexcept {
+    return memo_run<RE, Modifier>(orig_begin, end, [&]<typename MRE>(const flags& f, MRE) {
+        return evaluate(orig_begin, begin, end, f, return_type_for<Modifier, ResultIterator, BeginIterator, RE>{},
+                        ctll::list<start_mark, MRE, assert_subject_end, end_mark, accept>());
+    });
+}
+
+template <typename RE, typename Modifier, typename ResultIterator, typename BeginIterator>
+inline auto memo_starts_with(BeginIterator orig_begin, BeginIterator begin, BeginIterator end) noexcept {
+    return memo_run<RE, Modifier>(orig_begin, end, [&]<typename MRE>(const flags& f, MRE) {
+        return evaluate(orig_begin, begin, end, f, return_type_for<Modifier, ResultIterator, BeginIterator, RE>{},
+                        ctll::list<start_mark, MRE, end_mark, accept>());
+    });
+}
+
+// The arena is shared by all start positions: a failure never depends on where
+// the match started
+template <typename RE, typename Modifier, typename ResultIterator, typename BeginIterator>
+inline auto memo_search(BeginIterator orig_begin, BeginIterator begin, BeginIterator end) noexcept {
+    return memo_run<RE, Modifier>(orig_begin, end, [&]<typename MRE>(const flags& f, MRE) {
+        constexpr bool fixed = starts_with_anchor(Modifier{}, ctll::list<RE>{});
+        auto it = begin;
+        for (; end != it && !fixed; ++it) {
+            if (auto out = evaluate(orig_begin, it, end, f, return_type_for<Modifier, ResultIterator, BeginIterator, RE>{},
+                                    ctll::list<start_mark, MRE, end_mark, accept>())) {
+                return out;
+            }
+        }
+        auto out = evaluate(orig_begin, it, end, f, return_type_for<Modifier, ResultIterator, BeginIterator, RE>{},
+                            ctll::list<start_mark, MRE, end_mark, accept>());
+        if (!out) out.set_end_mark(it);
+        return out;
+    });
+}
+
+} // namespace ctre
+
+#endif
@@ -0,0 +1,119 @@
+#ifndef CTRE__PARALLEL__HPP
+#define CTRE__PARALLEL__HPP
+
+#include "match_length.hpp"
+#include "wrapper.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+// Parallel search_all over one large buffer. The buffer is cut into chunks and every
+// chunk is scanned as if the previous match had ended exactly at its start; all scans
+// see the whole buffer, so lookbehind and matches running past the chunk end behave
+// as in a sequential scan. A merge pass then replays the real match chain: where the
+// previous chunk's last match ends inside a speculative match, scanning restarts
+// there until it lands on a match the chunk has already found.
+
+namespace ctre {
+
+// Runs task(0) .. task(count - 1) on one thread each and waits for all of them;
+// any callable with the same shape can be passed to parallel_find_all instead
+struct thread_executor {
+    template <typename Task>
+    void operator()(size_t count, Task&& task) const {
+        std::vector<std::thread> threads;
+        threads.reserve(count);
+        for (size_t i = 0; i < count; ++i) threads.emplace_back([&task, i] { task(i); });
+        for (auto& thread : threads) thread.join();
+    }
+};
+
+// Automatic chunking keeps chunks at least this large
+inline constexpr size_t parallel_min_chunk = size_t{1} << 16;
+
+// All matches of search_all over subject, in document order; an empty match moves
+// the scan on by one byte. chunk_count == 0 picks one chunk per hardware thread,
+// as long as chunks stay above parallel_min_chunk.
+CTRE_EXPORT template <CTRE_REGEX_INPUT_TYPE input, typename... Modifiers, typename Executor = thread_executor>
+auto parallel_find_all(std::string_view subject, Executor&& executor = {}, size_t chunk_count = 0) {
+    using RE = typename regex_builder<input>::type;
+    using modifier = ctll::list<singleline, Modifiers...>;
+    using searcher = regular_expression<RE, search_method, modifier>;
+    using anchored = regular_expression<RE, starts_with_method, modifier>;
+    using result_type = decltype(searcher::template exec_with_result_iterator<const char*>(
+        std::declval<const char*>(), std::declval<const char*>(), std::declval<const char*>()));
+
+    const char* const begin = subject.data();
+    const char* const end = begin + subject.size();
+
+    // First match starting in [from, limit), over the whole subject
+    const auto next_match = [begin, end](const char* from, const char* limit) -> result_type {
+        constexpr size_t length = max_match_length_v<RE>;
+        if constexpr (length != unbounded_match_length) {
+            // Nothing starting before limit can read past limit + length
+            const char* window_end = static_cast<size_t>(end - limit) > length ? limit + length : end;
+            if (from < limit) {
+                auto r = searcher::template exec_with_result_iterator<const char*>(begin, from, window_end);
+                if (r && r.template get<0>().begin() < limit) return r;
+            }
+        } else {
+            for (const char* it = from; it < limit; ++it)
+                if (auto r = anchored::template exec_with_result_iterator<const char*>(begin, it, end)) return r;
+        }
+        return result_type{};
+    };
+    const auto resume_after = [](const result_type& r) {
+        const auto whole = r.template get<0>();
+        return whole.end() == whole.begin() ? whole.end() + 1 : whole.end();
+    };
+
+    if (chunk_count == 0)
+        chunk_count = std::min<size_t>(std::thread::hardware_concurrency(), subject.size() / parallel_min_chunk);
+    chunk_count = std::clamp<size_t>(chunk_count, 1, std::max<size_t>(1, subject.size()));
+    const auto chunk_begin = [&](size_t i) { return begin + subject.size() * i / chunk_count; };
+
+    // Speculative pass: chunk i scanned from its own start
+    std::vector<std::vector<result_type>> found(chunk_count);
+    executor(chunk_count, [&](size_t i) {
+        const char* const limit = chunk_begin(i + 1);
+        for (const char* it = chunk_begin(i); it < limit;) {
+            auto r = next_match(it, limit);
+            if (!r) break;
+            it = resume_after(r);
+            found[i].push_back(r);
+        }
+    });
+
+    // Merge: `it` is where the sequential scan continues; no match starts in
+    // [it, scanned) whenever the speculative matches are taken from `next`
+    std::vector<result_type> out;
+    const char* it = begin;
+    for (size_t i = 0; i < chunk_count; ++i) {
+        const char* const limit = chunk_begin(i + 1);
+        const auto& chunk = found[i];
+        it = std::max(it, chunk_begin(i));
+        const char* scanned = chunk_begin(i);
+        size_t next = 0;
+        for (;;) {
+            while (next < chunk.size() && chunk[next].template get<0>().begin() < it) scanned = resume_after(chunk[next++]);
+            if (scanned <= it) {
+                out.insert(out.end(), chunk.begin() + static_cast<std::ptrdiff_t>(next), chunk.end());
+                if (next < chunk.size()) it = resume_after(chunk.back());
+                break;
+            }
+            // The real chain ends inside a speculative match: rescan from there
+            auto r = next_match(it, limit);
+            if (!r) break;
+            it = resume_after(r);
+            out.push_back(r);
+        }
+    }
+    return out;
+}
+
+} // namespace ctre
+
+#endif // CTRE__PARALLEL__HPP
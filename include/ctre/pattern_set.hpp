@@ -0,0 +1,197 @@
+#ifndef CTRE__PATTERN_SET__HPP
+#define CTRE__PATTERN_SET__HPP
+
+#include "possessify.hpp"
+#include "wrapper.hpp"
+#ifndef CTRE_DISABLE_SIMD
+#include "decomposition.hpp"
+#endif
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+// Many independent patterns over one subject. The dominator literal of every pattern
+// (the one match_method prefilters on, which any match must contain) goes into one
+// compile-time Aho-Corasick automaton; the subject is scanned once with it, and only
+// the patterns whose literal occurred are searched for. Patterns without a literal,
+// or with inline mode switches that make the literal case-sensitive, are always
+// searched.
+
+namespace ctre {
+
+struct pattern_match {
+    size_t index;
+    std::string_view span;
+};
+
+namespace pattern_set_detail {
+
+struct pattern_literal {
+    const char* chars = nullptr;
+    size_t length = 0;
+};
+
+template <typename RE> constexpr pattern_literal literal_of() noexcept {
+#ifndef CTRE_DISABLE_SIMD
+    if constexpr (!has_mode_switch<RE>::value && decomposition::has_prefilter_literal<RE>) {
+        return {decomposition::prefilter_literal<RE>.chars.data(), decomposition::prefilter_literal<RE>.length};
+    } else
+#endif
+    {
+        return {};
+    }
+}
+
+template <typename... REs> inline constexpr std::array<pattern_literal, sizeof...(REs)> literals_of = {literal_of<REs>()...};
+
+template <size_t N> constexpr size_t total_length(const std::array<pattern_literal, N>& literals) noexcept {
+    size_t total = 0;
+    for (const auto& literal : literals) total += literal.length;
+    return total;
+}
+
+template <size_t N> constexpr size_t distinct_bytes(const std::array<pattern_literal, N>& literals) noexcept {
+    std::array<bool, 256> seen{};
+    size_t count = 0;
+    for (const auto& literal : literals) {
+        for (size_t i = 0; i < literal.length; ++i) {
+            const auto byte = static_cast<unsigned char>(literal.chars[i]);
+            count += !seen[byte];
+            seen[byte] = true;
+        }
+    }
+    return count;
+}
+
+// Complete transition table over byte classes (class 0 is every byte no literal
+// contains); output holds the patterns whose literal ends at each state, merged
+// along the fail links
+template <size_t Patterns, size_t States, size_t Classes> struct aho_corasick {
+    using state_type = std::conditional_t<(States <= 256), uint8_t, std::conditional_t<(States <= 65536), uint16_t, uint32_t>>;
+    static constexpr size_t words = (Patterns + 63) / 64;
+    using pattern_mask = std::array<uint64_t, words>;
+
+    std::array<uint8_t, 256> byte_class{};
+    std::array<std::array<state_type, Classes>, States> next{};
+    std::array<pattern_mask, States> output{};
+    std::array<bool, States> reports{};
+
+    // Patterns whose literal occurs in [begin, end)
+    constexpr pattern_mask scan(const char* begin, const char* end) const noexcept {
+        pattern_mask hits{};
+        state_type state = 0;
+        for (const char* it = begin; it != end; ++it) {
+            state = next[state][byte_class[static_cast<unsigned char>(*it)]];
+            if (reports[state]) {
+                for (size_t w = 0; w < words; ++w) hits[w] |= output[state][w];
+            }
+        }
+        return hits;
+    }
+};
+
+template <size_t Patterns, size_t States, size_t Classes>
+constexpr auto make_aho_corasick(const std::array<pattern_literal, Patterns>& literals) noexcept {
+    using automaton = aho_corasick<Patterns, States, Classes>;
+    using state_type = typename automaton::state_type;
+    automaton ac{};
+
+    size_t classes = 1;
+    for (const auto& literal : literals) {
+        for (size_t i = 0; i < literal.length; ++i) {
+            auto& cls = ac.byte_class[static_cast<unsigned char>(literal.chars[i])];
+            if (cls == 0) cls = static_cast<uint8_t>(classes++);
+        }
+    }
+
+    // Trie; state 0 is the root and never a child, so 0 means no edge here
+    size_t states = 1;
+    for (size_t p = 0; p < Patterns; ++p) {
+        const auto& literal = literals[p];
+        if (literal.length == 0) continue;
+        size_t state = 0;
+        for (size_t i = 0; i < literal.length; ++i) {
+            auto& edge = ac.next[state][ac.byte_class[static_cast<unsigned char>(literal.chars[i])]];
+            if (edge == 0) edge = static_cast<state_type>(states++);
+            state = edge;
+        }
+        ac.output[state][p / 64] |= uint64_t{1} << (p % 64);
+    }
+
+    // Breadth first, so fail targets are complete before their users
+    std::array<state_type, States> fail{};
+    std::array<state_type, States> queue{};
+    size_t head = 0;
+    size_t tail = 0;
+    for (size_t c = 0; c < Classes; ++c) {
+        if (const auto child = ac.next[0][c]; child != 0) queue[tail++] = child;
+    }
+    while (head < tail) {
+        const auto state = queue[head++];
+        for (size_t c = 0; c < Classes; ++c) {
+            const auto child = ac.next[state][c];
+            if (child == 0) {
+                ac.next[state][c] = ac.next[fail[state]][c];
+                continue;
+            }
+            fail[child] = ac.next[fail[state]][c];
+            for (size_t w = 0; w < automaton::words; ++w) ac.output[child][w] |= ac.output[fail[child]][w];
+            queue[tail++] = child;
+        }
+    }
+    for (size_t s = 0; s < States; ++s) {
+        for (size_t w = 0; w < automaton::words; ++w) ac.reports[s] = ac.reports[s] || ac.output[s][w] != 0;
+    }
+    return ac;
+}
+
+template <typename... REs>
+inline constexpr auto automaton_for = make_aho_corasick<sizeof...(REs), total_length(literals_of<REs...>) + 1,
+                                                        distinct_bytes(literals_of<REs...>) + 1>(literals_of<REs...>);
+
+template <typename RE> using searcher = regular_expression<RE, search_method, ctll::list<singleline>>;
+
+} // namespace pattern_set_detail
+
+// ctre::pattern_set<"p1", "p2", ...>: every pattern is searched for independently, as
+// with ctre::search, but literal prefiltering is shared over one pass of the subject
+CTRE_EXPORT template <CTRE_REGEX_INPUT_TYPE... inputs> struct pattern_set {
+    static constexpr size_t size() noexcept {
+        return sizeof...(inputs);
+    }
+
+    // Whether pattern `index` is only searched for once its literal has been seen
+    static constexpr bool prefiltered(size_t index) noexcept {
+        return pattern_set_detail::literals_of<typename regex_builder<inputs>::type...>[index].length != 0;
+    }
+
+    // Calls f(pattern_match) with the first match of every pattern found in subject,
+    // in pattern order
+    template <typename F> static void scan(std::string_view subject, F&& f) {
+        constexpr const auto& automaton = pattern_set_detail::automaton_for<typename regex_builder<inputs>::type...>;
+        const char* const begin = subject.data();
+        const char* const end = begin + subject.size();
+        const auto hits = automaton.scan(begin, end);
+
+        size_t index = 0;
+        const auto visit = [&]<typename RE>(RE*) {
+            const size_t current = index++;
+            if (prefiltered(current) && !(hits[current / 64] & (uint64_t{1} << (current % 64)))) return;
+            if (auto r = pattern_set_detail::searcher<RE>::exec(begin, end)) f(pattern_match{current, r.to_view()});
+        };
+        (visit(static_cast<typename regex_builder<inputs>::type*>(nullptr)), ...);
+    }
+
+    static std::vector<pattern_match> matches(std::string_view subject) {
+        std::vector<pattern_match> out;
+        scan(subject, [&](const pattern_match& m) { out.push_back(m); });
+        return out;
+    }
+};
+
+} // namespace ctre
+
+#endif // CTRE__PATTERN_SET__HPP
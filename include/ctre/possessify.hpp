@@ -0,0 +1,124 @@
+#ifndef CTRE__POSSESSIFY__HPP
+#define CTRE__POSSESSIFY__HPP
+
+#include "atoms.hpp"
+#include "first.hpp"
+#include "flags_and_modes.hpp"
+#include "rotate.hpp"
+#ifndef CTRE_IN_A_MODULE
+#include <type_traits>
+#endif
+
+// Automatic possessification: a greedy repeat whose first set is disjoint from
+// the first set of whatever follows it can never give a character back usefully,
+// so it is rewritten into a possessive_repeat before evaluation. This is the same
+// proof the evaluator does for each greedy repeat it reaches (see collides() in
+// first.hpp), done once on the AST so `[a-z]+@` or `\d+\.` go straight to the
+// possessive scan. Follow sets mirror the evaluator's stack: repeat bodies end at
+// end_cycle_mark and lookaheads at end_lookahead_mark. Lookbehinds are left alone.
+
+namespace ctre {
+
+template <typename T, typename Follow> struct possessive_rewrite { using type = T; };
+template <typename T, typename Follow = ctll::list<>> using possessified_t = typename possessive_rewrite<T, Follow>::type;
+
+// Rewrites a sequence of nodes, each one followed by the rest of it and then Follow
+template <typename Done, typename Rest, typename Follow> struct possessive_sequence;
+
+template <typename... Done, typename Follow> struct possessive_sequence<ctll::list<Done...>, ctll::list<>, Follow> {
+    using type = ctll::list<Done...>;
+};
+
+template <typename... Done, typename Head, typename... Rest, typename... Follow>
+struct possessive_sequence<ctll::list<Done...>, ctll::list<Head, Rest...>, ctll::list<Follow...>> {
+    using type = typename possessive_sequence<ctll::list<Done..., possessified_t<Head, ctll::list<Rest..., Follow...>>>,
+                                              ctll::list<Rest...>, ctll::list<Follow...>>::type;
+};
+
+template <typename Follow, typename... Content>
+using possessive_sequence_t = typename possessive_sequence<ctll::list<>, ctll::list<Content...>, Follow>::type;
+
+template <size_t A, size_t B, typename Follow, typename... Content> constexpr bool can_possessify() noexcept {
+    if constexpr ((B != 0) && (A > B)) {
+        return false;
+    } else {
+        return !collides(calculate_first(Content{}...), first(ctll::list<>{}, Follow{}));
+    }
+}
+
+template <size_t A, size_t B, bool Possessive, typename... Content>
+auto possessive_repeat_for(ctll::list<Content...>) -> std::conditional_t<Possessive, possessive_repeat<A, B, Content...>, repeat<A, B, Content...>>;
+
+template <typename... Content, typename Follow> struct possessive_rewrite<sequence<Content...>, Follow> {
+    using type = decltype(convert_to_basic_list<sequence>(possessive_sequence_t<Follow, Content...>{}));
+};
+
+template <typename... Options, typename Follow> struct possessive_rewrite<select<Options...>, Follow> {
+    using type = select<possessified_t<Options, Follow>...>;
+};
+
+template <size_t Index, typename... Content, typename Follow> struct possessive_rewrite<capture<Index, Content...>, Follow> {
+    using type = decltype(convert_to_capture<Index>(possessive_sequence_t<Follow, Content...>{}));
+};
+
+template <size_t Index, typename Name, typename... Content, typename Follow>
+struct possessive_rewrite<capture_with_name<Index, Name, Content...>, Follow> {
+    using type = decltype(convert_to_named_capture<Index, Name>(possessive_sequence_t<Follow, Content...>{}));
+};
+
+// the body is proven against the original content, rewriting it doesn't change first sets
+template <size_t A, size_t B, typename... Content, typename Follow> struct possessive_rewrite<repeat<A, B, Content...>, Follow> {
+    using type = decltype(possessive_repeat_for<A, B, can_possessify<A, B, Follow, Content...>()>(
+        possessive_sequence_t<ctll::list<end_cycle_mark>, Content...>{}));
+};
+
+template <size_t A, size_t B, typename... Content, typename Follow> struct possessive_rewrite<lazy_repeat<A, B, Content...>, Follow> {
+    using type = decltype(convert_to_repeat<lazy_repeat, A, B>(possessive_sequence_t<ctll::list<end_cycle_mark>, Content...>{}));
+};
+
+template <size_t A, size_t B, typename... Content, typename Follow> struct possessive_rewrite<possessive_repeat<A, B, Content...>, Follow> {
+    using type = decltype(convert_to_repeat<possessive_repeat, A, B>(possessive_sequence_t<ctll::list<end_cycle_mark>, Content...>{}));
+};
+
+template <typename... Content, typename Follow> struct possessive_rewrite<atomic_group<Content...>, Follow> {
+    using type = decltype(convert_to_basic_list<atomic_group>(possessive_sequence_t<ctll::list<end_cycle_mark>, Content...>{}));
+};
+
+template <typename... Content, typename Follow> struct possessive_rewrite<lookahead_positive<Content...>, Follow> {
+    using type = decltype(convert_to_basic_list<lookahead_positive>(possessive_sequence_t<ctll::list<end_lookahead_mark>, Content...>{}));
+};
+
+template <typename... Content, typename Follow> struct possessive_rewrite<lookahead_negative<Content...>, Follow> {
+    using type = decltype(convert_to_basic_list<lookahead_negative>(possessive_sequence_t<ctll::list<end_lookahead_mark>, Content...>{}));
+};
+
+// first sets are computed case-sensitively, so any case folding disables the pass
+template <typename T> struct has_mode_switch : std::false_type {};
+template <typename Mode> struct has_mode_switch<mode_switch<Mode>> : std::true_type {};
+template <typename... Content> struct has_mode_switch<sequence<Content...>> : std::bool_constant<(has_mode_switch<Content>::value || ...)> {};
+template <typename... Content> struct has_mode_switch<select<Content...>> : std::bool_constant<(has_mode_switch<Content>::value || ...)> {};
+template <typename... Content> struct has_mode_switch<atomic_group<Content...>> : std::bool_constant<(has_mode_switch<Content>::value || ...)> {};
+template <typename... Content> struct has_mode_switch<lookahead_positive<Content...>> : std::bool_constant<(has_mode_switch<Content>::value || ...)> {};
+template <typename... Content> struct has_mode_switch<lookahead_negative<Content...>> : std::bool_constant<(has_mode_switch<Content>::value || ...)> {};
+template <typename... Content> struct has_mode_switch<lookbehind_positive<Content...>> : std::bool_constant<(has_mode_switch<Content>::value || ...)> {};
+template <typename... Content> struct has_mode_switch<lookbehind_negative<Content...>> : std::bool_constant<(has_mode_switch<Content>::value || ...)> {};
+template <size_t Index, typename... Content> struct has_mode_switch<capture<Index, Content...>> : std::bool_constant<(has_mode_switch<Content>::value || ...)> {};
+template <size_t Index, typename Name, typename... Content> struct has_mode_switch<capture_with_name<Index, Name, Content...>> : std::bool_constant<(has_mode_switch<Content>::value || ...)> {};
+template <size_t A, size_t B, typename... Content> struct has_mode_switch<repeat<A, B, Content...>> : std::bool_constant<(has_mode_switch<Content>::value || ...)> {};
+template <size_t A, size_t B, typename... Content> struct has_mode_switch<lazy_repeat<A, B, Content...>> : std::bool_constant<(has_mode_switch<Content>::value || ...)> {};
+template <size_t A, size_t B, typename... Content> struct has_mode_switch<possessive_repeat<A, B, Content...>> : std::bool_constant<(has_mode_switch<Content>::value || ...)> {};
+
+template <typename RE, typename Modifier>
+inline constexpr bool use_possessify = !is_case_insensitive(flags{Modifier{}}) && !has_mode_switch<RE>::value;
+
+// The pattern the backtracking evaluator runs for RE under Modifier
+#ifndef CTRE_DISABLE_GREEDY_OPT
+template <typename RE, typename Modifier>
+using evaluated_pattern_t = std::conditional_t<use_possessify<RE, Modifier>, possessified_t<RE>, RE>;
+#else
+template <typename RE, typename Modifier> using evaluated_pattern_t = RE;
+#endif
+
+} // namespace ctre
+
+#endif
@@ -4,11 +4,13 @@
 #include "id.hpp"
 #include "utf8.hpp"
 #ifndef CTRE_IN_A_MODULE
+#include <cstdint>
 #include <type_traits>
 #include <tuple>
 #include <string_view>
 #include <string>
 #include <iterator>
+#include <limits>
 #include <optional>
 #ifdef _MSC_VER
 #include <memory>
@@ -219,6 +221,18 @@ template <size_t Id, typename Name = void> struct captured_content {
 			return str << rhs.view();
 		}
 	};
+	
+	// offsets into the subject, see compact_regex_results
+	struct compact_storage {
+		uint32_t begin{0};
+		uint32_t end{(std::numeric_limits<uint32_t>::max)()};
+		
+		using name = Name;
+		
+		constexpr CTRE_FORCE_INLINE static size_t get_id() noexcept {
+			return Id;
+		}
+	};
 };
 
 #if defined(__cpp_concepts) && __cpp_concepts >= 202002L
@@ -529,12 +543,128 @@ template <size_t Id, typename Iterator, typename... Captures> constexpr auto get
 	return results.template get<Id>();
 }
 
+struct compact_captures;
+
+// Results for ctre::compact_captures: the whole match keeps its iterators, every
+// capture group only two uint32_t offsets from where the first match attempt
+// started, with an unmatched group's end at the maximum. The object evaluate
+// copies around shrinks from three members per group to one word, and get<Id>()
+// rebuilds the usual captured_content storage. Subjects must be pointer ranges
+// shorter than 4 GiB.
+template <typename Iterator, typename... Captures> class compact_regex_results: public regex_results<Iterator> {
+	using whole_match = regex_results<Iterator>;
+	static constexpr uint32_t unmatched_end = (std::numeric_limits<uint32_t>::max)();
+	
+	captures<typename Captures::compact_storage...> _groups{};
+	Iterator _base{};
+	bool _has_base{false};
+	
+	template <typename Group> constexpr CTRE_FORCE_INLINE auto expand(const Group & group) const noexcept {
+		typename captured_content<Group::get_id(), typename Group::name>::template storage<Iterator> out;
+		if (group.end != unmatched_end) {
+			out.set_start(_base + group.begin);
+			out.set_end(_base + group.end);
+			out.matched();
+		}
+		return out;
+	}
+public:
+	constexpr CTRE_FORCE_INLINE compact_regex_results() noexcept { }
+	constexpr CTRE_FORCE_INLINE compact_regex_results(not_matched_tag_t) noexcept { }
+	
+	// special constructor for deducting
+	constexpr CTRE_FORCE_INLINE compact_regex_results(Iterator, ctll::list<Captures...>) noexcept { }
+	
+	template <size_t Id> CTRE_FORCE_INLINE constexpr auto get() const noexcept {
+		if constexpr (Id == 0) {
+			return whole_match::template get<0>();
+		} else {
+			constexpr bool capture_of_provided_id_must_exists = decltype(_groups)::template exists<Id>();
+			static_assert(capture_of_provided_id_must_exists);
+			
+			if constexpr (capture_of_provided_id_must_exists) {
+				return expand(_groups.template select<Id>());
+			} else {
+				return false;
+			}
+		}
+	}
+	template <typename Name> CTRE_FORCE_INLINE constexpr auto get() const noexcept {
+		constexpr bool capture_of_provided_name_must_exists = decltype(_groups)::template exists<Name>();
+		static_assert(capture_of_provided_name_must_exists);
+	
+		if constexpr (capture_of_provided_name_must_exists) {
+			return expand(_groups.template select<Name>());
+		} else {
+			return false;
+		}
+	}
+#if CTRE_CNTTP_COMPILER_CHECK
+	template <ctll::fixed_string Name> CTRE_FORCE_INLINE constexpr auto get() const noexcept {
+#else
+	template <const auto & Name> CTRE_FORCE_INLINE constexpr auto get() const noexcept {
+#endif
+		constexpr bool capture_of_provided_name_must_exists = decltype(_groups)::template exists<Name>();
+		static_assert(capture_of_provided_name_must_exists);
+	
+		if constexpr (capture_of_provided_name_must_exists) {
+			return expand(_groups.template select<Name>());
+		} else {
+			return false;
+		}
+	}
+	static constexpr size_t count() noexcept {
+		return sizeof...(Captures) + 1;
+	}
+	constexpr CTRE_FORCE_INLINE compact_regex_results & matched() noexcept {
+		whole_match::matched();
+		return *this;
+	}
+	constexpr CTRE_FORCE_INLINE compact_regex_results & unmatch() noexcept {
+		whole_match::unmatch();
+		return *this;
+	}
+	// the first start mark (set before any capture) is the base of all offsets,
+	// later ones (split iterators) only move the whole match
+	constexpr CTRE_FORCE_INLINE compact_regex_results & set_start_mark(Iterator pos) noexcept {
+		if (!_has_base) {
+			_base = pos;
+			_has_base = true;
+		}
+		whole_match::set_start_mark(pos);
+		return *this;
+	}
+	constexpr CTRE_FORCE_INLINE compact_regex_results & set_end_mark(Iterator pos) noexcept {
+		whole_match::set_end_mark(pos);
+		return *this;
+	}
+	template <size_t Id> CTRE_FORCE_INLINE constexpr compact_regex_results & start_capture(Iterator pos) noexcept {
+		_groups.template select<Id>().begin = static_cast<uint32_t>(pos - _base);
+		return *this;
+	}
+	template <size_t Id> CTRE_FORCE_INLINE constexpr compact_regex_results & end_capture(Iterator pos) noexcept {
+		_groups.template select<Id>().end = static_cast<uint32_t>(pos - _base);
+		return *this;
+	}
+};
+
+template <size_t Id, typename Iterator, typename... Captures> constexpr auto get(const compact_regex_results<Iterator, Captures...> & results) noexcept {
+	return results.template get<Id>();
+}
+
+template <typename Iterator, typename... Captures> compact_regex_results(Iterator, ctll::list<Captures...>) -> compact_regex_results<Iterator, Captures...>;
+
+template <typename Modifier> struct is_compact_captures : std::is_same<Modifier, compact_captures> {};
+template <typename... Modifiers> struct is_compact_captures<ctll::list<Modifiers...>> : std::bool_constant<(std::is_same_v<Modifiers, compact_captures> || ...)> {};
+
 template <typename Iterator, typename... Captures> regex_results(Iterator, ctll::list<Captures...>) -> regex_results<Iterator, Captures...>;
 
 template <typename> struct is_regex_results_t: std::false_type { };
 
 template <typename Iterator, typename... Captures> struct is_regex_results_t<regex_results<Iterator, Captures...>>: std::true_type { };
 
+template <typename Iterator, typename... Captures> struct is_regex_results_t<compact_regex_results<Iterator, Captures...>>: std::true_type { };
+
 template <typename T> constexpr bool is_regex_results_v = is_regex_results_t<T>();
 
 #if defined(__cpp_concepts) && __cpp_concepts >= 201907L
@@ -545,6 +675,14 @@ template <typename T> concept capture_groups = is_regex_results_v<T>;
 
 template <typename ResultIterator, typename Pattern> using return_type = decltype(regex_results(std::declval<ResultIterator>(), find_captures(Pattern{})));
 
+// compact_captures only applies to pointer subjects which are also the result iterators
+template <typename Modifier, typename ResultIterator, typename Iterator>
+inline constexpr bool use_compact_captures = is_compact_captures<Modifier>::value && std::is_pointer_v<ResultIterator> && std::is_same_v<ResultIterator, Iterator>;
+
+template <typename Modifier, typename ResultIterator, typename Iterator, typename Pattern> using return_type_for = std::conditional_t<use_compact_captures<Modifier, ResultIterator, Iterator>,
+	decltype(compact_regex_results(std::declval<ResultIterator>(), find_captures(Pattern{}))),
+	return_type<ResultIterator, Pattern>>;
+
 }
 
 // support for structured bindings
@@ -564,6 +702,15 @@ namespace std {
 			std::declval<const ctre::regex_results<Captures...> &>().template get<N>()
 		);
 	};
+
+	template <typename... Captures> struct tuple_size<ctre::compact_regex_results<Captures...>> : public std::integral_constant<size_t, ctre::compact_regex_results<Captures...>::count()> { };
+	
+	template <size_t N, typename... Captures> struct tuple_element<N, ctre::compact_regex_results<Captures...>> {
+	public:
+		using type = decltype(
+			std::declval<const ctre::compact_regex_results<Captures...> &>().template get<N>()
+		);
+	};
 }
 
 #ifdef __clang__
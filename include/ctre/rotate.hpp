@@ -41,6 +41,7 @@ static auto rotate(end_mark) -> end_mark;
 static auto rotate(end_cycle_mark) -> end_cycle_mark;
 static auto rotate(end_lookahead_mark) -> end_lookahead_mark;
 static auto rotate(end_lookbehind_mark) -> end_lookbehind_mark;
+static auto rotate(step_tick) -> step_tick;
 template <size_t Id> static auto rotate(numeric_mark<Id>) -> numeric_mark<Id>;
 static auto rotate(any) -> any;
 
@@ -0,0 +1,65 @@
+#ifndef CTRE__SIMD_BYTE_FREQUENCY__HPP
+#define CTRE__SIMD_BYTE_FREQUENCY__HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// Byte-frequency model for literal search. A literal is located by its two rarest
+// bytes rather than its first one: a literal starting with ' ', 'e' or '/' would
+// stop the vector filter on nearly every chunk of text. A model is a type with a
+// static constexpr std::array<uint8_t, 256> rank, higher for more frequent bytes;
+// define CTRE_BYTE_FREQUENCY to such a type before including ctre to replace the
+// English/log-text default for the whole program.
+
+namespace ctre::simd {
+
+// Ranks from bytes listed most frequent first; bytes not listed rank below all of them
+template <size_t N>
+[[nodiscard]] constexpr std::array<uint8_t, 256> byte_rank_from_order(const char (&order)[N]) noexcept {
+    static_assert(N <= 256, "A byte order lists every byte at most once");
+    std::array<uint8_t, 256> rank{};
+    for (size_t i = 0; i + 1 < N; ++i) rank[static_cast<unsigned char>(order[i])] = static_cast<uint8_t>(255 - i);
+    return rank;
+}
+
+// English prose and log lines: lowercase letters and separators first, then digits,
+// punctuation and uppercase; control bytes and non-ASCII are the rarest
+struct english_log_text_frequency {
+    static constexpr std::array<uint8_t, 256> rank = byte_rank_from_order(
+        " etaoinsrhldcu\nmfpgwyb.,012:-vk/=3549867_\"TSAEIRCNOLDPM()'[]xFBHUGWjqzKVY\tJXQZ;@#*+!?%|<>&${}~\\^`\r");
+};
+
+#ifndef CTRE_BYTE_FREQUENCY
+#define CTRE_BYTE_FREQUENCY ::ctre::simd::english_log_text_frequency
+#endif
+
+// Offsets of the rarest and the second rarest byte of a literal, equal for one byte
+struct rare_byte_offsets {
+    size_t rarest = 0;
+    size_t second = 0;
+};
+
+// Caseless search compares letters folded, so they are ranked as their lowercase
+template <typename Frequency = CTRE_BYTE_FREQUENCY>
+[[nodiscard]] constexpr rare_byte_offsets rare_bytes(const char* literal, size_t length, bool caseless = false) noexcept {
+    const auto rank = [&](size_t i) {
+        auto c = static_cast<unsigned char>(literal[i]);
+        if (caseless && c >= 'A' && c <= 'Z') c = static_cast<unsigned char>(c | 0x20);
+        return Frequency::rank[c];
+    };
+    rare_byte_offsets out;
+    for (size_t i = 1; i < length; ++i) {
+        if (rank(i) < rank(out.rarest)) {
+            out.second = out.rarest;
+            out.rarest = i;
+        } else if (out.second == out.rarest || rank(i) < rank(out.second)) {
+            out.second = i;
+        }
+    }
+    return out;
+}
+
+} // namespace ctre::simd
+
+#endif // CTRE__SIMD_BYTE_FREQUENCY__HPP
@@ -17,21 +17,24 @@ namespace ctre::simd {
 
 // Forward declarations
 template <typename SetType, size_t MinCount, size_t MaxCount, typename Iterator, typename EndIterator>
-inline Iterator match_char_class_repeat_avx2(Iterator current, const EndIterator& last, const flags& f, size_t& count);
+CTRE_TARGET_AVX2 inline Iterator match_char_class_repeat_avx2(Iterator current, const EndIterator& last, const flags& f,
+                                                              size_t& count);
 
 template <typename SetType, size_t MinCount, size_t MaxCount, typename Iterator, typename EndIterator>
-inline Iterator match_char_class_repeat_sse42(Iterator current, const EndIterator& last, const flags& f, size_t& count);
+CTRE_TARGET_SSE42 inline Iterator match_char_class_repeat_sse42(Iterator current, const EndIterator& last,
+                                                                const flags& f, size_t& count);
 
 template <typename SetType, size_t MinCount, size_t MaxCount, typename Iterator, typename EndIterator>
 inline Iterator match_char_class_repeat_scalar(Iterator current, const EndIterator& last, const flags& f,
                                                size_t& count);
 
 template <char TargetChar, size_t MinCount, size_t MaxCount, typename Iterator, typename EndIterator>
-inline Iterator match_single_char_repeat_avx2(Iterator current, const EndIterator& last, const flags& f, size_t& count);
+CTRE_TARGET_AVX2 inline Iterator match_single_char_repeat_avx2(Iterator current, const EndIterator& last,
+                                                               const flags& f, size_t& count);
 
 template <char TargetChar, size_t MinCount, size_t MaxCount, typename Iterator, typename EndIterator>
-inline Iterator match_single_char_repeat_sse42(Iterator current, const EndIterator& last, const flags& f,
-                                               size_t& count);
+CTRE_TARGET_SSE42 inline Iterator match_single_char_repeat_sse42(Iterator current, const EndIterator& last,
+                                                                 const flags& f, size_t& count);
 
 template <char TargetChar, size_t MinCount, size_t MaxCount, typename Iterator, typename EndIterator>
 inline Iterator match_single_char_repeat_scalar(Iterator current, const EndIterator& last, const flags& f,
@@ -265,21 +268,18 @@ inline Iterator match_pattern_repeat_simd(Iterator current, const EndIterator la
     size_t count = 0;
 
     if constexpr (can_use_simd()) {
-        const auto remaining = last - current;
-#if defined(CTRE_ARCH_X86) && defined(__AVX2__)
-        if (remaining >= 32) {
-            if (remaining >= 64)
-                current = match_char_class_repeat_avx2<PatternType, MinCount, MaxCount>(current, last, f, count);
-            else
-                current = match_char_class_repeat_sse42<PatternType, MinCount, MaxCount>(current, last, f, count);
-        }
-#elif defined(CTRE_ARCH_X86) && (defined(__SSE4_2__) || defined(__SSE2__))
-        if (remaining >= 32) {
-            current = match_char_class_repeat_sse42<PatternType, MinCount, MaxCount>(current, last, f, count);
+#ifdef CTRE_ARCH_X86
+        if (last - current >= 32) {
+            constexpr auto avx2 =
+                &match_char_class_repeat_avx2<PatternType, MinCount, MaxCount, Iterator, EndIterator>;
+            constexpr auto sse42 =
+                &match_char_class_repeat_sse42<PatternType, MinCount, MaxCount, Iterator, EndIterator>;
+            constexpr auto scalar =
+                &match_char_class_repeat_scalar<PatternType, MinCount, MaxCount, Iterator, EndIterator>;
+            current = dispatch_kernel<avx2, sse42, scalar>(current, last, f, count);
         }
 #else
         // Scalar fallback for non-x86 platforms
-        (void)remaining;
         current = match_char_class_repeat_scalar<PatternType, MinCount, MaxCount>(current, last, f, count);
 #endif
     }
@@ -289,7 +289,8 @@ inline Iterator match_pattern_repeat_simd(Iterator current, const EndIterator la
 #ifdef CTRE_ARCH_X86
 // AVX2 character class matching
 template <typename SetType, size_t MinCount, size_t MaxCount, typename Iterator, typename EndIterator>
-inline Iterator match_char_class_repeat_avx2(Iterator current, const EndIterator& last, const flags& f, size_t& count) {
+CTRE_TARGET_AVX2 inline Iterator match_char_class_repeat_avx2(Iterator current, const EndIterator& last, const flags& f,
+                                                              size_t& count) {
     if constexpr (!simd_pattern_trait<SetType>::is_simd_optimizable)
         return match_char_class_repeat_scalar<SetType, MinCount, MaxCount>(current, last, f, count);
 
@@ -467,8 +468,8 @@ inline Iterator match_char_class_repeat_avx2(Iterator current, const EndIterator
 
 // SSE4.2 character class matching
 template <typename SetType, size_t MinCount, size_t MaxCount, typename Iterator, typename EndIterator>
-inline Iterator match_char_class_repeat_sse42(Iterator current, const EndIterator& last, const flags& f,
-                                              size_t& count) {
+CTRE_TARGET_SSE42 inline Iterator match_char_class_repeat_sse42(Iterator current, const EndIterator& last,
+                                                                const flags& f, size_t& count) {
     if constexpr (!simd_pattern_trait<SetType>::is_simd_optimizable)
         return match_char_class_repeat_scalar<SetType, MinCount, MaxCount>(current, last, f, count);
 
@@ -550,8 +551,8 @@ inline Iterator match_char_class_repeat_sse42(Iterator current, const EndIterato
 
 // Single character AVX2
 template <char TargetChar, size_t MinCount, size_t MaxCount, typename Iterator, typename EndIterator>
-inline Iterator match_single_char_repeat_avx2(Iterator current, const EndIterator& last, const flags& f,
-                                               size_t& count) {
+CTRE_TARGET_AVX2 inline Iterator match_single_char_repeat_avx2(Iterator current, const EndIterator& last,
+                                                               const flags& f, size_t& count) {
     const bool ci = is_ascii_alpha(TargetChar) && ctre::is_case_insensitive(f);
     const __m256i target = _mm256_set1_epi8(TargetChar);
     const __m256i target_l = ci ? _mm256_set1_epi8(TargetChar | LOWERCASE_BIT) : target;
@@ -654,8 +655,8 @@ inline Iterator match_single_char_repeat_avx2(Iterator current, const EndIterato
 
 // Single character SSE4.2
 template <char TargetChar, size_t MinCount, size_t MaxCount, typename Iterator, typename EndIterator>
-inline Iterator match_single_char_repeat_sse42(Iterator current, const EndIterator& last, const flags& f,
-                                               size_t& count) {
+CTRE_TARGET_SSE42 inline Iterator match_single_char_repeat_sse42(Iterator current, const EndIterator& last,
+                                                                 const flags& f, size_t& count) {
     const bool ci = is_ascii_alpha(TargetChar) && ctre::is_case_insensitive(f);
     const __m128i target = _mm_set1_epi8(TargetChar);
     const __m128i target_l = ci ? _mm_set1_epi8(TargetChar | LOWERCASE_BIT) : target;
@@ -2,6 +2,7 @@
 #define CTRE__SIMD_DETECTION__HPP
 
 #include <cstddef>
+#include <utility>
 
 // Compile-time SIMD control
 #ifndef CTRE_DISABLE_SIMD
@@ -75,6 +76,14 @@ inline constexpr unsigned AVX2_FULL_MASK = 0xFFFFFFFFU;
 [[nodiscard]] inline bool has_avx2() noexcept {
     static const bool result = []() noexcept {
         unsigned int eax, ebx, ecx, edx;
+        // AVX code only runs once the OS saves the YMM state (OSXSAVE, XCR0 bits 1-2)
+        __asm__ __volatile__("cpuid" : "=a"(eax), "=b"(ebx), "=c"(ecx), "=d"(edx) : "a"(1), "c"(0));
+        if ((ecx & (1u << 27)) == 0 || (ecx & (1u << 28)) == 0)
+            return false;
+        unsigned int xcr0, xcr0_high;
+        __asm__ __volatile__("xgetbv" : "=a"(xcr0), "=d"(xcr0_high) : "c"(0));
+        if ((xcr0 & 0x6) != 0x6)
+            return false;
         __asm__ __volatile__("cpuid" : "=a"(eax), "=b"(ebx), "=c"(ecx), "=d"(edx) : "a"(7), "c"(0));
         return (ebx & (1 << 5)) != 0;
     }();
@@ -135,6 +144,30 @@ inline constexpr int SIMD_CAPABILITY_NEON = 4;  // ARM NEON
     return SIMD_CAPABILITY_NONE;
 }
 
+// Runtime ISA dispatch. Kernels above the baseline ISA carry a target attribute,
+// so a baseline x86-64 build still contains them; dispatch_kernel picks the
+// variant once per kernel family from cpuid and keeps it in a function-local
+// pointer. A build that targets AVX2 already calls the AVX2 variant directly.
+#if defined(CTRE_ARCH_X86) && (defined(__GNUC__) || defined(__clang__))
+#define CTRE_TARGET_AVX2 __attribute__((target("avx2")))
+#define CTRE_TARGET_SSE42 __attribute__((target("sse4.2")))
+#else
+#define CTRE_TARGET_AVX2
+#define CTRE_TARGET_SSE42
+#endif
+
+template <auto Avx2, auto Sse42, auto Scalar, typename... Args>
+inline decltype(auto) dispatch_kernel(Args&&... args) {
+#if defined(CTRE_ARCH_X86) && !defined(__AVX2__)
+    static const auto kernel = has_avx2() ? Avx2 : has_sse42() ? Sse42 : Scalar;
+    return kernel(std::forward<Args>(args)...);
+#elif defined(CTRE_ARCH_X86)
+    return Avx2(std::forward<Args>(args)...);
+#else
+    return Scalar(std::forward<Args>(args)...);
+#endif
+}
+
 // Optimization thresholds (bytes)
 inline constexpr std::size_t SIMD_STRING_THRESHOLD = 16;
 inline constexpr std::size_t SIMD_REPETITION_THRESHOLD = 32;
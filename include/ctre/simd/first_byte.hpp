@@ -0,0 +1,207 @@
+#ifndef CTRE__SIMD_FIRST_BYTE__HPP
+#define CTRE__SIMD_FIRST_BYTE__HPP
+
+#include "../first.hpp"
+#include "detection.hpp"
+#include "multirange.hpp"
+#include "shufti.hpp"
+#include "wide_classes.hpp"
+#include <array>
+#include <cstdint>
+#include <cstring>
+#ifdef CTRE_ARCH_X86
+#include <immintrin.h>
+#endif
+
+// First-byte skip loop for search: the first set of the pattern (first.hpp) becomes
+// a 256-entry byte table, and search only runs evaluate where the byte under the
+// cursor is in it. Candidates are found with memchr (one byte), a range compare
+// (one contiguous range) or shufti (anything else).
+
+namespace ctre::simd {
+
+// Byte sets larger than this reject too few positions to pay for the scan
+inline constexpr size_t FIRST_BYTE_MAX_COUNT = 128;
+
+// Atoms whose bytes are known exactly; anything else (unicode properties, any) is
+// treated as matching every byte
+template <typename T> struct first_byte_exact : std::false_type {};
+template <auto V> struct first_byte_exact<character<V>> : std::true_type {};
+template <auto A, auto B> struct first_byte_exact<char_range<A, B>> : std::true_type {};
+template <typename... Content> struct first_byte_exact<set<Content...>> : std::bool_constant<(first_byte_exact<Content>::value && ...)> {};
+template <typename... Content> struct first_byte_exact<negative_set<Content...>> : std::bool_constant<(first_byte_exact<Content>::value && ...)> {};
+
+// $ consumes nothing and first() stops at it, yet it can match right before a '\n'
+template <typename T> struct has_line_end : std::false_type {};
+template <> struct has_line_end<assert_line_end> : std::true_type {};
+template <> struct has_line_end<assert_subject_end_line> : std::true_type {};
+template <typename... Content> struct has_line_end<sequence<Content...>> : std::bool_constant<(has_line_end<Content>::value || ...)> {};
+template <typename... Content> struct has_line_end<select<Content...>> : std::bool_constant<(has_line_end<Content>::value || ...)> {};
+template <typename... Content> struct has_line_end<atomic_group<Content...>> : std::bool_constant<(has_line_end<Content>::value || ...)> {};
+template <size_t Index, typename... Content> struct has_line_end<capture<Index, Content...>> : std::bool_constant<(has_line_end<Content>::value || ...)> {};
+template <size_t Index, typename Name, typename... Content> struct has_line_end<capture_with_name<Index, Name, Content...>> : std::bool_constant<(has_line_end<Content>::value || ...)> {};
+template <size_t A, size_t B, typename... Content> struct has_line_end<repeat<A, B, Content...>> : std::bool_constant<(has_line_end<Content>::value || ...)> {};
+template <size_t A, size_t B, typename... Content> struct has_line_end<lazy_repeat<A, B, Content...>> : std::bool_constant<(has_line_end<Content>::value || ...)> {};
+template <size_t A, size_t B, typename... Content> struct has_line_end<possessive_repeat<A, B, Content...>> : std::bool_constant<(has_line_end<Content>::value || ...)> {};
+
+struct first_byte_set {
+    std::array<bool, 256> bytes{};
+    size_t count = 0;
+    bool usable = false;
+    // Set when the bytes form one range [low, high]
+    bool contiguous = false;
+    unsigned char low = 0;
+    unsigned char high = 0;
+    character_class shufti{};
+};
+
+template <typename... Content>
+constexpr bool add_first_bytes(first_byte_set& out, ctll::list<Content...>) noexcept {
+    if constexpr (!(first_byte_exact<Content>::value && ...)) {
+        return false;
+    } else {
+        for (size_t b = 0; b < 256; ++b) {
+            const char c = static_cast<char>(b);
+            out.bytes[b] = out.bytes[b] || (Content::match_char(c, flags{}) || ... || false);
+        }
+        return true;
+    }
+}
+
+// Bytes a match of RE can start with. Not usable when that is unknown or when RE can
+// match the empty string: the sentinel `any` after RE is only reached through a
+// path consuming nothing, and turns the set into can_be_anything
+template <typename RE>
+[[nodiscard]] constexpr first_byte_set make_first_byte_set() noexcept {
+    first_byte_set out;
+    if (!add_first_bytes(out, calculate_first(RE{}, any{}))) return out;
+    if constexpr (has_line_end<RE>::value) out.bytes['\n'] = true;
+
+    for (size_t b = 0; b < 256; ++b) {
+        if (!out.bytes[b]) continue;
+        if (out.count == 0) out.low = static_cast<unsigned char>(b);
+        out.high = static_cast<unsigned char>(b);
+        ++out.count;
+    }
+    out.usable = out.count != 0 && out.count <= FIRST_BYTE_MAX_COUNT;
+    out.contiguous = out.count == static_cast<size_t>(out.high - out.low) + 1;
+    out.shufti.init_from_predicate([&](int b) { return out.bytes[static_cast<size_t>(b)]; });
+    return out;
+}
+
+template <typename RE> inline constexpr first_byte_set first_byte_set_v = make_first_byte_set<RE>();
+
+[[nodiscard]] inline const char* first_byte_find_scalar(const first_byte_set& s, const char* begin,
+                                                        const char* end) noexcept {
+    for (const char* p = begin; p != end; ++p)
+        if (s.bytes[static_cast<unsigned char>(*p)]) return p;
+    return end;
+}
+
+#ifdef CTRE_ARCH_X86
+[[nodiscard]] CTRE_TARGET_SSE42 inline const char* first_byte_find_range_sse(const first_byte_set& s, const char* begin,
+                                                                             const char* end) noexcept {
+    const char* p = begin;
+    for (; end - p >= 16; p += 16) {
+        const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        const auto hits = static_cast<uint32_t>(_mm_movemask_epi8(check_range_sse(data, s.low, s.high)));
+        if (hits) return p + CTRE_CTZ(hits);
+    }
+    return first_byte_find_scalar(s, p, end);
+}
+
+// Single shufti: the nibble tables over-approximate the set, the table settles it
+[[nodiscard]] CTRE_TARGET_SSE42 inline const char* first_byte_find_shufti_ssse3(const first_byte_set& s,
+                                                                                const char* begin,
+                                                                                const char* end) noexcept {
+    const __m128i upper = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s.shufti.upper_nibble_table.data()));
+    const __m128i lower = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s.shufti.lower_nibble_table.data()));
+    const __m128i nibble = _mm_set1_epi8(0x0F);
+    const char* p = begin;
+    for (; end - p >= 16; p += 16) {
+        const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        const __m128i hi = _mm_shuffle_epi8(upper, _mm_and_si128(_mm_srli_epi16(data, 4), nibble));
+        const __m128i lo = _mm_shuffle_epi8(lower, _mm_and_si128(data, nibble));
+        auto hits = static_cast<uint32_t>(_mm_movemask_epi8(_mm_and_si128(hi, lo)));
+        while (hits) {
+            const auto k = static_cast<size_t>(CTRE_CTZ(hits));
+            if (s.bytes[static_cast<unsigned char>(p[k])]) return p + k;
+            hits &= hits - 1;
+        }
+    }
+    return first_byte_find_scalar(s, p, end);
+}
+
+[[nodiscard]] CTRE_TARGET_SSE42 inline const char* first_byte_find_sse42(const first_byte_set& s, const char* begin,
+                                                                         const char* end) noexcept {
+    if (s.contiguous) return first_byte_find_range_sse(s, begin, end);
+    return first_byte_find_shufti_ssse3(s, begin, end);
+}
+
+[[nodiscard]] CTRE_TARGET_AVX2 inline const char* first_byte_find_range_avx2(const first_byte_set& s, const char* begin,
+                                                                             const char* end) noexcept {
+    const char* p = begin;
+    for (; end - p >= 32; p += 32) {
+        const __m256i data = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        const auto hits = static_cast<uint32_t>(_mm256_movemask_epi8(check_range_avx2(data, s.low, s.high)));
+        if (hits) return p + CTRE_CTZ(hits);
+    }
+    return first_byte_find_range_sse(s, p, end);
+}
+
+[[nodiscard]] CTRE_TARGET_AVX2 inline const char* first_byte_find_avx2(const first_byte_set& s, const char* begin,
+                                                                       const char* end) noexcept {
+    if (s.contiguous) return first_byte_find_range_avx2(s, begin, end);
+    // shufti reports the position after the hit
+    const unsigned char* out = nullptr;
+    return shufti_find_avx2_single(reinterpret_cast<const unsigned char*>(begin),
+                                   reinterpret_cast<const unsigned char*>(end), s.shufti, out)
+               ? reinterpret_cast<const char*>(out) - 1
+               : end;
+}
+#else
+[[nodiscard]] inline const char* first_byte_find_sse42(const first_byte_set& s, const char* begin,
+                                                       const char* end) noexcept {
+    return first_byte_find_scalar(s, begin, end);
+}
+
+[[nodiscard]] inline const char* first_byte_find_avx2(const first_byte_set& s, const char* begin,
+                                                      const char* end) noexcept {
+    return first_byte_find_scalar(s, begin, end);
+}
+#endif // CTRE_ARCH_X86
+
+// First position in [begin, end) holding a byte of the set, or end
+[[nodiscard]] inline const char* first_byte_find(const first_byte_set& s, const char* begin, const char* end) noexcept {
+    if (begin == end) return end;
+    if (s.count == 1) {
+        const void* hit = std::memchr(begin, s.low, static_cast<size_t>(end - begin));
+        return hit ? static_cast<const char*>(hit) : end;
+    }
+    if (end - begin < 16) return first_byte_find_scalar(s, begin, end);
+    return dispatch_kernel<&first_byte_find_avx2, &first_byte_find_sse42, &first_byte_find_scalar>(s, begin, end);
+}
+
+// Wide subjects: the first set as code unit ranges, searched with wide_class_find
+template <typename CharT, typename... Content>
+constexpr bool add_wide_first(wide_class& out, ctll::list<Content...>) noexcept {
+    constexpr int64_t lane_max = std::numeric_limits<wide_lane_t<CharT>>::max();
+    return (add_wide_class(out, lane_max, false, static_cast<Content*>(nullptr)) && ... && true);
+}
+
+template <typename RE, typename CharT>
+[[nodiscard]] constexpr wide_class make_wide_first_class() noexcept {
+    wide_class out;
+    if (!add_wide_first<CharT>(out, calculate_first(RE{}, any{}))) return {};
+    if constexpr (has_line_end<RE>::value) {
+        if (!out.add('\n', '\n', std::numeric_limits<wide_lane_t<CharT>>::max())) return {};
+    }
+    out.usable = out.count != 0;
+    return out;
+}
+
+template <typename RE, typename CharT> inline constexpr wide_class wide_first_class_v = make_wide_first_class<RE, CharT>();
+
+} // namespace ctre::simd
+
+#endif // CTRE__SIMD_FIRST_BYTE__HPP
@@ -1,6 +1,7 @@
 #ifndef CTRE__SIMD_LITERAL_SEARCH__HPP
 #define CTRE__SIMD_LITERAL_SEARCH__HPP
 
+#include "byte_frequency.hpp"
 #include "detection.hpp"
 #include <cstring>
 
@@ -8,103 +9,221 @@
 #include <immintrin.h>
 #endif
 
+// Candidates are positions holding the literal's two rarest bytes (see
+// byte_frequency.hpp) at their offsets, then the whole literal is compared.
+
 namespace ctre::simd {
 
-template <size_t LiteralLen>
+template <size_t LiteralLen, typename Frequency = CTRE_BYTE_FREQUENCY>
 [[nodiscard]] inline bool search_literal_scalar(const char* begin, const char* end,
                                                  const char (&literal)[LiteralLen]) noexcept {
     const size_t len = LiteralLen - 1;
     if (len == 0) return true;
     const char* search_end = end - len + 1;
     if (begin >= search_end) return false;
-    const char first = literal[0];
+    const auto [rarest, second] = rare_bytes<Frequency>(literal, len);
     for (const char* ptr = begin; ptr < search_end; ++ptr) {
-        if (*ptr == first) {
-            bool match = true;
-            for (size_t i = 1; i < len; ++i)
-                if (ptr[i] != literal[i]) { match = false; break; }
-            if (match) return true;
-        }
+        const void* hit = std::memchr(ptr + rarest, literal[rarest], static_cast<size_t>(search_end - ptr));
+        if (hit == nullptr) return false;
+        ptr = static_cast<const char*>(hit) - rarest;
+        if (ptr[second] == literal[second] && std::memcmp(ptr, literal, len) == 0) return true;
     }
     return false;
 }
 
-#if CTRE_SIMD_ENABLED && defined(__AVX2__)
-template <size_t LiteralLen>
-[[nodiscard]] inline bool search_literal_avx2(const char* begin, const char* end,
-                                               const char (&literal)[LiteralLen]) noexcept {
+#if CTRE_SIMD_ENABLED && defined(CTRE_ARCH_X86)
+// Both loads stay within [begin, end) for every chunk starting below search_end
+template <size_t LiteralLen, typename Frequency = CTRE_BYTE_FREQUENCY>
+[[nodiscard]] CTRE_TARGET_SSE42 inline bool search_literal_sse42(const char* begin, const char* end,
+                                                                 const char (&literal)[LiteralLen]) noexcept {
     const size_t len = LiteralLen - 1;
     if (len == 0) return true;
     const char* search_end = end - len + 1;
     if (begin >= search_end) return false;
 
-    __m256i first_char = _mm256_set1_epi8(literal[0]);
+    const auto [rarest, second] = rare_bytes<Frequency>(literal, len);
+    const __m128i rare1 = _mm_set1_epi8(literal[rarest]);
+    const __m128i rare2 = _mm_set1_epi8(literal[second]);
+    const char* ptr = begin;
+
+    while (ptr + 16 <= search_end) {
+        __m128i at1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr + rarest));
+        __m128i at2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr + second));
+        int mask = _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(at1, rare1), _mm_cmpeq_epi8(at2, rare2)));
+        while (mask != 0) {
+            if (std::memcmp(ptr + CTRE_CTZ(mask), literal, len) == 0) return true;
+            mask &= mask - 1;
+        }
+        ptr += 16;
+    }
+    return search_literal_scalar<LiteralLen, Frequency>(ptr, end, literal);
+}
+
+template <size_t LiteralLen, typename Frequency = CTRE_BYTE_FREQUENCY>
+[[nodiscard]] CTRE_TARGET_AVX2 inline bool search_literal_avx2(const char* begin, const char* end,
+                                                               const char (&literal)[LiteralLen]) noexcept {
+    const size_t len = LiteralLen - 1;
+    if (len == 0) return true;
+    const char* search_end = end - len + 1;
+    if (begin >= search_end) return false;
+    if (search_end - begin < 32) return search_literal_sse42<LiteralLen, Frequency>(begin, end, literal);
+
+    const auto [rarest, second] = rare_bytes<Frequency>(literal, len);
+    const __m256i rare1 = _mm256_set1_epi8(literal[rarest]);
+    const __m256i rare2 = _mm256_set1_epi8(literal[second]);
     const char* ptr = begin;
 
     while (ptr + 32 <= search_end) {
-        __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr));
-        int mask = _mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, first_char));
+        __m256i at1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr + rarest));
+        __m256i at2 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr + second));
+        uint32_t mask = static_cast<uint32_t>(
+            _mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(at1, rare1), _mm256_cmpeq_epi8(at2, rare2))));
         while (mask != 0) {
-            int pos = CTRE_CTZ(mask);
-            if (std::memcmp(ptr + pos, literal, len) == 0) return true;
+            if (std::memcmp(ptr + CTRE_CTZ(mask), literal, len) == 0) return true;
             mask &= mask - 1;
         }
         ptr += 32;
     }
+    return search_literal_sse42<LiteralLen, Frequency>(ptr, end, literal);
+}
+
+#else
+template <size_t LiteralLen, typename Frequency = CTRE_BYTE_FREQUENCY>
+[[nodiscard]] inline bool search_literal_sse42(const char* begin, const char* end,
+                                                const char (&literal)[LiteralLen]) noexcept {
+    return search_literal_scalar<LiteralLen, Frequency>(begin, end, literal);
+}
+
+template <size_t LiteralLen, typename Frequency = CTRE_BYTE_FREQUENCY>
+[[nodiscard]] inline bool search_literal_avx2(const char* begin, const char* end,
+                                               const char (&literal)[LiteralLen]) noexcept {
+    return search_literal_scalar<LiteralLen, Frequency>(begin, end, literal);
+}
+#endif
 
-    while (ptr < search_end) {
-        if (*ptr == literal[0] && std::memcmp(ptr, literal, len) == 0) return true;
-        ++ptr;
+template <size_t LiteralLen, typename Frequency = CTRE_BYTE_FREQUENCY>
+[[nodiscard]] inline bool search_literal(const char* begin, const char* end,
+                                          const char (&literal)[LiteralLen]) noexcept {
+    if (end - begin < 16) return search_literal_scalar<LiteralLen, Frequency>(begin, end, literal);
+    return dispatch_kernel<&search_literal_avx2<LiteralLen, Frequency>, &search_literal_sse42<LiteralLen, Frequency>,
+                           &search_literal_scalar<LiteralLen, Frequency>>(begin, end, literal);
+}
+
+// Case-insensitive literal search: LOWERCASE_BIT is OR-ed into the alphabetic literal
+// positions and into the input bytes compared with them, folding 'A'-'Z' onto 'a'-'z'
+[[nodiscard]] constexpr char case_fold_bit(char c) noexcept {
+    const char folded = static_cast<char>(c | LOWERCASE_BIT);
+    return (folded >= 'a' && folded <= 'z') ? static_cast<char>(LOWERCASE_BIT) : char{0};
+}
+
+[[nodiscard]] inline bool equal_caseless(const char* s, const char* literal, size_t len) noexcept {
+    for (size_t i = 0; i < len; ++i) {
+        const char fold = case_fold_bit(literal[i]);
+        if ((s[i] | fold) != (literal[i] | fold)) return false;
+    }
+    return true;
+}
+
+template <size_t LiteralLen, typename Frequency = CTRE_BYTE_FREQUENCY>
+[[nodiscard]] inline bool search_literal_caseless_scalar(const char* begin, const char* end,
+                                                          const char (&literal)[LiteralLen]) noexcept {
+    const size_t len = LiteralLen - 1;
+    if (len == 0) return true;
+    const char* search_end = end - len + 1;
+    if (begin >= search_end) return false;
+    const size_t rarest = rare_bytes<Frequency>(literal, len, true).rarest;
+    const char fold = case_fold_bit(literal[rarest]);
+    const char rare = static_cast<char>(literal[rarest] | fold);
+    for (const char* ptr = begin; ptr < search_end; ++ptr) {
+        if ((ptr[rarest] | fold) == rare && equal_caseless(ptr, literal, len)) return true;
     }
     return false;
 }
-#endif
 
-#if CTRE_SIMD_ENABLED && defined(__SSE4_2__)
-template <size_t LiteralLen>
-[[nodiscard]] inline bool search_literal_sse42(const char* begin, const char* end,
-                                                const char (&literal)[LiteralLen]) noexcept {
+#if CTRE_SIMD_ENABLED && defined(CTRE_ARCH_X86)
+template <size_t LiteralLen, typename Frequency = CTRE_BYTE_FREQUENCY>
+[[nodiscard]] CTRE_TARGET_SSE42 inline bool search_literal_caseless_sse42(const char* begin, const char* end,
+                                                                          const char (&literal)[LiteralLen]) noexcept {
     const size_t len = LiteralLen - 1;
     if (len == 0) return true;
     const char* search_end = end - len + 1;
     if (begin >= search_end) return false;
-    if (len > 16) return search_literal_scalar(begin, end, literal);
 
-    __m128i pattern = _mm_setzero_si128();
-    std::memcpy(&pattern, literal, len);
+    const auto [rarest, second] = rare_bytes<Frequency>(literal, len, true);
+    const char fold1 = case_fold_bit(literal[rarest]);
+    const char fold2 = case_fold_bit(literal[second]);
+    const __m128i bit1 = _mm_set1_epi8(fold1);
+    const __m128i bit2 = _mm_set1_epi8(fold2);
+    const __m128i rare1 = _mm_set1_epi8(static_cast<char>(literal[rarest] | fold1));
+    const __m128i rare2 = _mm_set1_epi8(static_cast<char>(literal[second] | fold2));
     const char* ptr = begin;
 
     while (ptr + 16 <= search_end) {
-        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr));
-        int idx = _mm_cmpistri(pattern, chunk, 0x0C);
-        if (idx < 16 && ptr + idx + len <= end && std::memcmp(ptr + idx, literal, len) == 0)
-            return true;
+        __m128i at1 = _mm_or_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr + rarest)), bit1);
+        __m128i at2 = _mm_or_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr + second)), bit2);
+        int mask = _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(at1, rare1), _mm_cmpeq_epi8(at2, rare2)));
+        while (mask != 0) {
+            if (equal_caseless(ptr + CTRE_CTZ(mask), literal, len)) return true;
+            mask &= mask - 1;
+        }
         ptr += 16;
     }
+    return search_literal_caseless_scalar<LiteralLen, Frequency>(ptr, end, literal);
+}
+
+template <size_t LiteralLen, typename Frequency = CTRE_BYTE_FREQUENCY>
+[[nodiscard]] CTRE_TARGET_AVX2 inline bool search_literal_caseless_avx2(const char* begin, const char* end,
+                                                                        const char (&literal)[LiteralLen]) noexcept {
+    const size_t len = LiteralLen - 1;
+    if (len == 0) return true;
+    const char* search_end = end - len + 1;
+    if (begin >= search_end) return false;
+    if (search_end - begin < 32) return search_literal_caseless_sse42<LiteralLen, Frequency>(begin, end, literal);
+
+    const auto [rarest, second] = rare_bytes<Frequency>(literal, len, true);
+    const char fold1 = case_fold_bit(literal[rarest]);
+    const char fold2 = case_fold_bit(literal[second]);
+    const __m256i bit1 = _mm256_set1_epi8(fold1);
+    const __m256i bit2 = _mm256_set1_epi8(fold2);
+    const __m256i rare1 = _mm256_set1_epi8(static_cast<char>(literal[rarest] | fold1));
+    const __m256i rare2 = _mm256_set1_epi8(static_cast<char>(literal[second] | fold2));
+    const char* ptr = begin;
 
-    while (ptr < search_end) {
-        if (std::memcmp(ptr, literal, len) == 0) return true;
-        ++ptr;
+    while (ptr + 32 <= search_end) {
+        __m256i at1 = _mm256_or_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr + rarest)), bit1);
+        __m256i at2 = _mm256_or_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr + second)), bit2);
+        uint32_t mask = static_cast<uint32_t>(
+            _mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(at1, rare1), _mm256_cmpeq_epi8(at2, rare2))));
+        while (mask != 0) {
+            if (equal_caseless(ptr + CTRE_CTZ(mask), literal, len)) return true;
+            mask &= mask - 1;
+        }
+        ptr += 32;
     }
-    return false;
+    return search_literal_caseless_sse42<LiteralLen, Frequency>(ptr, end, literal);
 }
-#endif
 
-template <size_t LiteralLen>
-[[nodiscard]] inline bool search_literal(const char* begin, const char* end,
-                                          const char (&literal)[LiteralLen]) noexcept {
-#if CTRE_SIMD_ENABLED
-    [[maybe_unused]] const size_t input_size = end - begin;
-#ifdef __AVX2__
-    if (input_size >= 32 && get_simd_capability() >= SIMD_CAPABILITY_AVX2)
-        return search_literal_avx2(begin, end, literal);
-#endif
-#ifdef __SSE4_2__
-    if (input_size >= 16 && LiteralLen <= 17 && get_simd_capability() >= SIMD_CAPABILITY_SSE42)
-        return search_literal_sse42(begin, end, literal);
-#endif
+#else
+template <size_t LiteralLen, typename Frequency = CTRE_BYTE_FREQUENCY>
+[[nodiscard]] inline bool search_literal_caseless_sse42(const char* begin, const char* end,
+                                                         const char (&literal)[LiteralLen]) noexcept {
+    return search_literal_caseless_scalar<LiteralLen, Frequency>(begin, end, literal);
+}
+
+template <size_t LiteralLen, typename Frequency = CTRE_BYTE_FREQUENCY>
+[[nodiscard]] inline bool search_literal_caseless_avx2(const char* begin, const char* end,
+                                                        const char (&literal)[LiteralLen]) noexcept {
+    return search_literal_caseless_scalar<LiteralLen, Frequency>(begin, end, literal);
+}
 #endif
-    return search_literal_scalar(begin, end, literal);
+
+template <size_t LiteralLen, typename Frequency = CTRE_BYTE_FREQUENCY>
+[[nodiscard]] inline bool search_literal_caseless(const char* begin, const char* end,
+                                                   const char (&literal)[LiteralLen]) noexcept {
+    if (end - begin < 16) return search_literal_caseless_scalar<LiteralLen, Frequency>(begin, end, literal);
+    return dispatch_kernel<&search_literal_caseless_avx2<LiteralLen, Frequency>,
+                           &search_literal_caseless_sse42<LiteralLen, Frequency>,
+                           &search_literal_caseless_scalar<LiteralLen, Frequency>>(begin, end, literal);
 }
 
 template <char... Chars>
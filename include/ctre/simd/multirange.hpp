@@ -76,14 +76,16 @@ struct is_three_range<set<R...>>
 
 #ifdef CTRE_ARCH_X86
 // Range check helpers
-[[nodiscard]] inline __m256i check_range_avx2(__m256i data, unsigned char min_c, unsigned char max_c) noexcept {
+[[nodiscard]] CTRE_TARGET_AVX2 inline __m256i check_range_avx2(__m256i data, unsigned char min_c,
+                                                               unsigned char max_c) noexcept {
     __m256i min_vec = _mm256_set1_epi8(static_cast<char>(min_c));
     __m256i adjusted = _mm256_sub_epi8(data, min_vec);
     __m256i width = _mm256_set1_epi8(static_cast<char>(max_c - min_c));
     return _mm256_cmpeq_epi8(_mm256_min_epu8(adjusted, width), adjusted);
 }
 
-[[nodiscard]] inline __m128i check_range_sse(__m128i data, unsigned char min_c, unsigned char max_c) noexcept {
+[[nodiscard]] CTRE_TARGET_SSE42 inline __m128i check_range_sse(__m128i data, unsigned char min_c,
+                                                               unsigned char max_c) noexcept {
     __m128i min_vec = _mm_set1_epi8(static_cast<char>(min_c));
     __m128i adjusted = _mm_sub_epi8(data, min_vec);
     __m128i width = _mm_set1_epi8(static_cast<char>(max_c - min_c));
@@ -92,8 +94,8 @@ struct is_three_range<set<R...>>
 
 // SSE implementation
 template <typename PatternType, size_t... Is, typename Iterator, typename EndIterator>
-[[nodiscard]] inline Iterator match_n_range_sse_impl(Iterator current, EndIterator last, size_t& count,
-                                                     std::index_sequence<Is...>) noexcept {
+[[nodiscard]] CTRE_TARGET_SSE42 inline Iterator match_n_range_sse_impl(Iterator current, EndIterator last,
+                                                                       size_t& count, std::index_sequence<Is...>) noexcept {
     while (has_at_least_bytes(current, last, 16)) {
         __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&*current));
         __m128i result = _mm_setzero_si128();
@@ -118,15 +120,16 @@ template <typename PatternType, size_t... Is, typename Iterator, typename EndIte
 }
 
 template <typename PatternType, typename Iterator, typename EndIterator>
-[[nodiscard]] inline Iterator match_n_range_sse(Iterator current, EndIterator last, size_t& count) noexcept {
+[[nodiscard]] CTRE_TARGET_SSE42 inline Iterator match_n_range_sse(Iterator current, EndIterator last,
+                                                                  size_t& count) noexcept {
     return match_n_range_sse_impl<PatternType>(current, last, count,
                                                std::make_index_sequence<is_multi_range<PatternType>::num_ranges>{});
 }
 
 // AVX2 implementation
 template <typename PatternType, size_t... Is, typename Iterator, typename EndIterator>
-[[nodiscard]] inline Iterator match_n_range_avx2_impl(Iterator current, EndIterator last, size_t& count,
-                                                      std::index_sequence<Is...>) noexcept {
+[[nodiscard]] CTRE_TARGET_AVX2 inline Iterator match_n_range_avx2_impl(Iterator current, EndIterator last,
+                                                                       size_t& count, std::index_sequence<Is...>) noexcept {
     while (has_at_least_bytes(current, last, 32)) {
         __m256i data = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&*current));
         __m256i result = _mm256_setzero_si256();
@@ -151,7 +154,11 @@ template <typename PatternType, size_t... Is, typename Iterator, typename EndIte
 }
 
 template <typename PatternType, typename Iterator, typename EndIterator>
-[[nodiscard]] inline Iterator match_n_range_avx2(Iterator current, EndIterator last, size_t& count) noexcept {
+[[nodiscard]] CTRE_TARGET_AVX2 inline Iterator match_n_range_avx2(Iterator current, EndIterator last,
+                                                                  size_t& count) noexcept {
+    // Below one AVX2 vector the SSE loop still covers 16 bytes at a time
+    if (!has_at_least_bytes(current, last, 32))
+        return match_n_range_sse<PatternType>(current, last, count);
     return match_n_range_avx2_impl<PatternType>(current, last, count,
                                                 std::make_index_sequence<is_multi_range<PatternType>::num_ranges>{});
 }
@@ -167,6 +174,11 @@ template <typename PatternType, typename Iterator, typename EndIterator>
 }
 #endif // CTRE_ARCH_X86
 
+template <typename PatternType, typename Iterator, typename EndIterator>
+[[nodiscard]] inline Iterator match_n_range_scalar(Iterator current, EndIterator, size_t&) noexcept {
+    return current;
+}
+
 // Scalar range check using fold expression
 template <typename PatternType, size_t... Is>
 [[nodiscard]] constexpr bool matches_any_range(char ch, std::index_sequence<Is...>) noexcept {
@@ -183,16 +195,11 @@ template <typename PatternType, size_t MinCount, size_t MaxCount, typename Itera
     size_t count = 0;
 
     if constexpr (is_valid_multi_range_v<PatternType> && can_use_simd()) {
-        auto remaining = last - current;
-#ifdef __AVX2__
-        if (remaining >= 16 && remaining < 32)
-            current = match_n_range_sse<PatternType>(current, last, count);
-        else if (remaining >= 32)
-            current = match_n_range_avx2<PatternType>(current, last, count);
-#elif defined(__SSE4_2__) || defined(__SSE2__)
-        if (remaining >= 16)
-            current = match_n_range_sse<PatternType>(current, last, count);
-#endif
+        if (last - current >= 16) {
+            current = dispatch_kernel<&match_n_range_avx2<PatternType, Iterator, EndIterator>,
+                                      &match_n_range_sse<PatternType, Iterator, EndIterator>,
+                                      &match_n_range_scalar<PatternType, Iterator, EndIterator>>(current, last, count);
+        }
     }
 
     // Scalar tail using fold expression
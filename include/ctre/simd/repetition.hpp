@@ -33,6 +33,64 @@ template <typename CharacterType, size_t MinCount, size_t MaxCount, typename Ite
     return (count >= MinCount) ? current : start;
 }
 
+// Run of target_char (any case when ci) from current, count advanced by the
+// whole vectors consumed; the caller finishes the run byte by byte
+template <size_t MaxCount, typename Iterator, typename EndIterator>
+[[nodiscard]] inline Iterator char_run_scalar(Iterator current, EndIterator, size_t&, char, bool) noexcept {
+    return current;
+}
+
+#ifdef CTRE_ARCH_X86
+template <size_t MaxCount, typename Iterator, typename EndIterator>
+[[nodiscard]] CTRE_TARGET_SSE42 inline Iterator char_run_sse42(Iterator current, EndIterator last, size_t& count,
+                                                               char target_char, bool ci) noexcept {
+    // Check that we have at least 16 bytes available before SIMD load
+    while (has_at_least_bytes(current, last, 16) && (MaxCount == 0 || count + 16 <= MaxCount)) {
+        __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&*current));
+        __m128i result;
+        if (ci) {
+            __m128i t = _mm_set1_epi8(target_char | LOWERCASE_BIT);
+            result = _mm_cmpeq_epi8(_mm_or_si128(data, _mm_set1_epi8(LOWERCASE_BIT)), t);
+        } else {
+            result = _mm_cmpeq_epi8(data, _mm_set1_epi8(target_char));
+        }
+        int mask = _mm_movemask_epi8(result);
+        if (static_cast<unsigned>(mask) == SSE_FULL_MASK) { current += 16; count += 16; }
+        else { int m = CTRE_CTZ(~static_cast<unsigned>(mask)); current += m; count += m; break; }
+    }
+    return current;
+}
+
+template <size_t MaxCount, typename Iterator, typename EndIterator>
+[[nodiscard]] CTRE_TARGET_AVX2 inline Iterator char_run_avx2(Iterator current, EndIterator last, size_t& count,
+                                                             char target_char, bool ci) noexcept {
+    // Check that we have at least 32 bytes available before SIMD load
+    while (has_at_least_bytes(current, last, 32) && (MaxCount == 0 || count + 32 <= MaxCount)) {
+        __m256i data = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&*current));
+        __m256i result;
+        if (ci) {
+            __m256i t = _mm256_set1_epi8(target_char | LOWERCASE_BIT);
+            result = _mm256_cmpeq_epi8(_mm256_or_si256(data, _mm256_set1_epi8(LOWERCASE_BIT)), t);
+        } else {
+            result = _mm256_cmpeq_epi8(data, _mm256_set1_epi8(target_char));
+        }
+        int mask = _mm256_movemask_epi8(result);
+        if (static_cast<unsigned>(mask) == AVX2_FULL_MASK) { current += 32; count += 32; }
+        else { int m = CTRE_CTZ(~static_cast<unsigned>(mask)); current += m; count += m; break; }
+    }
+    return current;
+}
+#else
+template <size_t MaxCount, typename Iterator, typename EndIterator>
+[[nodiscard]] inline Iterator char_run_sse42(Iterator current, EndIterator, size_t&, char, bool) noexcept {
+    return current;
+}
+template <size_t MaxCount, typename Iterator, typename EndIterator>
+[[nodiscard]] inline Iterator char_run_avx2(Iterator current, EndIterator, size_t&, char, bool) noexcept {
+    return current;
+}
+#endif // CTRE_ARCH_X86
+
 template <size_t MinCount, size_t MaxCount, typename Iterator, typename EndIterator>
 [[nodiscard]] inline Iterator match_character_repeat_simd_with_char(Iterator current, EndIterator last,
                                                                      const flags& f, char target_char) noexcept {
@@ -41,37 +99,12 @@ template <size_t MinCount, size_t MaxCount, typename Iterator, typename EndItera
     const bool ci = is_ascii_alpha(target_char) && is_case_insensitive(f);
 
     if constexpr (CTRE_SIMD_ENABLED) {
-#ifdef __AVX2__
-        // Check that we have at least 32 bytes available before SIMD load
-        while (has_at_least_bytes(current, last, 32) && (MaxCount == 0 || count + 32 <= MaxCount)) {
-            __m256i data = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&*current));
-            __m256i result;
-            if (ci) {
-                __m256i t = _mm256_set1_epi8(target_char | LOWERCASE_BIT);
-                result = _mm256_cmpeq_epi8(_mm256_or_si256(data, _mm256_set1_epi8(LOWERCASE_BIT)), t);
-            } else {
-                result = _mm256_cmpeq_epi8(data, _mm256_set1_epi8(target_char));
-            }
-            int mask = _mm256_movemask_epi8(result);
-            if (static_cast<unsigned>(mask) == AVX2_FULL_MASK) { current += 32; count += 32; }
-            else { int m = CTRE_CTZ(~static_cast<unsigned>(mask)); current += m; count += m; break; }
-        }
-#elif defined(__SSE4_2__) || defined(__SSE2__)
-        // Check that we have at least 16 bytes available before SIMD load
-        while (has_at_least_bytes(current, last, 16) && (MaxCount == 0 || count + 16 <= MaxCount)) {
-            __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&*current));
-            __m128i result;
-            if (ci) {
-                __m128i t = _mm_set1_epi8(target_char | LOWERCASE_BIT);
-                result = _mm_cmpeq_epi8(_mm_or_si128(data, _mm_set1_epi8(LOWERCASE_BIT)), t);
-            } else {
-                result = _mm_cmpeq_epi8(data, _mm_set1_epi8(target_char));
-            }
-            int mask = _mm_movemask_epi8(result);
-            if (static_cast<unsigned>(mask) == SSE_FULL_MASK) { current += 16; count += 16; }
-            else { int m = CTRE_CTZ(~static_cast<unsigned>(mask)); current += m; count += m; break; }
+        if (has_at_least_bytes(current, last, 16)) {
+            current = dispatch_kernel<&char_run_avx2<MaxCount, Iterator, EndIterator>,
+                                      &char_run_sse42<MaxCount, Iterator, EndIterator>,
+                                      &char_run_scalar<MaxCount, Iterator, EndIterator>>(current, last, count,
+                                                                                          target_char, ci);
         }
-#endif
     }
 
     while (current != last && (MaxCount == 0 || count < MaxCount)) {
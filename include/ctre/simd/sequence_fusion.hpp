@@ -99,6 +99,47 @@ template <size_t Id, typename... Content> struct segment_info<capture<Id, Conten
     static constexpr std::array<CharRange, 1> ranges = {CharRange()};
 };
 
+// A literal character or a class run with a single repeat count
+template <typename T>
+inline constexpr bool is_fixed_segment =
+    segment_info<T>::is_literal || (segment_info<T>::is_char_class && !segment_info<T>::is_unbounded &&
+                                    segment_info<T>::min_len == segment_info<T>::max_len && segment_info<T>::min_len > 0);
+
+template <typename Info> [[nodiscard]] constexpr bool segment_accepts(char c) noexcept {
+    if constexpr (Info::is_literal) {
+        return c == Info::literal_char;
+    } else {
+        for (size_t r = 0; r < Info::num_ranges; ++r)
+            if (c >= Info::ranges[r].lo && c <= Info::ranges[r].hi) return true;
+        return false;
+    }
+}
+
+// A sequence of fixed segments matches a fixed number of bytes, each from a fixed
+// set: a multi-word shift-or finds it in one scan (see shift_or.hpp, fast_search.hpp)
+template <typename T> struct fixed_segment_sequence : std::false_type {
+    static constexpr size_t length = 0;
+};
+
+template <typename... Elements>
+struct fixed_segment_sequence<sequence<Elements...>>
+    : std::bool_constant<(sizeof...(Elements) > 1) && (is_fixed_segment<Elements> && ...)> {
+    static constexpr size_t length = (segment_info<Elements>::min_len + ...);
+
+    // Bytes accepted at each position, 256 bits per position
+    [[nodiscard]] static constexpr auto position_sets() noexcept {
+        std::array<std::array<uint64_t, 4>, length> sets{};
+        size_t pos = 0;
+        ([&] {
+            using Info = segment_info<Elements>;
+            for (size_t i = 0; i < Info::min_len; ++i, ++pos)
+                for (size_t c = 0; c < 256; ++c)
+                    if (segment_accepts<Info>(static_cast<char>(c))) sets[pos][c / 64] |= uint64_t(1) << (c % 64);
+        }(), ...);
+        return sets;
+    }
+};
+
 [[gnu::always_inline]] inline bool check_positions_with_ranges(const char* data, uint32_t mask,
                                                                        const CharRange* ranges, size_t num_ranges) {
     if (num_ranges == 0 || num_ranges > 8 || mask == 0) return true;
@@ -216,8 +257,14 @@ inline Iterator match_sequence_generic(Iterator begin, EndIterator end) {
     constexpr size_t min_total = (... + segment_info<Elements>::min_len);
     constexpr bool has_unbounded = (... || segment_info<Elements>::is_unbounded);
     constexpr bool has_captures = (... || segment_info<Elements>::has_capture);
+    // Anything else (a bare set, any, a nested select) has no segment_info and would count as zero bytes
+    constexpr bool all_segments = ((segment_info<Elements>::is_literal || segment_info<Elements>::is_char_class) && ...);
 
-    if constexpr (max_total > 16 || (max_total - min_total) > 16 || VarGen::variants.size() == 0 || has_unbounded || has_captures)
+    // A variable-length sequence can end at several places, and the rest of the regex
+    // decides which one is taken: committing to the first variant that fits is only
+    // sound when there is a single length
+    if constexpr (max_total > 16 || max_total != min_total || VarGen::variants.size() == 0 || has_unbounded ||
+                  has_captures || !all_segments)
         return begin;
 
     size_t remaining;
@@ -257,6 +304,10 @@ inline Iterator match_sequence_fused(sequence<Elements...>*, Iterator begin, End
 template <typename SequenceType, typename Iterator, typename EndIterator>
 inline Iterator match_sequence_fused(SequenceType*, Iterator begin, EndIterator) { return begin; }
 
+template <typename T> struct fixed_segment_sequence : std::false_type {
+    static constexpr size_t length = 0;
+};
+
 #endif
 
 } // namespace ctre::simd
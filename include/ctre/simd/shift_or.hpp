@@ -1,6 +1,7 @@
 #ifndef CTRE__SIMD_SHIFT_OR__HPP
 #define CTRE__SIMD_SHIFT_OR__HPP
 
+#include "../byte_classes.hpp"
 #include "../flags_and_modes.hpp"
 #include "detection.hpp"
 #include <array>
@@ -9,6 +10,7 @@
 #include <immintrin.h>
 #endif
 #include <iterator>
+#include <type_traits>
 
 #if defined(__GNUC__) || defined(__clang__)
 #define HOT_ALWAYS_INLINE [[gnu::always_inline]] inline
@@ -33,11 +35,46 @@ constexpr size_t SHIFT_OR_THRESHOLD = 32;
 
 constexpr size_t MAX_SHIFT_OR_PATTERN_LENGTH = 64;
 
+// Longer patterns run on a multi-word state (wide_shift_or_state)
+constexpr size_t MAX_WIDE_SHIFT_OR_PATTERN_LENGTH = 256;
+
 template <size_t N>
 using mask_t =
     std::conditional_t<(N <= 8), uint8_t,
                        std::conditional_t<(N <= 16), uint16_t, std::conditional_t<(N <= 32), uint32_t, uint64_t>>>;
 
+// Clears the bit of position i in a mask word or a multi-word mask
+template <typename Row>
+constexpr void clear_position(Row& row, size_t i) noexcept {
+    if constexpr (std::is_integral_v<Row>) {
+        row &= static_cast<Row>(~(Row(1) << i));
+    } else {
+        row[i / 64] &= ~(uint64_t(1) << (i % 64));
+    }
+}
+
+// Masks of a pattern whose position i accepts the bytes set in sets[i]
+template <typename Row, size_t PatternLength>
+constexpr std::array<Row, 256> position_set_masks(const std::array<std::array<uint64_t, 4>, PatternLength>& sets) {
+    std::array<Row, 256> masks{};
+    for (auto& mask : masks) {
+        if constexpr (std::is_integral_v<Row>) {
+            mask = static_cast<Row>(~Row(0));
+        } else {
+            mask.fill(~uint64_t(0));
+        }
+    }
+
+    for (size_t i = 0; i < PatternLength; ++i) {
+        for (size_t c = 0; c < 256; ++c) {
+            if ((sets[i][c / 64] >> (c % 64)) & 1u) {
+                clear_position(masks[c], i);
+            }
+        }
+    }
+    return masks;
+}
+
 template <size_t PatternLength>
 struct alignas(64) shift_or_state {
     static_assert(PatternLength > 0, "Pattern length must be positive");
@@ -45,39 +82,135 @@ struct alignas(64) shift_or_state {
 
     using M = mask_t<PatternLength>;
 
-    alignas(32) std::array<M, 256> char_masks;
+    // Masks by byte class: a pattern of N positions has at most N + 1 distinct masks
+    byte_class_table<M, PatternLength + 1> char_masks;
 
     template <auto... Chars>
     constexpr void init_exact_pattern() {
         constexpr char pattern[] = {static_cast<char>(Chars)...};
         static_assert(sizeof...(Chars) == PatternLength, "Pattern length mismatch");
 
-        for (auto& mask : char_masks) {
+        std::array<M, 256> masks{};
+        for (auto& mask : masks) {
             mask = ~M(0);
         }
 
         // Set 0 bits for matching characters at each position (Shift-Or uses 0=good, 1=bad)
         for (size_t i = 0; i < PatternLength; ++i) {
-            char_masks[static_cast<unsigned char>(pattern[i])] &= static_cast<M>(~(M(1) << i));
+            masks[static_cast<unsigned char>(pattern[i])] &= static_cast<M>(~(M(1) << i));
+        }
+        char_masks = decltype(char_masks)::from_rows(masks);
+    }
+
+    // Both ASCII cases of an alphabetic position match it
+    template <auto... Chars>
+    constexpr void init_caseless_pattern() {
+        constexpr char pattern[] = {static_cast<char>(Chars)...};
+        static_assert(sizeof...(Chars) == PatternLength, "Pattern length mismatch");
+
+        std::array<M, 256> masks{};
+        for (auto& mask : masks) {
+            mask = ~M(0);
+        }
+
+        for (size_t i = 0; i < PatternLength; ++i) {
+            const auto c = static_cast<unsigned char>(pattern[i]);
+            const auto folded = static_cast<unsigned char>(c | LOWERCASE_BIT);
+            masks[c] &= static_cast<M>(~(M(1) << i));
+            if (folded >= 'a' && folded <= 'z') {
+                masks[folded] &= static_cast<M>(~(M(1) << i));
+                masks[folded & ~LOWERCASE_BIT] &= static_cast<M>(~(M(1) << i));
+            }
         }
+        char_masks = decltype(char_masks)::from_rows(masks);
     }
 
     template <typename CharClass>
     constexpr void init_char_class_pattern() {
-        for (auto& mask : char_masks) {
+        std::array<M, 256> masks{};
+        for (auto& mask : masks) {
             mask = ~M(0);
         }
 
         for (size_t i = 0; i < PatternLength; ++i) {
             for (int c = 0; c < 256; ++c) {
                 if (CharClass::match_char(static_cast<char>(c), flags{})) {
-                    char_masks[c] &= ~(M(1) << i);
+                    masks[c] &= ~(M(1) << i);
                 }
             }
         }
+        char_masks = decltype(char_masks)::from_rows(masks);
+    }
+
+    // A byte set per position, e.g. fixed_segment_sequence::position_sets()
+    constexpr void init_position_sets(const std::array<std::array<uint64_t, 4>, PatternLength>& sets) {
+        char_masks = decltype(char_masks)::from_rows(position_set_masks<M, PatternLength>(sets));
     }
 };
 
+// Shift-Or over more than 64 positions: the state D is 2 words (one SSE register) up
+// to 128 positions, 4 words (one AVX2 register) up to 256, and every shift carries
+// the top bit of a word into the next one.
+template <size_t PatternLength>
+struct alignas(64) wide_shift_or_state {
+    static_assert(PatternLength > 0, "Pattern length must be positive");
+    static_assert(PatternLength <= MAX_WIDE_SHIFT_OR_PATTERN_LENGTH, "Pattern too long for Shift-Or");
+
+    static constexpr size_t words = PatternLength <= 128 ? 2 : 4;
+    using row = std::array<uint64_t, words>;
+
+    byte_class_table<row, (PatternLength < 256 ? PatternLength + 1 : 256)> char_masks;
+
+    template <auto... Chars>
+    constexpr void init_exact_pattern() {
+        static_assert(sizeof...(Chars) == PatternLength, "Pattern length mismatch");
+        init_position_sets(sets_of<false, Chars...>());
+    }
+
+    template <auto... Chars>
+    constexpr void init_caseless_pattern() {
+        static_assert(sizeof...(Chars) == PatternLength, "Pattern length mismatch");
+        init_position_sets(sets_of<true, Chars...>());
+    }
+
+    template <typename CharClass>
+    constexpr void init_char_class_pattern() {
+        std::array<std::array<uint64_t, 4>, PatternLength> sets{};
+        for (int c = 0; c < 256; ++c) {
+            if (CharClass::match_char(static_cast<char>(c), flags{})) {
+                for (auto& set : sets) set[c / 64] |= uint64_t(1) << (c % 64);
+            }
+        }
+        init_position_sets(sets);
+    }
+
+    constexpr void init_position_sets(const std::array<std::array<uint64_t, 4>, PatternLength>& sets) {
+        char_masks = decltype(char_masks)::from_rows(position_set_masks<row, PatternLength>(sets));
+    }
+
+private:
+    template <bool Caseless, auto... Chars>
+    static constexpr auto sets_of() {
+        constexpr unsigned char pattern[] = {static_cast<unsigned char>(Chars)...};
+        std::array<std::array<uint64_t, 4>, PatternLength> sets{};
+        for (size_t i = 0; i < PatternLength; ++i) {
+            const unsigned char c = pattern[i];
+            const auto folded = static_cast<unsigned char>(c | LOWERCASE_BIT);
+            sets[i][c / 64] |= uint64_t(1) << (c % 64);
+            if (Caseless && folded >= 'a' && folded <= 'z') {
+                const auto upper = static_cast<unsigned char>(folded & ~LOWERCASE_BIT);
+                sets[i][folded / 64] |= uint64_t(1) << (folded % 64);
+                sets[i][upper / 64] |= uint64_t(1) << (upper % 64);
+            }
+        }
+        return sets;
+    }
+};
+
+template <size_t PatternLength>
+using shift_or_state_for = std::conditional_t<(PatternLength <= MAX_SHIFT_OR_PATTERN_LENGTH),
+                                              shift_or_state<PatternLength>, wide_shift_or_state<PatternLength>>;
+
 template <size_t PatternLength, typename It, typename EndIt>
     requires std::contiguous_iterator<It> && std::same_as<std::remove_cvref_t<decltype(*std::declval<It>())>, char>
 inline bool match_shift_or_unrolled16(It& cur, const EndIt last, const shift_or_state<PatternLength>& st) {
@@ -88,7 +221,8 @@ inline bool match_shift_or_unrolled16(It& cur, const EndIt last, const shift_or_
     const unsigned char* base = reinterpret_cast<const unsigned char*>(std::to_address(cur));
     const unsigned char* p = base;
     const unsigned char* end = reinterpret_cast<const unsigned char*>(std::to_address(last));
-    const M* __restrict cm = st.char_masks.data();
+    const uint8_t* __restrict cls = st.char_masks.class_of.data();
+    const M* __restrict cm = st.char_masks.rows.data();
 
     uint64_t D = ~0ull;
     const uint64_t MSB = 1ull << (PatternLength - 1);
@@ -97,7 +231,7 @@ inline bool match_shift_or_unrolled16(It& cur, const EndIt last, const shift_or_
         uint32_t hits = 0;
 #define STEP(j)                                                                                                        \
     do {                                                                                                               \
-        uint64_t T = (D << 1) | (uint64_t)cm[p[(j)]];                                                                  \
+        uint64_t T = (D << 1) | (uint64_t)cm[cls[p[(j)]]];                                                             \
         hits |= ((~T >> (PatternLength - 1)) & 1u) << (j);                                                             \
         D = T;                                                                                                         \
     } while (0)
@@ -140,7 +274,7 @@ inline bool match_shift_or_unrolled16(It& cur, const EndIt last, const shift_or_
     }
 
     while (p < end) {
-        D = (D << 1) | (uint64_t)cm[*p++];
+        D = (D << 1) | (uint64_t)cm[cls[*p++]];
         if (CTRE_EXPECT_FALSE(!(D & MSB))) {
             cur = uchar_to_iter<It>(p);
             return true;
@@ -159,7 +293,8 @@ inline bool match_shift_or_unrolled8(It& cur, const EndIt last, const shift_or_s
     const unsigned char* base = reinterpret_cast<const unsigned char*>(std::to_address(cur));
     const unsigned char* p = base;
     const unsigned char* end = reinterpret_cast<const unsigned char*>(std::to_address(last));
-    const M* __restrict cm = st.char_masks.data();
+    const uint8_t* __restrict cls = st.char_masks.class_of.data();
+    const M* __restrict cm = st.char_masks.rows.data();
 
     uint64_t D = ~0ull;
     const uint64_t MSB = 1ull << (PatternLength - 1);
@@ -168,7 +303,7 @@ inline bool match_shift_or_unrolled8(It& cur, const EndIt last, const shift_or_s
         uint32_t hits = 0;
 #define STEP(j)                                                                                                        \
     do {                                                                                                               \
-        uint64_t T = (D << 1) | (uint64_t)cm[p[(j)]];                                                                  \
+        uint64_t T = (D << 1) | (uint64_t)cm[cls[p[(j)]]];                                                             \
         hits |= ((~T >> (PatternLength - 1)) & 1u) << (j);                                                             \
         D = T;                                                                                                         \
     } while (0)
@@ -195,7 +330,7 @@ inline bool match_shift_or_unrolled8(It& cur, const EndIt last, const shift_or_s
     }
 
     while (p < end) {
-        D = (D << 1) | (uint64_t)cm[*p++];
+        D = (D << 1) | (uint64_t)cm[cls[*p++]];
         if (CTRE_EXPECT_FALSE(!(D & MSB))) {
             cur = uchar_to_iter<It>(p);
             return true;
@@ -214,28 +349,29 @@ inline bool match_shift_or_scalar(It& cur, const EndIt last, const shift_or_stat
     const unsigned char* base = reinterpret_cast<const unsigned char*>(std::to_address(cur));
     const unsigned char* p = base;
     const unsigned char* end = reinterpret_cast<const unsigned char*>(std::to_address(last));
-    const M* __restrict cm = st.char_masks.data();
+    const uint8_t* __restrict cls = st.char_masks.class_of.data();
+    const M* __restrict cm = st.char_masks.rows.data();
 
     uint64_t D = ~0ull;
     const uint64_t MSB = 1ull << (PatternLength - 1);
 
     while (size_t(end - p) >= 4) {
-        D = (D << 1) | (uint64_t)cm[p[0]];
+        D = (D << 1) | (uint64_t)cm[cls[p[0]]];
         if (CTRE_EXPECT_FALSE(!(D & MSB))) {
             cur = uchar_to_iter<It>(p + 1);
             return true;
         }
-        D = (D << 1) | (uint64_t)cm[p[1]];
+        D = (D << 1) | (uint64_t)cm[cls[p[1]]];
         if (CTRE_EXPECT_FALSE(!(D & MSB))) {
             std::advance(cur, (p + 2) - base);
             return true;
         }
-        D = (D << 1) | (uint64_t)cm[p[2]];
+        D = (D << 1) | (uint64_t)cm[cls[p[2]]];
         if (CTRE_EXPECT_FALSE(!(D & MSB))) {
             std::advance(cur, (p + 3) - base);
             return true;
         }
-        D = (D << 1) | (uint64_t)cm[p[3]];
+        D = (D << 1) | (uint64_t)cm[cls[p[3]]];
         if (CTRE_EXPECT_FALSE(!(D & MSB))) {
             std::advance(cur, (p + 4) - base);
             return true;
@@ -244,7 +380,7 @@ inline bool match_shift_or_scalar(It& cur, const EndIt last, const shift_or_stat
     }
 
     while (p < end) {
-        D = (D << 1) | (uint64_t)cm[*p++];
+        D = (D << 1) | (uint64_t)cm[cls[*p++]];
         if (CTRE_EXPECT_FALSE(!(D & MSB))) {
             cur = uchar_to_iter<It>(p);
             return true;
@@ -254,7 +390,8 @@ inline bool match_shift_or_scalar(It& cur, const EndIt last, const shift_or_stat
 }
 
 template <size_t PatternLength, typename It, typename EndIt>
-    requires std::contiguous_iterator<It> && std::same_as<std::remove_cvref_t<decltype(*std::declval<It>())>, char>
+    requires(PatternLength <= MAX_SHIFT_OR_PATTERN_LENGTH) && std::contiguous_iterator<It> &&
+            std::same_as<std::remove_cvref_t<decltype(*std::declval<It>())>, char>
 inline bool match_shift_or(It& current, const EndIt last, const shift_or_state<PatternLength>& state) {
     const size_t haystack_size = std::to_address(last) - std::to_address(current);
 
@@ -274,6 +411,101 @@ inline bool match_shift_or(It& current, const EndIt last, const shift_or_state<P
     return match_shift_or_scalar<PatternLength>(current, last, state);
 }
 
+// Wide kernels return the position after the first match end, or nullptr
+template <size_t PatternLength>
+inline const unsigned char* wide_shift_or_scalar(const unsigned char* p, const unsigned char* end,
+                                                 const wide_shift_or_state<PatternLength>& st) noexcept {
+    constexpr size_t words = wide_shift_or_state<PatternLength>::words;
+    constexpr size_t top_word = (PatternLength - 1) / 64;
+    constexpr uint64_t top_bit = uint64_t(1) << ((PatternLength - 1) % 64);
+
+    std::array<uint64_t, words> D;
+    D.fill(~uint64_t(0));
+    while (p < end) {
+        const auto& m = st.char_masks[*p++];
+        for (size_t w = words - 1; w > 0; --w) {
+            D[w] = (D[w] << 1) | (D[w - 1] >> 63) | m[w];
+        }
+        D[0] = (D[0] << 1) | m[0];
+        if (CTRE_EXPECT_FALSE(!(D[top_word] & top_bit))) return p;
+    }
+    return nullptr;
+}
+
+#ifdef CTRE_ARCH_X86
+// Only the match bit set: testc(D, bit) holds while that bit of D is still 1
+template <size_t PatternLength, size_t Words>
+constexpr std::array<uint64_t, Words> wide_shift_or_match_bit() noexcept {
+    std::array<uint64_t, Words> bit{};
+    bit[(PatternLength - 1) / 64] = uint64_t(1) << ((PatternLength - 1) % 64);
+    return bit;
+}
+
+template <size_t PatternLength>
+CTRE_TARGET_SSE42 inline const unsigned char* wide_shift_or_sse42(const unsigned char* p, const unsigned char* end,
+                                                                  const wide_shift_or_state<PatternLength>& st) noexcept {
+    if constexpr (wide_shift_or_state<PatternLength>::words != 2) {
+        return wide_shift_or_scalar<PatternLength>(p, end, st);
+    } else {
+        constexpr auto bit_words = wide_shift_or_match_bit<PatternLength, 2>();
+        const __m128i bit = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bit_words.data()));
+        __m128i D = _mm_set1_epi32(-1);
+        while (p < end) {
+            const __m128i m = _mm_loadu_si128(reinterpret_cast<const __m128i*>(st.char_masks[*p++].data()));
+            // 128-bit shift by one: the top bit of the low word carries into the high one
+            const __m128i carry = _mm_srli_epi64(_mm_slli_si128(D, 8), 63);
+            D = _mm_or_si128(_mm_or_si128(_mm_slli_epi64(D, 1), carry), m);
+            if (CTRE_EXPECT_FALSE(!_mm_testc_si128(D, bit))) return p;
+        }
+        return nullptr;
+    }
+}
+
+template <size_t PatternLength>
+CTRE_TARGET_AVX2 inline const unsigned char* wide_shift_or_avx2(const unsigned char* p, const unsigned char* end,
+                                                                const wide_shift_or_state<PatternLength>& st) noexcept {
+    if constexpr (wide_shift_or_state<PatternLength>::words != 4) {
+        return wide_shift_or_sse42<PatternLength>(p, end, st);
+    } else {
+        constexpr auto bit_words = wide_shift_or_match_bit<PatternLength, 4>();
+        const __m256i bit = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(bit_words.data()));
+        __m256i D = _mm256_set1_epi32(-1);
+        while (p < end) {
+            const __m256i m = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(st.char_masks[*p++].data()));
+            // Each word takes the top bit of the word below it, the lowest word a 0
+            const __m256i below = _mm256_blend_epi32(_mm256_permute4x64_epi64(D, 0x93), _mm256_setzero_si256(), 0x03);
+            D = _mm256_or_si256(_mm256_or_si256(_mm256_slli_epi64(D, 1), _mm256_srli_epi64(below, 63)), m);
+            if (CTRE_EXPECT_FALSE(!_mm256_testc_si256(D, bit))) return p;
+        }
+        return nullptr;
+    }
+}
+#else
+template <size_t PatternLength>
+inline const unsigned char* wide_shift_or_sse42(const unsigned char* p, const unsigned char* end,
+                                                const wide_shift_or_state<PatternLength>& st) noexcept {
+    return wide_shift_or_scalar<PatternLength>(p, end, st);
+}
+
+template <size_t PatternLength>
+inline const unsigned char* wide_shift_or_avx2(const unsigned char* p, const unsigned char* end,
+                                               const wide_shift_or_state<PatternLength>& st) noexcept {
+    return wide_shift_or_scalar<PatternLength>(p, end, st);
+}
+#endif
+
+template <size_t PatternLength, typename It, typename EndIt>
+    requires std::contiguous_iterator<It> && std::same_as<std::remove_cvref_t<decltype(*std::declval<It>())>, char>
+inline bool match_shift_or(It& current, const EndIt last, const wide_shift_or_state<PatternLength>& state) {
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(std::to_address(current));
+    const unsigned char* end = reinterpret_cast<const unsigned char*>(std::to_address(last));
+    const unsigned char* hit = dispatch_kernel<&wide_shift_or_avx2<PatternLength>, &wide_shift_or_sse42<PatternLength>,
+                                               &wide_shift_or_scalar<PatternLength>>(p, end, state);
+    if (hit == nullptr) return false;
+    current = uchar_to_iter<It>(hit);
+    return true;
+}
+
 #ifdef CTRE_ARCH_X86
 template <size_t N, typename It, typename EndIt>
     requires(N > 1 && N <= 32) && std::contiguous_iterator<It> &&
@@ -527,19 +759,24 @@ inline bool match_class_run_shufti(It& cur, EndIt last, const auto& cc) {
 template <auto... String, typename Iterator, typename EndIterator>
     requires std::is_same_v<std::remove_cv_t<std::remove_reference_t<decltype(*std::declval<Iterator>())>>, char>
 inline bool match_string_shift_or(Iterator& current, const EndIterator last, const flags& f) {
-    (void)f; // Suppress unused parameter warning
     constexpr size_t string_length = sizeof...(String);
-    static_assert(string_length <= MAX_SHIFT_OR_PATTERN_LENGTH, "Pattern too long for Shift-Or");
+    static_assert(string_length <= MAX_WIDE_SHIFT_OR_PATTERN_LENGTH, "Pattern too long for Shift-Or");
 
-    constexpr char pattern[] = {static_cast<char>(String)...};
-
-    static constexpr shift_or_state<string_length> state = []() {
-        shift_or_state<string_length> s;
+    static constexpr shift_or_state_for<string_length> state = []() {
+        shift_or_state_for<string_length> s;
         s.template init_exact_pattern<String...>();
         return s;
     }();
 
-    return match_shift_or<string_length>(current, last, state);
+    if (is_case_insensitive(f)) {
+        static constexpr shift_or_state_for<string_length> caseless_state = []() {
+            shift_or_state_for<string_length> s;
+            s.template init_caseless_pattern<String...>();
+            return s;
+        }();
+        return match_shift_or(current, last, caseless_state);
+    }
+    return match_shift_or(current, last, state);
 }
 
 template <size_t NumPatterns, size_t MaxPatternLength>
@@ -563,13 +800,15 @@ struct multi_pattern_shift_or_state {
                                       const std::array<char, PatternLength>& pattern) {
         using M = typename shift_or_state<MaxPatternLength>::M;
 
-        for (auto& mask : state.char_masks) {
+        std::array<M, 256> masks{};
+        for (auto& mask : masks) {
             mask = ~M(0);
         }
 
         for (size_t i = 0; i < PatternLength; ++i) {
-            state.char_masks[static_cast<unsigned char>(pattern[i])] &= ~(M(1) << i);
+            masks[static_cast<unsigned char>(pattern[i])] &= ~(M(1) << i);
         }
+        state.char_masks = decltype(state.char_masks)::from_rows(masks);
     }
 };
 
@@ -580,15 +819,14 @@ inline bool match_multi_pattern_shift_or(It& current, const EndIt last,
     if (current == last)
         return false;
 
-    using M = typename shift_or_state<MaxPatternLength>::M;
     const unsigned char* p = reinterpret_cast<const unsigned char*>(std::to_address(current));
     const unsigned char* end = reinterpret_cast<const unsigned char*>(std::to_address(last));
 
     uint64_t D0 = ~0ull, D1 = ~0ull, D2 = ~0ull, D3 = ~0ull;
-    const M* m0 = state.pattern_states[0].char_masks.data();
-    const M* m1 = NumPatterns > 1 ? state.pattern_states[1].char_masks.data() : nullptr;
-    const M* m2 = NumPatterns > 2 ? state.pattern_states[2].char_masks.data() : nullptr;
-    const M* m3 = NumPatterns > 3 ? state.pattern_states[3].char_masks.data() : nullptr;
+    const auto& m0 = state.pattern_states[0].char_masks;
+    const auto& m1 = state.pattern_states[NumPatterns > 1 ? 1 : 0].char_masks;
+    const auto& m2 = state.pattern_states[NumPatterns > 2 ? 2 : 0].char_masks;
+    const auto& m3 = state.pattern_states[NumPatterns > 3 ? 3 : 0].char_masks;
 
     const uint64_t MSB0 = 1ull << (state.pattern_lengths[0] - 1);
     const uint64_t MSB1 = NumPatterns > 1 ? (1ull << (state.pattern_lengths[1] - 1)) : 0;
@@ -25,8 +25,14 @@ template <>
 struct is_sentinel_iterator<ctre::zero_terminated_string_end_iterator> : std::true_type {};
 
 // Null terminator scanning
-#ifdef __AVX2__
-inline const unsigned char* find_null_terminator_avx2(const unsigned char* p) {
+inline const unsigned char* find_null_terminator_scalar(const unsigned char* p) {
+    while (*p)
+        ++p;
+    return p;
+}
+
+#ifdef CTRE_ARCH_X86
+CTRE_TARGET_AVX2 inline const unsigned char* find_null_terminator_avx2(const unsigned char* p) {
     __m256i zero = _mm256_setzero_si256();
     const unsigned char* aligned = reinterpret_cast<const unsigned char*>((reinterpret_cast<uintptr_t>(p) + 31) & ~static_cast<uintptr_t>(31));
     for (const unsigned char* s = p; s < aligned && s < p + 32; ++s)
@@ -39,23 +45,18 @@ inline const unsigned char* find_null_terminator_avx2(const unsigned char* p) {
             return s + static_cast<size_t>(CTRE_CTZ(static_cast<unsigned>(mask)));
     }
 }
-#endif
-
-inline const unsigned char* find_null_terminator_scalar(const unsigned char* p) {
-    while (*p)
-        ++p;
-    return p;
+#else
+inline const unsigned char* find_null_terminator_avx2(const unsigned char* p) {
+    return find_null_terminator_scalar(p);
 }
+#endif
 
 template <typename Iterator, typename EndIterator>
 inline const unsigned char* get_end_pointer(Iterator current, EndIterator last) {
     if constexpr (is_sentinel_iterator<std::remove_cvref_t<EndIterator>>::value) {
         const unsigned char* p = reinterpret_cast<const unsigned char*>(std::to_address(current));
-#ifdef __AVX2__
-        return find_null_terminator_avx2(p);
-#else
-        return find_null_terminator_scalar(p);
-#endif
+        return dispatch_kernel<&find_null_terminator_avx2,
+                               &find_null_terminator_scalar, &find_null_terminator_scalar>(p);
     } else {
         return reinterpret_cast<const unsigned char*>(std::to_address(last));
     }
@@ -222,15 +223,19 @@ struct character_class {
 #ifdef CTRE_ARCH_X86
 // Exact range SIMD finders
 namespace exact_range {
-inline bool find_alnum_avx2(const unsigned char* p, const unsigned char* end, const unsigned char*& out) {
+// Bytes of x (biased by 0x80) within [lo, hi]; a function rather than a lambda,
+// lambdas do not inherit the AVX2 target
+CTRE_TARGET_AVX2 inline __m256i in_range(__m256i x, unsigned lo, unsigned hi) {
+    __m256i L = _mm256_set1_epi8(char(lo ^ 0x80)), H = _mm256_set1_epi8(char(hi ^ 0x80));
+    return _mm256_and_si256(_mm256_xor_si256(_mm256_cmpgt_epi8(L, x), _mm256_set1_epi8(char(0xFF))),
+                            _mm256_xor_si256(_mm256_cmpgt_epi8(x, H), _mm256_set1_epi8(char(0xFF))));
+}
+
+CTRE_TARGET_AVX2 inline bool find_alnum_avx2(const unsigned char* p, const unsigned char* end,
+                                             const unsigned char*& out) {
     if (p >= end)
         return false;
     size_t rem = static_cast<size_t>(end - p);
-    auto in_range = [](__m256i x, unsigned lo, unsigned hi) {
-        __m256i L = _mm256_set1_epi8(char(lo ^ 0x80)), H = _mm256_set1_epi8(char(hi ^ 0x80));
-        return _mm256_and_si256(_mm256_xor_si256(_mm256_cmpgt_epi8(L, x), _mm256_set1_epi8(char(0xFF))),
-                                _mm256_xor_si256(_mm256_cmpgt_epi8(x, H), _mm256_set1_epi8(char(0xFF))));
-    };
     while (rem >= 32) {
         __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
         __m256i x = _mm256_xor_si256(v, _mm256_set1_epi8(char(0x80)));
@@ -256,7 +261,8 @@ inline bool find_alnum_avx2(const unsigned char* p, const unsigned char* end, co
     return false;
 }
 
-inline bool find_digits_avx2(const unsigned char* p, const unsigned char* end, const unsigned char*& out) {
+CTRE_TARGET_AVX2 inline bool find_digits_avx2(const unsigned char* p, const unsigned char* end,
+                                              const unsigned char*& out) {
     if (p >= end)
         return false;
     size_t rem = static_cast<size_t>(end - p);
@@ -284,15 +290,11 @@ inline bool find_digits_avx2(const unsigned char* p, const unsigned char* end, c
     return false;
 }
 
-inline bool find_letters_avx2(const unsigned char* p, const unsigned char* end, const unsigned char*& out) {
+CTRE_TARGET_AVX2 inline bool find_letters_avx2(const unsigned char* p, const unsigned char* end,
+                                               const unsigned char*& out) {
     if (p >= end)
         return false;
     size_t rem = static_cast<size_t>(end - p);
-    auto in_range = [](__m256i x, unsigned lo, unsigned hi) {
-        __m256i L = _mm256_set1_epi8(char(lo ^ 0x80)), H = _mm256_set1_epi8(char(hi ^ 0x80));
-        return _mm256_and_si256(_mm256_xor_si256(_mm256_cmpgt_epi8(L, x), _mm256_set1_epi8(char(0xFF))),
-                                _mm256_xor_si256(_mm256_cmpgt_epi8(x, H), _mm256_set1_epi8(char(0xFF))));
-    };
     while (rem >= 32) {
         __m256i x =
             _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)), _mm256_set1_epi8(char(0x80)));
@@ -316,7 +318,8 @@ inline bool find_letters_avx2(const unsigned char* p, const unsigned char* end,
     return false;
 }
 
-inline bool find_whitespace_avx2(const unsigned char* p, const unsigned char* end, const unsigned char*& out) {
+CTRE_TARGET_AVX2 inline bool find_whitespace_avx2(const unsigned char* p, const unsigned char* end,
+                                                  const unsigned char*& out) {
     if (p >= end)
         return false;
     size_t rem = static_cast<size_t>(end - p);
@@ -349,8 +352,8 @@ inline bool find_whitespace_avx2(const unsigned char* p, const unsigned char* en
 } // namespace exact_range
 
 // Shufti find implementations
-inline bool shufti_find_avx2_single(const unsigned char* p, const unsigned char* end, const character_class& cc,
-                                    const unsigned char*& out) {
+CTRE_TARGET_AVX2 inline bool shufti_find_avx2_single(const unsigned char* p, const unsigned char* end,
+                                                     const character_class& cc, const unsigned char*& out) {
     if (p >= end)
         return false;
     size_t rem = static_cast<size_t>(end - p);
@@ -378,7 +381,6 @@ inline bool shufti_find_avx2_single(const unsigned char* p, const unsigned char*
         p += 32;
         rem -= 32;
     }
-#if defined(__SSSE3__) || defined(__SSE4_2__)
     if (rem >= 16) {
         __m128i input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
         __m128i un = _mm_and_si128(_mm_srli_epi16(input, 4), _mm_set1_epi8(0x0F));
@@ -399,7 +401,6 @@ inline bool shufti_find_avx2_single(const unsigned char* p, const unsigned char*
         p += 16;
         rem -= 16;
     }
-#endif
     while (p < end) {
         if (cc.exact_membership[*p]) {
             out = p + 1;
@@ -410,8 +411,8 @@ inline bool shufti_find_avx2_single(const unsigned char* p, const unsigned char*
     return false;
 }
 
-inline bool shufti_find_avx2_double(const unsigned char* p, const unsigned char* end, const character_class& cc,
-                                    const unsigned char*& out) {
+CTRE_TARGET_AVX2 inline bool shufti_find_avx2_double(const unsigned char* p, const unsigned char* end,
+                                                     const character_class& cc, const unsigned char*& out) {
     if (p >= end)
         return false;
     size_t rem = static_cast<size_t>(end - p);
@@ -454,8 +455,8 @@ inline bool shufti_find_avx2_double(const unsigned char* p, const unsigned char*
     return false;
 }
 
-inline bool shufti_find_avx2(const unsigned char* p, const unsigned char* end, const character_class& cc,
-                             const unsigned char*& out) {
+CTRE_TARGET_AVX2 inline bool shufti_find_avx2(const unsigned char* p, const unsigned char* end,
+                                              const character_class& cc, const unsigned char*& out) {
     if (p >= end)
         return false;
     if (cc.use_exact_range)
@@ -463,8 +464,8 @@ inline bool shufti_find_avx2(const unsigned char* p, const unsigned char* end, c
     return cc.use_double_shufti ? shufti_find_avx2_double(p, end, cc, out) : shufti_find_avx2_single(p, end, cc, out);
 }
 
-inline bool shufti_find_ssse3(const unsigned char* p, const unsigned char* end, const character_class& cc,
-                              const unsigned char*& out) {
+CTRE_TARGET_SSE42 inline bool shufti_find_ssse3(const unsigned char* p, const unsigned char* end,
+                                                const character_class& cc, const unsigned char*& out) {
     if (p >= end)
         return false;
     size_t rem = static_cast<size_t>(end - p);
@@ -506,7 +507,8 @@ inline bool shufti_find_ssse3(const unsigned char* p, const unsigned char* end,
 template <typename Iterator, typename EndIterator>
     requires std::contiguous_iterator<Iterator> &&
              std::is_same_v<std::remove_cvref_t<decltype(*std::declval<Iterator>())>, char>
-inline bool match_char_class_shufti_avx2(Iterator& current, EndIterator last, const character_class& cc) {
+CTRE_TARGET_AVX2 inline bool match_char_class_shufti_avx2(Iterator& current, EndIterator last,
+                                                          const character_class& cc) {
     if (current == last)
         return false;
     const unsigned char* p = reinterpret_cast<const unsigned char*>(std::to_address(current));
@@ -523,7 +525,8 @@ inline bool match_char_class_shufti_avx2(Iterator& current, EndIterator last, co
 template <typename Iterator, typename EndIterator>
     requires std::contiguous_iterator<Iterator> &&
              std::is_same_v<std::remove_cvref_t<decltype(*std::declval<Iterator>())>, char>
-inline bool match_char_class_shufti_ssse3(Iterator& current, EndIterator last, const character_class& cc) {
+CTRE_TARGET_SSE42 inline bool match_char_class_shufti_ssse3(Iterator& current, EndIterator last,
+                                                            const character_class& cc) {
     if (current == last)
         return false;
     const unsigned char* p = reinterpret_cast<const unsigned char*>(std::to_address(current));
@@ -571,14 +574,10 @@ inline bool match_char_class_shufti(Iterator& current, EndIterator last, const c
     if constexpr (is_sentinel_iterator<std::remove_cvref_t<EndIterator>>::value)
         return false;
     else {
-        if constexpr (CTRE_SIMD_ENABLED) {
-#ifdef __AVX2__
-            return match_char_class_shufti_avx2(current, last, cc);
-#elif defined(__SSSE3__) || defined(__SSE4_2__)
-            return match_char_class_shufti_ssse3(current, last, cc);
-#else
-            return match_char_class_shufti_scalar(current, last, cc);
-#endif
+        if constexpr (CTRE_SIMD_ENABLED && std::contiguous_iterator<Iterator>) {
+            return dispatch_kernel<&match_char_class_shufti_avx2<Iterator, EndIterator>,
+                                   &match_char_class_shufti_ssse3<Iterator, EndIterator>,
+                                   &match_char_class_shufti_scalar<Iterator, EndIterator>>(current, last, cc);
         }
         return match_char_class_shufti_scalar(current, last, cc);
     }
@@ -646,6 +645,116 @@ constexpr character_class get_character_class_for_pattern() {
     }
 }
 
+// Shufti repetition kernels: advance p over the run of class bytes (bytes outside
+// the class when Negated) a vector at a time, the caller finishes the run
+template <bool Negated, size_t MaxCount>
+inline void shufti_run_scalar(const unsigned char*&, size_t&, size_t&, const character_class&) {}
+
+#ifdef CTRE_ARCH_X86
+template <bool Negated, size_t MaxCount>
+CTRE_TARGET_SSE42 inline void shufti_run_sse42(const unsigned char*& p, size_t& rem, size_t& count,
+                                               const character_class& cc) {
+    const __m128i upper_lut = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cc.upper_nibble_table.data()));
+    const __m128i lower_lut = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cc.lower_nibble_table.data()));
+    const __m128i nibble_mask = _mm_set1_epi8(0x0F);
+    while (rem >= 16 && (MaxCount == 0 || count + 16 <= MaxCount)) {
+        __m128i input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        __m128i un = _mm_and_si128(_mm_srli_epi16(input, 4), nibble_mask);
+        __m128i ln = _mm_and_si128(input, nibble_mask);
+        int mask =
+            _mm_movemask_epi8(_mm_and_si128(_mm_shuffle_epi8(upper_lut, un), _mm_shuffle_epi8(lower_lut, ln)));
+        if constexpr (Negated) {
+            if (mask == 0) {
+                count += 16;
+                p += 16;
+                rem -= 16;
+                continue;
+            }
+            int fp = CTRE_CTZ(mask);
+            count += fp;
+            p += fp;
+            rem -= fp;
+            if (rem > 0 && cc.exact_membership[*p])
+                break;
+            ++count;
+            ++p;
+            --rem;
+        } else {
+            if (mask == 0)
+                break;
+            // Only check bytes that are actually available
+            int check_count = (rem < 16) ? static_cast<int>(rem) : 16;
+            for (int i = 0; i < check_count; ++i) {
+                if (!cc.exact_membership[p[i]]) {
+                    p += i;
+                    rem -= i;
+                    return;
+                }
+                ++count;
+            }
+            p += check_count;
+            rem -= check_count;
+        }
+    }
+}
+
+template <bool Negated, size_t MaxCount>
+CTRE_TARGET_AVX2 inline void shufti_run_avx2(const unsigned char*& p, size_t& rem, size_t& count,
+                                             const character_class& cc) {
+    if (rem < 32)
+        return shufti_run_sse42<Negated, MaxCount>(p, rem, count, cc);
+    const __m256i upper_lut = _mm256_broadcastsi128_si256(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(cc.upper_nibble_table.data())));
+    const __m256i lower_lut = _mm256_broadcastsi128_si256(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(cc.lower_nibble_table.data())));
+    const __m256i nibble_mask = _mm256_set1_epi8(0x0F);
+    while (rem >= 32 && (MaxCount == 0 || count + 32 <= MaxCount)) {
+        __m256i input = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        __m256i un = _mm256_and_si256(_mm256_srli_epi16(input, 4), nibble_mask);
+        __m256i ln = _mm256_and_si256(input, nibble_mask);
+        int mask = _mm256_movemask_epi8(
+            _mm256_and_si256(_mm256_shuffle_epi8(upper_lut, un), _mm256_shuffle_epi8(lower_lut, ln)));
+        if constexpr (Negated) {
+            if (mask == 0) {
+                count += 32;
+                p += 32;
+                rem -= 32;
+                continue;
+            }
+            int fp = CTRE_CTZ(mask);
+            count += fp;
+            p += fp;
+            rem -= fp;
+            if (rem > 0 && cc.exact_membership[*p])
+                break;
+            ++count;
+            ++p;
+            --rem;
+        } else {
+            if (mask == 0)
+                break;
+            // Only check bytes that are actually available
+            int check_count = (rem < 32) ? static_cast<int>(rem) : 32;
+            for (int i = 0; i < check_count; ++i) {
+                if (!cc.exact_membership[p[i]]) {
+                    p += i;
+                    rem -= i;
+                    return;
+                }
+                ++count;
+            }
+            p += check_count;
+            rem -= check_count;
+        }
+    }
+}
+#else
+template <bool Negated, size_t MaxCount>
+inline void shufti_run_sse42(const unsigned char*&, size_t&, size_t&, const character_class&) {}
+template <bool Negated, size_t MaxCount>
+inline void shufti_run_avx2(const unsigned char*&, size_t&, size_t&, const character_class&) {}
+#endif // CTRE_ARCH_X86
+
 // Shufti repetition matching
 template <typename PatternType, size_t MinCount, size_t MaxCount, typename Iterator, typename EndIterator>
 inline Iterator match_pattern_repeat_shufti(Iterator current, EndIterator last, const flags&) {
@@ -661,101 +770,11 @@ inline Iterator match_pattern_repeat_shufti(Iterator current, EndIterator last,
         const unsigned char* end_ptr = get_end_pointer(current, last);
         size_t count = 0, rem = static_cast<size_t>(end_ptr - p);
 
-#if defined(CTRE_ARCH_X86) && (defined(__SSE4_2__) || defined(__SSSE3__) || defined(__SSE2__))
-        if (rem >= 16 && rem < 32) {
-            const __m128i upper_lut = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cc.upper_nibble_table.data()));
-            const __m128i lower_lut = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cc.lower_nibble_table.data()));
-            const __m128i nibble_mask = _mm_set1_epi8(0x0F);
-            while (rem >= 16 && (MaxCount == 0 || count + 16 <= MaxCount)) {
-                __m128i input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
-                __m128i un = _mm_and_si128(_mm_srli_epi16(input, 4), nibble_mask);
-                __m128i ln = _mm_and_si128(input, nibble_mask);
-                int mask =
-                    _mm_movemask_epi8(_mm_and_si128(_mm_shuffle_epi8(upper_lut, un), _mm_shuffle_epi8(lower_lut, ln)));
-                if constexpr (shufti_pattern_trait<PatternType>::is_negated) {
-                    if (mask == 0) {
-                        count += 16;
-                        p += 16;
-                        rem -= 16;
-                        continue;
-                    }
-                    int fp = CTRE_CTZ(mask);
-                    count += fp;
-                    p += fp;
-                    rem -= fp;
-                    if (rem > 0 && cc.exact_membership[*p])
-                        break;
-                    ++count;
-                    ++p;
-                    --rem;
-                } else {
-                    if (mask == 0)
-                        break;
-                    // Only check bytes that are actually available
-                    int check_count = (rem < 16) ? static_cast<int>(rem) : 16;
-                    for (int i = 0; i < check_count; ++i) {
-                        if (!cc.exact_membership[p[i]]) {
-                            p += i;
-                            goto done_sse;
-                        }
-                        ++count;
-                    }
-                    p += check_count;
-                    rem -= check_count;
-                }
-            }
-        done_sse:;
-        }
-#endif
-
-#if defined(CTRE_ARCH_X86) && defined(__AVX2__)
-        if (rem >= 32) {
-            const __m256i upper_lut = _mm256_broadcastsi128_si256(
-                _mm_loadu_si128(reinterpret_cast<const __m128i*>(cc.upper_nibble_table.data())));
-            const __m256i lower_lut = _mm256_broadcastsi128_si256(
-                _mm_loadu_si128(reinterpret_cast<const __m128i*>(cc.lower_nibble_table.data())));
-            const __m256i nibble_mask = _mm256_set1_epi8(0x0F);
-            while (rem >= 32 && (MaxCount == 0 || count + 32 <= MaxCount)) {
-                __m256i input = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
-                __m256i un = _mm256_and_si256(_mm256_srli_epi16(input, 4), nibble_mask);
-                __m256i ln = _mm256_and_si256(input, nibble_mask);
-                int mask = _mm256_movemask_epi8(
-                    _mm256_and_si256(_mm256_shuffle_epi8(upper_lut, un), _mm256_shuffle_epi8(lower_lut, ln)));
-                if constexpr (shufti_pattern_trait<PatternType>::is_negated) {
-                    if (mask == 0) {
-                        count += 32;
-                        p += 32;
-                        rem -= 32;
-                        continue;
-                    }
-                    int fp = CTRE_CTZ(mask);
-                    count += fp;
-                    p += fp;
-                    rem -= fp;
-                    if (rem > 0 && cc.exact_membership[*p])
-                        break;
-                    ++count;
-                    ++p;
-                    --rem;
-                } else {
-                    if (mask == 0)
-                        break;
-                    // Only check bytes that are actually available
-                    int check_count = (rem < 32) ? static_cast<int>(rem) : 32;
-                    for (int i = 0; i < check_count; ++i) {
-                        if (!cc.exact_membership[p[i]]) {
-                            p += i;
-                            goto done_avx2;
-                        }
-                        ++count;
-                    }
-                    p += check_count;
-                    rem -= check_count;
-                }
-            }
-        done_avx2:;
+        if (rem >= 16) {
+            constexpr bool negated = shufti_pattern_trait<PatternType>::is_negated;
+            dispatch_kernel<&shufti_run_avx2<negated, MaxCount>, &shufti_run_sse42<negated, MaxCount>,
+                            &shufti_run_scalar<negated, MaxCount>>(p, rem, count, cc);
         }
-#endif
 
         while (rem > 0 && (MaxCount == 0 || count < MaxCount)) {
             bool matches =
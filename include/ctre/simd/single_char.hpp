@@ -9,20 +9,30 @@
 
 namespace ctre::simd {
 
+template <char C, size_t MaxCount = 0>
+[[nodiscard]] inline size_t match_single_char_scalar(const char* data, size_t length) noexcept {
+    size_t count = 0;
+    for (size_t i = 0; i < length && (MaxCount == 0 || count < MaxCount); ++i) {
+        if (data[i] == C) ++count;
+        else break;
+    }
+    return count;
+}
+
 #ifdef CTRE_ARCH_X86
 template <char C, size_t MaxCount = 0>
-[[nodiscard]] inline size_t match_single_char_avx2(const char* data, size_t length) noexcept {
+[[nodiscard]] CTRE_TARGET_SSE42 inline size_t match_single_char_sse42(const char* data, size_t length) noexcept {
     const char* p = data;
     size_t remaining = length;
     size_t count = 0;
-    __m256i target = _mm256_set1_epi8(C);
+    __m128i target = _mm_set1_epi8(C);
 
-    while (remaining >= 32 && (MaxCount == 0 || count + 32 <= MaxCount)) {
-        __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
-        uint32_t mask = _mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, target));
-        if (static_cast<unsigned>(mask) == AVX2_FULL_MASK) { p += 32; count += 32; remaining -= 32; }
+    while (remaining >= 16 && (MaxCount == 0 || count + 16 <= MaxCount)) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        uint16_t mask = _mm_movemask_epi8(_mm_cmpeq_epi8(chunk, target));
+        if (static_cast<unsigned>(mask) == SSE_FULL_MASK) { p += 16; count += 16; remaining -= 16; }
         else if (mask == 0) break;
-        else { int m = CTRE_CTZ(~mask); count += m; break; }
+        else { int m = CTRE_CTZ(~static_cast<uint32_t>(mask)); p += m; count += m; remaining -= m; break; }
     }
 
     while (remaining > 0 && (MaxCount == 0 || count < MaxCount)) {
@@ -33,18 +43,19 @@ template <char C, size_t MaxCount = 0>
 }
 
 template <char C, size_t MaxCount = 0>
-[[nodiscard]] inline size_t match_single_char_sse42(const char* data, size_t length) noexcept {
+[[nodiscard]] CTRE_TARGET_AVX2 inline size_t match_single_char_avx2(const char* data, size_t length) noexcept {
+    if (length < 32) return match_single_char_sse42<C, MaxCount>(data, length);
     const char* p = data;
     size_t remaining = length;
     size_t count = 0;
-    __m128i target = _mm_set1_epi8(C);
+    __m256i target = _mm256_set1_epi8(C);
 
-    while (remaining >= 16 && (MaxCount == 0 || count + 16 <= MaxCount)) {
-        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
-        uint16_t mask = _mm_movemask_epi8(_mm_cmpeq_epi8(chunk, target));
-        if (static_cast<unsigned>(mask) == SSE_FULL_MASK) { p += 16; count += 16; remaining -= 16; }
+    while (remaining >= 32 && (MaxCount == 0 || count + 32 <= MaxCount)) {
+        __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        uint32_t mask = _mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, target));
+        if (static_cast<unsigned>(mask) == AVX2_FULL_MASK) { p += 32; count += 32; remaining -= 32; }
         else if (mask == 0) break;
-        else { int m = CTRE_CTZ(~static_cast<uint32_t>(mask)); count += m; break; }
+        else { int m = CTRE_CTZ(~mask); p += m; count += m; remaining -= m; break; }
     }
 
     while (remaining > 0 && (MaxCount == 0 || count < MaxCount)) {
@@ -64,26 +75,11 @@ template <char C, size_t MaxCount = 0>
 }
 #endif // CTRE_ARCH_X86
 
-template <char C, size_t MaxCount = 0>
-[[nodiscard]] inline size_t match_single_char_scalar(const char* data, size_t length) noexcept {
-    size_t count = 0;
-    for (size_t i = 0; i < length && (MaxCount == 0 || count < MaxCount); ++i) {
-        if (data[i] == C) ++count;
-        else break;
-    }
-    return count;
-}
-
 template <char C, size_t MaxCount = 0>
 [[nodiscard]] inline size_t match_single_char_repeat(const char* data, size_t length) noexcept {
-#ifdef __AVX2__
-    if (length >= 16 && length < 32) return match_single_char_sse42<C, MaxCount>(data, length);
-    return match_single_char_avx2<C, MaxCount>(data, length);
-#elif defined(__SSE4_2__) || defined(__SSE2__)
-    return match_single_char_sse42<C, MaxCount>(data, length);
-#else
-    return match_single_char_scalar<C, MaxCount>(data, length);
-#endif
+    if (length < 16) return match_single_char_scalar<C, MaxCount>(data, length);
+    return dispatch_kernel<&match_single_char_avx2<C, MaxCount>, &match_single_char_sse42<C, MaxCount>,
+                           &match_single_char_scalar<C, MaxCount>>(data, length);
 }
 
 } // namespace ctre::simd
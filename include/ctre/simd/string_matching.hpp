@@ -6,153 +6,114 @@
 #include "detection.hpp"
 #ifdef CTRE_ARCH_X86
 #include <immintrin.h>
-#include <nmmintrin.h>
 #endif
 #include <iterator>
+#include <memory>
+#include <type_traits>
 
-namespace ctre::simd {
-
-template <typename Iterator, typename EndIterator>
-[[nodiscard]] inline bool match_string_avx2_impl(Iterator& current, EndIterator last,
-                                                  [[maybe_unused]] const flags& f,
-                                                  const char* string_chars, size_t string_length) noexcept;
-template <typename Iterator, typename EndIterator>
-[[nodiscard]] inline bool match_string_sse42_impl(Iterator& current, EndIterator last,
-                                                   [[maybe_unused]] const flags& f,
-                                                   const char* string_chars, size_t string_length) noexcept;
-template <typename Iterator, typename EndIterator>
-[[nodiscard]] inline bool match_string_scalar_impl(Iterator& current, EndIterator last,
-                                                    [[maybe_unused]] const flags& f,
-                                                    const char* string_chars, size_t string_length) noexcept;
+// Literal comparison for patterns of SIMD_STRING_THRESHOLD characters or more. Code
+// units are equal when their bytes are, so one byte kernel serves char, char16_t,
+// char32_t and wchar_t subjects alike. Under (?i) LOWERCASE_BIT is OR-ed into the
+// low byte of every ASCII letter on both sides, as character::match_char folds them.
 
-template <auto... String, typename Iterator, typename EndIterator>
-[[nodiscard]] inline bool match_string_simd(Iterator& current, EndIterator last, const flags& f) noexcept {
-    constexpr size_t string_length = sizeof...(String);
-    constexpr char string_chars[] = {static_cast<char>(String)...};
-
-    if constexpr (CTRE_SIMD_ENABLED) {
-        if (get_simd_capability() >= SIMD_CAPABILITY_AVX2 && string_length >= 32)
-            return match_string_avx2_impl(current, last, f, string_chars, string_length);
-        else if (get_simd_capability() >= SIMD_CAPABILITY_SSE42 && string_length >= 16)
-            return match_string_sse42_impl(current, last, f, string_chars, string_length);
-    }
-    return match_string_scalar_impl(current, last, f, string_chars, string_length);
-}
-
-#ifdef CTRE_ARCH_X86
-template <typename Iterator, typename EndIterator>
-[[nodiscard]] inline bool match_string_avx2_impl(Iterator& current, [[maybe_unused]] EndIterator last,
-                                                  [[maybe_unused]] const flags& f,
-                                                  const char* string_chars, size_t string_length) noexcept {
-    Iterator pos = current;
-    size_t processed = 0;
-
-    while (processed + 64 <= string_length) {
-        if (processed + 128 <= string_length) {
-            __builtin_prefetch(&*(pos + 64), 0, 3);
-            __builtin_prefetch(&string_chars[processed + 64], 0, 3);
-        }
-        __m256i data1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&*pos));
-        __m256i data2 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&*(pos + 32)));
-        __m256i pattern1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&string_chars[processed]));
-        __m256i pattern2 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&string_chars[processed + 32]));
-        __m256i result1 = _mm256_cmpeq_epi8(data1, pattern1);
-        __m256i result2 = _mm256_cmpeq_epi8(data2, pattern2);
-        if (static_cast<unsigned>(_mm256_movemask_epi8(result1)) != 0xFFFFFFFFU ||
-            static_cast<unsigned>(_mm256_movemask_epi8(result2)) != 0xFFFFFFFFU)
-            return false;
-        pos += 64;
-        processed += 64;
-    }
-
-    if (processed + 32 <= string_length) {
-        __m256i data = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&*pos));
-        __m256i pattern = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&string_chars[processed]));
-        if (static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(data, pattern))) != 0xFFFFFFFFU)
-            return false;
-        pos += 32;
-        processed += 32;
-    }
+namespace ctre::simd {
 
-    if (processed + 16 <= string_length) {
-        __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&*pos));
-        __m128i pattern = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&string_chars[processed]));
-        if (static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(data, pattern))) != 0xFFFFU)
-            return false;
-        pos += 16;
-        processed += 16;
+template <typename CharT, auto... String>
+struct literal_units {
+    static constexpr CharT fold_of(CharT c) noexcept {
+        return ::ctre::is_ascii_alpha(c) ? CharT{LOWERCASE_BIT} : CharT{0};
     }
 
-    for (size_t i = processed; i < string_length; ++i) {
-        if (*pos != string_chars[i]) return false;
-        ++pos;
+    static constexpr CharT exact[] = {static_cast<CharT>(String)...};
+    static constexpr CharT fold[] = {fold_of(static_cast<CharT>(String))...};
+    static constexpr CharT folded[] = {
+        static_cast<CharT>(static_cast<CharT>(String) | fold_of(static_cast<CharT>(String)))...};
+};
+
+// Whether (s[i] | fold[i]) == literal[i] for all of the n bytes; fold is unused when exact
+template <bool Caseless>
+[[nodiscard]] inline bool equal_bytes_scalar(const unsigned char* s, const unsigned char* literal,
+                                             const unsigned char* fold, size_t n) noexcept {
+    for (size_t i = 0; i < n; ++i) {
+        const unsigned char c = Caseless ? static_cast<unsigned char>(s[i] | fold[i]) : s[i];
+        if (c != literal[i]) return false;
     }
-    current = pos;
     return true;
 }
 
-template <typename Iterator, typename EndIterator>
-[[nodiscard]] inline bool match_string_sse42_impl(Iterator& current, [[maybe_unused]] EndIterator last,
-                                                   [[maybe_unused]] const flags& f,
-                                                   const char* string_chars, size_t string_length) noexcept {
-    Iterator pos = current;
-
-    if (string_length <= 16) {
-        __m128i pattern = _mm_setzero_si128();
-        if (string_length == 16) {
-            pattern = _mm_loadu_si128(reinterpret_cast<const __m128i*>(string_chars));
-        } else {
-            char padded[16] = {0};
-            for (size_t i = 0; i < string_length; ++i) padded[i] = string_chars[i];
-            pattern = _mm_loadu_si128(reinterpret_cast<const __m128i*>(padded));
-        }
-        __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&*pos));
-        if (_mm_cmpistri(pattern, data, 0x18) < static_cast<int>(string_length)) return false;
-        current = pos + string_length;
-        return true;
-    }
-
-    size_t processed = 0;
-    while (processed + 16 <= string_length) {
-        __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&*pos));
-        __m128i pattern = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&string_chars[processed]));
-        if (static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(data, pattern))) != 0xFFFFU)
-            return false;
-        pos += 16;
-        processed += 16;
+#if CTRE_SIMD_ENABLED && defined(CTRE_ARCH_X86)
+template <bool Caseless>
+[[nodiscard]] CTRE_TARGET_SSE42 inline bool equal_bytes_sse42(const unsigned char* s, const unsigned char* literal,
+                                                              const unsigned char* fold, size_t n) noexcept {
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i));
+        if constexpr (Caseless) data = _mm_or_si128(data, _mm_loadu_si128(reinterpret_cast<const __m128i*>(fold + i)));
+        const __m128i expected = _mm_loadu_si128(reinterpret_cast<const __m128i*>(literal + i));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(data, expected)) != 0xFFFF) return false;
     }
+    return equal_bytes_scalar<Caseless>(s + i, literal + i, fold + i, n - i);
+}
 
-    for (size_t i = processed; i < string_length; ++i) {
-        if (*pos != string_chars[i]) return false;
-        ++pos;
+template <bool Caseless>
+[[nodiscard]] CTRE_TARGET_AVX2 inline bool equal_bytes_avx2(const unsigned char* s, const unsigned char* literal,
+                                                            const unsigned char* fold, size_t n) noexcept {
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        __m256i data = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + i));
+        if constexpr (Caseless)
+            data = _mm256_or_si256(data, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(fold + i)));
+        const __m256i expected = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(literal + i));
+        if (static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(data, expected))) != 0xFFFFFFFFu) return false;
     }
-    current = pos;
-    return true;
+    return equal_bytes_sse42<Caseless>(s + i, literal + i, fold + i, n - i);
 }
 #else
-template <typename Iterator, typename EndIterator>
-[[nodiscard]] inline bool match_string_avx2_impl(Iterator& current, EndIterator last,
-                                                  const flags& f,
-                                                  const char* string_chars, size_t string_length) noexcept {
-    return match_string_scalar_impl(current, last, f, string_chars, string_length);
+template <bool Caseless>
+[[nodiscard]] inline bool equal_bytes_sse42(const unsigned char* s, const unsigned char* literal,
+                                            const unsigned char* fold, size_t n) noexcept {
+    return equal_bytes_scalar<Caseless>(s, literal, fold, n);
 }
-template <typename Iterator, typename EndIterator>
-[[nodiscard]] inline bool match_string_sse42_impl(Iterator& current, EndIterator last,
-                                                   const flags& f,
-                                                   const char* string_chars, size_t string_length) noexcept {
-    return match_string_scalar_impl(current, last, f, string_chars, string_length);
+
+template <bool Caseless>
+[[nodiscard]] inline bool equal_bytes_avx2(const unsigned char* s, const unsigned char* literal,
+                                           const unsigned char* fold, size_t n) noexcept {
+    return equal_bytes_scalar<Caseless>(s, literal, fold, n);
+}
+#endif
+
+template <bool Caseless>
+[[nodiscard]] inline bool equal_bytes(const unsigned char* s, const unsigned char* literal, const unsigned char* fold,
+                                      size_t n) noexcept {
+    return dispatch_kernel<&equal_bytes_avx2<Caseless>, &equal_bytes_sse42<Caseless>, &equal_bytes_scalar<Caseless>>(
+        s, literal, fold, n);
 }
-#endif // CTRE_ARCH_X86
 
-template <typename Iterator, typename EndIterator>
-[[nodiscard]] inline bool match_string_scalar_impl(Iterator& current, EndIterator last,
-                                                    [[maybe_unused]] const flags& f,
-                                                    const char* string_chars, size_t string_length) noexcept {
-    for (size_t i = 0; i < string_length; ++i) {
-        if (current == last || *current != string_chars[i]) return false;
-        ++current;
+template <auto... String, typename Iterator, typename EndIterator>
+[[nodiscard]] inline bool match_string_simd(Iterator& current, EndIterator last, const flags& f) noexcept {
+    using char_type = std::remove_cv_t<std::remove_reference_t<decltype(*current)>>;
+    constexpr size_t length = sizeof...(String);
+    // Pattern characters the subject's code unit cannot hold are left to match_char
+    constexpr bool representable = ((static_cast<decltype(String)>(static_cast<char_type>(String)) == String) && ...);
+
+    if constexpr (std::contiguous_iterator<Iterator> && std::sized_sentinel_for<EndIterator, Iterator> &&
+                  std::is_integral_v<char_type> && (sizeof(char_type) == 1 || sizeof(char_type) == 2 ||
+                                                    sizeof(char_type) == 4) && representable) {
+        if (last - current < static_cast<std::ptrdiff_t>(length)) return false;
+
+        using units = literal_units<char_type, String...>;
+        const auto* s = reinterpret_cast<const unsigned char*>(std::to_address(current));
+        constexpr size_t bytes = length * sizeof(char_type);
+        const auto* exact = reinterpret_cast<const unsigned char*>(units::exact);
+        const bool equal = is_case_insensitive(f)
+                               ? equal_bytes<true>(s, reinterpret_cast<const unsigned char*>(units::folded),
+                                                   reinterpret_cast<const unsigned char*>(units::fold), bytes)
+                               : equal_bytes<false>(s, exact, exact, bytes);
+        if (equal) current += length;
+        return equal;
+    } else {
+        return ((current != last && character<String>::match_char(*current++, f)) && ... && true);
     }
-    return true;
 }
 
 } // namespace ctre::simd
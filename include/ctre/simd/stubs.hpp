@@ -47,6 +47,16 @@ template <typename Pattern, typename A, typename B, typename Iterator>
     return begin;
 }
 
+template <typename T, typename Iterator, typename EndIterator>
+[[nodiscard]] consteval bool wide_repeat_viable() noexcept {
+    return false;
+}
+
+template <typename T, typename Iterator, typename EndIterator>
+[[nodiscard]] size_t wide_class_run(Iterator, EndIterator, size_t, const flags&) noexcept {
+    return 0;
+}
+
 } // namespace ctre::simd
 
 #endif
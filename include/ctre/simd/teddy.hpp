@@ -0,0 +1,182 @@
+#ifndef CTRE__SIMD_TEDDY__HPP
+#define CTRE__SIMD_TEDDY__HPP
+
+#include "../multi_literal.hpp"
+#include "detection.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#ifdef CTRE_ARCH_X86
+#include <immintrin.h>
+#endif
+
+// Teddy multi-literal search (Hyperscan): literals are spread over 8 buckets and
+// the first 1-3 bytes of every literal are fingerprinted in nibble tables. One
+// PSHUFB pair per fingerprint byte yields, for each input byte, the buckets that
+// may start there; candidates are then verified against the full literals.
+
+namespace ctre::simd {
+
+inline constexpr size_t TEDDY_BUCKETS = 8;
+inline constexpr size_t TEDDY_MAX_FINGERPRINT = 3;
+
+template <size_t MaxLiterals, size_t MaxLiteralLen>
+struct teddy_masks {
+    std::array<std::array<uint8_t, 16>, TEDDY_MAX_FINGERPRINT> lo{};
+    std::array<std::array<uint8_t, 16>, TEDDY_MAX_FINGERPRINT> hi{};
+    size_t fingerprint = 0; // bytes of each literal used in the tables
+    multi_literal_result<MaxLiterals, MaxLiteralLen> literals{};
+
+    [[nodiscard]] constexpr uint8_t buckets_at(size_t j, unsigned char c) const noexcept {
+        return static_cast<uint8_t>(lo[j][c & 0xF] & hi[j][c >> 4]);
+    }
+};
+
+template <size_t MaxLiterals, size_t MaxLiteralLen>
+[[nodiscard]] constexpr auto make_teddy_masks(const multi_literal_result<MaxLiterals, MaxLiteralLen>& lits) noexcept {
+    teddy_masks<MaxLiterals, MaxLiteralLen> t;
+    t.literals = lits;
+    if (lits.count == 0) return t;
+
+    size_t shortest = lits.literals[0].length;
+    for (size_t i = 1; i < lits.count; ++i)
+        if (lits.literals[i].length < shortest) shortest = lits.literals[i].length;
+    t.fingerprint = shortest < TEDDY_MAX_FINGERPRINT ? shortest : TEDDY_MAX_FINGERPRINT;
+
+    for (size_t i = 0; i < lits.count; ++i) {
+        const uint8_t bucket = static_cast<uint8_t>(1u << (i % TEDDY_BUCKETS));
+        for (size_t j = 0; j < t.fingerprint; ++j) {
+            const auto c = static_cast<unsigned char>(lits.literals[i].chars[j]);
+            t.lo[j][c & 0xF] |= bucket;
+            t.hi[j][c >> 4] |= bucket;
+        }
+    }
+    return t;
+}
+
+// Check the literals of the given buckets at pos; true if one matches completely
+template <size_t MaxLiterals, size_t MaxLiteralLen>
+[[nodiscard]] inline bool teddy_verify(const teddy_masks<MaxLiterals, MaxLiteralLen>& t, uint8_t buckets,
+                                       const char* pos, const char* end) noexcept {
+    for (size_t i = 0; i < t.literals.count; ++i) {
+        if (!(buckets & (1u << (i % TEDDY_BUCKETS)))) continue;
+        const auto& lit = t.literals.literals[i];
+        if (static_cast<size_t>(end - pos) < lit.length) continue;
+        // A byte loop: GCC cannot bound memcmp's read by lit.length and warns at -O1
+        size_t j = 0;
+        while (j < lit.length && pos[j] == lit.chars[j]) ++j;
+        if (j == lit.length) return true;
+    }
+    return false;
+}
+
+template <size_t MaxLiterals, size_t MaxLiteralLen>
+[[nodiscard]] inline const char* teddy_find_scalar(const teddy_masks<MaxLiterals, MaxLiteralLen>& t,
+                                                   const char* begin, const char* end) noexcept {
+    if (static_cast<size_t>(end - begin) < t.fingerprint) return end;
+    for (const char* p = begin; p + t.fingerprint <= end; ++p) {
+        uint8_t buckets = 0xFF;
+        for (size_t j = 0; j < t.fingerprint && buckets; ++j)
+            buckets &= t.buckets_at(j, static_cast<unsigned char>(p[j]));
+        if (buckets && teddy_verify(t, buckets, p, end)) return p;
+    }
+    return end;
+}
+
+#ifdef CTRE_ARCH_X86
+template <size_t MaxLiterals, size_t MaxLiteralLen>
+[[nodiscard]] CTRE_TARGET_SSE42 inline const char* teddy_find_ssse3(const teddy_masks<MaxLiterals, MaxLiteralLen>& t,
+                                                                    const char* begin, const char* end) noexcept {
+    const __m128i nibble = _mm_set1_epi8(0x0F);
+    __m128i lo[TEDDY_MAX_FINGERPRINT];
+    __m128i hi[TEDDY_MAX_FINGERPRINT];
+    for (size_t j = 0; j < t.fingerprint; ++j) {
+        lo[j] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(t.lo[j].data()));
+        hi[j] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(t.hi[j].data()));
+    }
+
+    const char* p = begin;
+    while (end - p >= static_cast<std::ptrdiff_t>(16 + t.fingerprint - 1)) {
+        __m128i res = _mm_set1_epi8(static_cast<char>(0xFF));
+        for (size_t j = 0; j < t.fingerprint; ++j) {
+            __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + j));
+            __m128i l = _mm_shuffle_epi8(lo[j], _mm_and_si128(data, nibble));
+            __m128i h = _mm_shuffle_epi8(hi[j], _mm_and_si128(_mm_srli_epi16(data, 4), nibble));
+            res = _mm_and_si128(res, _mm_and_si128(l, h));
+        }
+        auto candidates = static_cast<uint32_t>(~_mm_movemask_epi8(_mm_cmpeq_epi8(res, _mm_setzero_si128())) & 0xFFFF);
+        if (candidates) {
+            alignas(16) uint8_t buckets[16];
+            _mm_store_si128(reinterpret_cast<__m128i*>(buckets), res);
+            while (candidates) {
+                const auto k = static_cast<size_t>(CTRE_CTZ(candidates));
+                if (teddy_verify(t, buckets[k], p + k, end)) return p + k;
+                candidates &= candidates - 1;
+            }
+        }
+        p += 16;
+    }
+    return teddy_find_scalar(t, p, end);
+}
+
+template <size_t MaxLiterals, size_t MaxLiteralLen>
+[[nodiscard]] CTRE_TARGET_AVX2 inline const char* teddy_find_avx2(const teddy_masks<MaxLiterals, MaxLiteralLen>& t,
+                                                                  const char* begin, const char* end) noexcept {
+    const __m256i nibble = _mm256_set1_epi8(0x0F);
+    __m256i lo[TEDDY_MAX_FINGERPRINT];
+    __m256i hi[TEDDY_MAX_FINGERPRINT];
+    for (size_t j = 0; j < t.fingerprint; ++j) {
+        lo[j] = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(t.lo[j].data())));
+        hi[j] = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(t.hi[j].data())));
+    }
+
+    const char* p = begin;
+    while (end - p >= static_cast<std::ptrdiff_t>(32 + t.fingerprint - 1)) {
+        __m256i res = _mm256_set1_epi8(static_cast<char>(0xFF));
+        for (size_t j = 0; j < t.fingerprint; ++j) {
+            __m256i data = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + j));
+            __m256i l = _mm256_shuffle_epi8(lo[j], _mm256_and_si256(data, nibble));
+            __m256i h = _mm256_shuffle_epi8(hi[j], _mm256_and_si256(_mm256_srli_epi16(data, 4), nibble));
+            res = _mm256_and_si256(res, _mm256_and_si256(l, h));
+        }
+        auto candidates = ~static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(res, _mm256_setzero_si256())));
+        if (candidates) {
+            alignas(32) uint8_t buckets[32];
+            _mm256_store_si256(reinterpret_cast<__m256i*>(buckets), res);
+            while (candidates) {
+                const auto k = static_cast<size_t>(CTRE_CTZ(candidates));
+                if (teddy_verify(t, buckets[k], p + k, end)) return p + k;
+                candidates &= candidates - 1;
+            }
+        }
+        p += 32;
+    }
+    return teddy_find_ssse3(t, p, end);
+}
+#else
+template <size_t MaxLiterals, size_t MaxLiteralLen>
+[[nodiscard]] inline const char* teddy_find_ssse3(const teddy_masks<MaxLiterals, MaxLiteralLen>& t, const char* begin,
+                                                  const char* end) noexcept {
+    return teddy_find_scalar(t, begin, end);
+}
+
+template <size_t MaxLiterals, size_t MaxLiteralLen>
+[[nodiscard]] inline const char* teddy_find_avx2(const teddy_masks<MaxLiterals, MaxLiteralLen>& t, const char* begin,
+                                                 const char* end) noexcept {
+    return teddy_find_scalar(t, begin, end);
+}
+#endif // CTRE_ARCH_X86
+
+// First position in [begin, end) where one of the literals occurs, or end
+template <size_t MaxLiterals, size_t MaxLiteralLen>
+[[nodiscard]] inline const char* teddy_find(const teddy_masks<MaxLiterals, MaxLiteralLen>& t, const char* begin,
+                                            const char* end) noexcept {
+    if (t.fingerprint == 0) return begin;
+    if (end - begin < 16) return teddy_find_scalar(t, begin, end);
+    return dispatch_kernel<&teddy_find_avx2<MaxLiterals, MaxLiteralLen>, &teddy_find_ssse3<MaxLiterals, MaxLiteralLen>,
+                           &teddy_find_scalar<MaxLiterals, MaxLiteralLen>>(t, begin, end);
+}
+
+} // namespace ctre::simd
+
+#endif // CTRE__SIMD_TEDDY__HPP
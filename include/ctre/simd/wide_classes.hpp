@@ -0,0 +1,231 @@
+#ifndef CTRE__SIMD_WIDE_CLASSES__HPP
+#define CTRE__SIMD_WIDE_CLASSES__HPP
+
+#include "../atoms_characters.hpp"
+#include "../flags_and_modes.hpp"
+#include "detection.hpp"
+#include <array>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#if CTRE_SIMD_ENABLED && defined(CTRE_ARCH_X86)
+#include <immintrin.h>
+#endif
+
+// Character classes over wchar_t, char16_t and char32_t subjects. The byte kernels
+// (shufti, multirange) index 256-entry tables; a wide class is instead a short list
+// of code unit ranges, each tested on 16- or 32-bit lanes with a subtract and an
+// unsigned min: c is in [low, low + span] iff min(c - low, span) == c - low.
+
+namespace ctre::simd {
+
+template <typename CharT>
+inline constexpr bool is_wide_char_v =
+    std::is_same_v<CharT, wchar_t> || std::is_same_v<CharT, char16_t> || std::is_same_v<CharT, char32_t>;
+
+template <typename CharT>
+using wide_lane_t = std::conditional_t<sizeof(CharT) == 2, uint16_t, uint32_t>;
+
+// Each range costs two vector operations; past this the match_char loop is as fast
+inline constexpr size_t WIDE_CLASS_MAX_RANGES = 8;
+
+struct wide_class {
+    std::array<uint32_t, WIDE_CLASS_MAX_RANGES> low{};
+    std::array<uint32_t, WIDE_CLASS_MAX_RANGES> span{};
+    size_t count = 0;
+    bool negated = false;
+    bool usable = false;
+
+    // Ranges beyond the lane are clipped, they cannot match a code unit anyway
+    constexpr bool add(int64_t from, int64_t to, int64_t lane_max) noexcept {
+        if (from < 0 || to > INT32_MAX) return false;
+        if (from > to || from > lane_max) return true;
+        if (count == WIDE_CLASS_MAX_RANGES) return false;
+        low[count] = static_cast<uint32_t>(from);
+        span[count] = static_cast<uint32_t>((to < lane_max ? to : lane_max) - from);
+        ++count;
+        return true;
+    }
+
+    [[nodiscard]] constexpr bool contains(uint32_t c) const noexcept {
+        bool in = false;
+        for (size_t i = 0; i < count; ++i) in = in || (c - low[i] <= span[i]);
+        return in != negated;
+    }
+};
+
+// Ranges of an atom, folded the way its match_char folds under (?i)
+template <typename T>
+constexpr bool add_wide_class(wide_class&, int64_t, bool, T*) noexcept {
+    return false;
+}
+
+template <auto V>
+constexpr bool add_wide_class(wide_class& out, int64_t lane_max, bool caseless, character<V>*) noexcept {
+    const auto v = static_cast<int64_t>(V);
+    if (caseless && ::ctre::is_ascii_alpha(V) && !out.add(v ^ 0x20, v ^ 0x20, lane_max)) return false;
+    return out.add(v, v, lane_max);
+}
+
+template <auto A, auto B>
+constexpr bool add_wide_class(wide_class& out, int64_t lane_max, bool caseless, char_range<A, B>*) noexcept {
+    const auto a = static_cast<int64_t>(A);
+    const auto b = static_cast<int64_t>(B);
+    const bool same_case = (is_ascii_alpha_lowercase(A) && is_ascii_alpha_lowercase(B)) ||
+                           (is_ascii_alpha_uppercase(A) && is_ascii_alpha_uppercase(B));
+    if (caseless && same_case && !out.add(a ^ 0x20, b ^ 0x20, lane_max)) return false;
+    return out.add(a, b, lane_max);
+}
+
+template <typename... Content>
+constexpr bool add_wide_class(wide_class& out, int64_t lane_max, bool caseless, set<Content...>*) noexcept {
+    return (add_wide_class(out, lane_max, caseless, static_cast<Content*>(nullptr)) && ... && true);
+}
+
+template <auto... Cs>
+constexpr bool add_wide_class(wide_class& out, int64_t lane_max, bool caseless, enumeration<Cs...>*) noexcept {
+    return (add_wide_class(out, lane_max, caseless, static_cast<character<Cs>*>(nullptr)) && ... && true);
+}
+
+template <typename T> struct wide_class_negation {
+    using positive = T;
+    static constexpr bool negated = false;
+};
+
+template <typename... Content> struct wide_class_negation<negative_set<Content...>> {
+    using positive = set<Content...>;
+    static constexpr bool negated = true;
+};
+
+template <typename T, typename CharT>
+[[nodiscard]] constexpr wide_class make_wide_class(bool caseless) noexcept {
+    using negation = wide_class_negation<T>;
+    wide_class out;
+    out.negated = negation::negated;
+    out.usable = add_wide_class(out, std::numeric_limits<wide_lane_t<CharT>>::max(), caseless,
+                                static_cast<typename negation::positive*>(nullptr));
+    return out;
+}
+
+template <typename T, typename CharT, bool Caseless>
+inline constexpr wide_class wide_class_v = make_wide_class<T, CharT>(Caseless);
+
+// Index of the first of the n code units whose membership in Class equals Stop, or n
+template <typename CharT, const wide_class& Class, bool Stop>
+[[nodiscard]] inline size_t wide_class_scan_scalar(const CharT* p, size_t n) noexcept {
+    for (size_t i = 0; i < n; ++i) {
+        if (Class.contains(static_cast<wide_lane_t<CharT>>(p[i])) == Stop) return i;
+    }
+    return n;
+}
+
+#if CTRE_SIMD_ENABLED && defined(CTRE_ARCH_X86)
+template <typename CharT, const wide_class& Class, bool Stop>
+[[nodiscard]] CTRE_TARGET_SSE42 inline size_t wide_class_scan_sse42(const CharT* p, size_t n) noexcept {
+    constexpr size_t lanes = 16 / sizeof(CharT);
+    size_t i = 0;
+    for (; i + lanes <= n; i += lanes) {
+        const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+        __m128i in = _mm_setzero_si128();
+        for (size_t r = 0; r < Class.count; ++r) {
+            if constexpr (sizeof(CharT) == 2) {
+                const __m128i d = _mm_sub_epi16(data, _mm_set1_epi16(static_cast<short>(Class.low[r])));
+                const __m128i span = _mm_set1_epi16(static_cast<short>(Class.span[r]));
+                in = _mm_or_si128(in, _mm_cmpeq_epi16(_mm_min_epu16(d, span), d));
+            } else {
+                const __m128i d = _mm_sub_epi32(data, _mm_set1_epi32(static_cast<int>(Class.low[r])));
+                const __m128i span = _mm_set1_epi32(static_cast<int>(Class.span[r]));
+                in = _mm_or_si128(in, _mm_cmpeq_epi32(_mm_min_epu32(d, span), d));
+            }
+        }
+        const auto mask = static_cast<unsigned>(_mm_movemask_epi8(in));
+        const unsigned stop = (Stop != Class.negated) ? mask : (~mask & 0xFFFFu);
+        if (stop != 0) return i + static_cast<size_t>(CTRE_CTZ(stop)) / sizeof(CharT);
+    }
+    return i + wide_class_scan_scalar<CharT, Class, Stop>(p + i, n - i);
+}
+
+template <typename CharT, const wide_class& Class, bool Stop>
+[[nodiscard]] CTRE_TARGET_AVX2 inline size_t wide_class_scan_avx2(const CharT* p, size_t n) noexcept {
+    constexpr size_t lanes = 32 / sizeof(CharT);
+    size_t i = 0;
+    for (; i + lanes <= n; i += lanes) {
+        const __m256i data = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i));
+        __m256i in = _mm256_setzero_si256();
+        for (size_t r = 0; r < Class.count; ++r) {
+            if constexpr (sizeof(CharT) == 2) {
+                const __m256i d = _mm256_sub_epi16(data, _mm256_set1_epi16(static_cast<short>(Class.low[r])));
+                const __m256i span = _mm256_set1_epi16(static_cast<short>(Class.span[r]));
+                in = _mm256_or_si256(in, _mm256_cmpeq_epi16(_mm256_min_epu16(d, span), d));
+            } else {
+                const __m256i d = _mm256_sub_epi32(data, _mm256_set1_epi32(static_cast<int>(Class.low[r])));
+                const __m256i span = _mm256_set1_epi32(static_cast<int>(Class.span[r]));
+                in = _mm256_or_si256(in, _mm256_cmpeq_epi32(_mm256_min_epu32(d, span), d));
+            }
+        }
+        const auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(in));
+        const uint32_t stop = (Stop != Class.negated) ? mask : ~mask;
+        if (stop != 0) return i + static_cast<size_t>(CTRE_CTZ(stop)) / sizeof(CharT);
+    }
+    return i + wide_class_scan_sse42<CharT, Class, Stop>(p + i, n - i);
+}
+#else
+template <typename CharT, const wide_class& Class, bool Stop>
+[[nodiscard]] inline size_t wide_class_scan_sse42(const CharT* p, size_t n) noexcept {
+    return wide_class_scan_scalar<CharT, Class, Stop>(p, n);
+}
+
+template <typename CharT, const wide_class& Class, bool Stop>
+[[nodiscard]] inline size_t wide_class_scan_avx2(const CharT* p, size_t n) noexcept {
+    return wide_class_scan_scalar<CharT, Class, Stop>(p, n);
+}
+#endif
+
+template <typename CharT, const wide_class& Class, bool Stop>
+[[nodiscard]] inline size_t wide_class_scan(const CharT* p, size_t n) noexcept {
+    if (n < 16 / sizeof(CharT)) return wide_class_scan_scalar<CharT, Class, Stop>(p, n);
+    return dispatch_kernel<&wide_class_scan_avx2<CharT, Class, Stop>, &wide_class_scan_sse42<CharT, Class, Stop>,
+                           &wide_class_scan_scalar<CharT, Class, Stop>>(p, n);
+}
+
+// Range search: the first code unit in Class, or end
+template <const wide_class& Class, typename CharT>
+[[nodiscard]] inline const CharT* wide_class_find(const CharT* begin, const CharT* end) noexcept {
+    return begin + wide_class_scan<CharT, Class, true>(begin, static_cast<size_t>(end - begin));
+}
+
+// Repetition: a possessive repeat of T takes its run from the lane kernels
+template <typename T, typename Iterator, typename EndIterator>
+[[nodiscard]] consteval bool wide_repeat_viable() noexcept {
+    using char_type = std::remove_cv_t<std::remove_reference_t<decltype(*std::declval<Iterator>())>>;
+    if constexpr (can_use_simd() && is_wide_char_v<char_type> && std::contiguous_iterator<Iterator> &&
+                  std::sized_sentinel_for<EndIterator, Iterator>) {
+        return wide_class_v<T, char_type, false>.usable;
+    } else {
+        return false;
+    }
+}
+
+// Length of the run of T at current, at most max code units (0 for no limit)
+template <typename T, typename Iterator, typename EndIterator>
+[[nodiscard]] inline size_t wide_class_run(Iterator current, EndIterator last, size_t max, const flags& f) noexcept {
+    using char_type = std::remove_cv_t<std::remove_reference_t<decltype(*current)>>;
+    const char_type* p = std::to_address(current);
+    size_t n = static_cast<size_t>(last - current);
+    if (max != 0 && max < n) n = max;
+    if (is_case_insensitive(f)) {
+        // Folding can take the class past WIDE_CLASS_MAX_RANGES; the caller scans on
+        if constexpr (wide_class_v<T, char_type, true>.usable) {
+            return wide_class_scan<char_type, wide_class_v<T, char_type, true>, false>(p, n);
+        } else {
+            return 0;
+        }
+    }
+    return wide_class_scan<char_type, wide_class_v<T, char_type, false>, false>(p, n);
+}
+
+} // namespace ctre::simd
+
+#endif // CTRE__SIMD_WIDE_CLASSES__HPP
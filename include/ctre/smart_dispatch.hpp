@@ -2,6 +2,7 @@
 #define CTRE_SMART_DISPATCH_HPP
 
 #include "bitnfa/integration.hpp"
+#include "dfa/sheng.hpp"
 #include <type_traits>
 
 namespace ctre::smart_dispatch {
@@ -22,12 +23,20 @@ struct smart_pattern_analysis {
     static constexpr size_t alternation_count = count_alternations_simple<Pattern>();
     static constexpr bool is_alternation = glushkov::is_select<Pattern>::value;
     static constexpr bool is_repetition = glushkov::is_repeat<Pattern>::value;
+    static constexpr size_t position_count = glushkov::count_positions<Pattern>();
 
-    // Use BitNFA for alternation patterns
-    static constexpr bool use_bitnfa = is_alternation && (alternation_count >= 1);
+    // Sheng DFA for capture-free patterns with at most 16 DFA states
+    static constexpr bool use_sheng = dfa::sheng_viable_v<Pattern>;
+
+    // Use BitNFA for alternation patterns that fit the widest (512-state) mask
+    static constexpr bool use_bitnfa = is_alternation && (alternation_count >= 1) && bitnfa::fits_bitnfa_v<Pattern>;
+
+    // Mask width picked from the position count: 128 (SSE), 256 (AVX2) or 512 (AVX-512)
+    static constexpr size_t bitnfa_width = use_bitnfa ? bitnfa::bitnfa_width_v<Pattern> : 0;
 
     static constexpr const char* strategy_name() {
-        if constexpr (use_bitnfa) return "BitNFA";
+        if constexpr (use_sheng) return "Sheng";
+        else if constexpr (use_bitnfa) return "BitNFA";
         else if constexpr (is_repetition) return "SIMD";
         else return "Glushkov";
     }
@@ -41,6 +50,20 @@ consteval bool would_use_bitnfa() {
     return smart_pattern_analysis<AST>::use_bitnfa;
 }
 
+template <ctll::fixed_string Pattern>
+consteval bool would_use_sheng() {
+    using tmp = typename ctll::parser<ctre::pcre, Pattern, ctre::pcre_actions>::template output<ctre::pcre_context<>>;
+    using AST = decltype(ctll::front(typename tmp::output_type::stack_type()));
+    return smart_pattern_analysis<AST>::use_sheng;
+}
+
+template <ctll::fixed_string Pattern>
+consteval size_t get_bitnfa_width() {
+    using tmp = typename ctll::parser<ctre::pcre, Pattern, ctre::pcre_actions>::template output<ctre::pcre_context<>>;
+    using AST = decltype(ctll::front(typename tmp::output_type::stack_type()));
+    return smart_pattern_analysis<AST>::bitnfa_width;
+}
+
 template <ctll::fixed_string Pattern>
 consteval const char* get_strategy_name() {
     using tmp = typename ctll::parser<ctre::pcre, Pattern, ctre::pcre_actions>::template output<ctre::pcre_context<>>;
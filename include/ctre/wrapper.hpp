@@ -2,10 +2,16 @@
 #define CTRE__WRAPPER__HPP
 
 #include "evaluation.hpp"
+#include "longest.hpp"
+#include "memoization.hpp"
+#include "possessify.hpp"
 #ifndef CTRE_DISABLE_SIMD
 #include "bitnfa/bitnfa_match.hpp"
 #include "decomposition.hpp"
+#include "dfa/sheng.hpp"
+#include "dfa/two_phase.hpp"
 #include "glushkov_nfa.hpp"
+#include "simd/first_byte.hpp"
 #else
 #include "bitnfa_stubs.hpp"
 #include "decomposition_stubs.hpp"
@@ -89,54 +95,74 @@ struct match_method {
     constexpr CTRE_FORCE_INLINE static auto exec(IteratorBegin orig_begin, IteratorBegin begin, IteratorEnd end,
                                                  RE) noexcept {
         using result_iterator = std::conditional_t<std::is_same_v<ResultIterator, void>, IteratorBegin, ResultIterator>;
+        using result_type = return_type_for<Modifier, result_iterator, IteratorBegin, RE>;
+        using Pattern = evaluated_pattern_t<RE, Modifier>;
+
+        // Opt-in memoized backtracking (ctre::memoized), linear in the input
+        if constexpr (use_memoization<Modifier, RE, IteratorBegin, IteratorEnd>) {
+            if (!std::is_constant_evaluated()) return memo_match<RE, Modifier, result_iterator>(orig_begin, begin, end);
+        }
+
+        constexpr bool pointer_range = std::is_pointer_v<IteratorBegin> && std::is_same_v<IteratorEnd, const char*>;
+
+#ifndef CTRE_DISABLE_SIMD
+        // Sheng DFA for small capture-free patterns: one shuffle per byte, and the
+        // result needs no captures, so it is built directly from the bounds. The byte DFA
+        // is only built for char subjects, wide patterns may not fit in a byte
+        constexpr bool use_sheng = [] {
+            if constexpr (pointer_range && !is_case_insensitive(flags{Modifier{}}) && !multiline_mode(flags{Modifier{}}))
+                return dfa::sheng_viable_v<RE>;
+            else
+                return false;
+        }();
+        if constexpr (use_sheng) {
+            if (!std::is_constant_evaluated()) {
+                result_type result;
+                if (dfa::sheng_accepts<RE>(begin, end)) result.set_start_mark(begin).set_end_mark(end).matched();
+                return result;
+            }
+        }
+
+        // Two-phase: capture patterns are checked on their DFA first, and evaluate
+        // below only fills the captures of subjects the DFA accepts
+        if constexpr (pointer_range && !use_sheng && !is_case_insensitive(flags{Modifier{}}) &&
+                      !multiline_mode(flags{Modifier{}}) && dfa::two_phase_match_v<RE>) {
+            if (!std::is_constant_evaluated()) {
+                if (!dfa::two_phase_accepts<RE>(begin, end)) return result_type{};
+            }
+        }
+#else
+        constexpr bool use_sheng = false;
+#endif
 
         // BitNFA engine for alternation patterns (a|b|c)
-        if constexpr (glushkov::is_select_v<RE> && std::is_pointer_v<IteratorBegin> &&
-                      std::is_same_v<IteratorEnd, const char*>) {
+        constexpr bool use_bitnfa = glushkov::is_select_v<RE> && bitnfa::fits_bitnfa_v<RE> && pointer_range &&
+                                    !use_sheng;
+        if constexpr (use_bitnfa) {
             if (!std::is_constant_evaluated()) {
                 auto result = bitnfa::match_from_ast<RE>(std::string_view{begin, static_cast<size_t>(end - begin)});
                 if (result.matched) {
                     return evaluate(orig_begin, begin, begin + result.length, Modifier{},
-                                    return_type<result_iterator, RE>{},
-                                    ctll::list<start_mark, RE, assert_subject_end, end_mark, accept>());
+                                    result_type{},
+                                    ctll::list<start_mark, Pattern, assert_subject_end, end_mark, accept>());
                 }
                 // Not matched - return empty result
-                return evaluate(orig_begin, end, end, Modifier{}, return_type<result_iterator, RE>{},
-                                ctll::list<start_mark, RE, assert_subject_end, end_mark, accept>());
+                return evaluate(orig_begin, end, end, Modifier{}, result_type{},
+                                ctll::list<start_mark, Pattern, assert_subject_end, end_mark, accept>());
             }
         }
 
         // Literal prefiltering: search for required literals before running full regex
-        if constexpr (decomposition::has_prefilter_literal<RE>) {
-            constexpr auto literal = decomposition::prefilter_literal<RE>;
-
-            if constexpr (literal.length >= 2 && std::is_pointer_v<IteratorBegin> &&
-                          std::is_same_v<IteratorEnd, const char*>) {
+        // (only analysed when it can run: dominator analysis is costly on wide alternations)
+        if constexpr (use_sheng || use_bitnfa || !pointer_range) {
+        } else if constexpr (decomposition::has_prefilter_literal<RE>) {
+            if constexpr (decomposition::prefilter_literal<RE>.length >= 2) {
                 if (!std::is_constant_evaluated()) {
-                    bool found = [&]<size_t... Is>(std::index_sequence<Is...>) {
-                        constexpr char lit[] = {literal.chars[Is]..., '\0'};
-                        constexpr size_t len = sizeof...(Is);
-                        const char first = lit[0];
-
-                        for (const char* it = begin; it + len <= end; ++it) {
-                            if (*it == first) {
-                                bool match = true;
-                                for (size_t i = 1; i < len; ++i) {
-                                    if (it[i] != lit[i]) {
-                                        match = false;
-                                        break;
-                                    }
-                                }
-                                if (match)
-                                    return true;
-                            }
-                        }
-                        return false;
-                    }(std::make_index_sequence<literal.length>{});
+                    const bool found = decomposition::contains_prefilter_literal<RE, Modifier>(begin, end);
 
                     if (!found) {
-                        auto out = evaluate(orig_begin, end, end, Modifier{}, return_type<result_iterator, RE>{},
-                                            ctll::list<start_mark, RE, assert_subject_end, end_mark, accept>());
+                        auto out = evaluate(orig_begin, end, end, Modifier{}, result_type{},
+                                            ctll::list<start_mark, Pattern, assert_subject_end, end_mark, accept>());
                         return out;
                     }
                 }
@@ -144,8 +170,8 @@ struct match_method {
         }
 
         // Standard evaluation with SIMD optimizations (see evaluation.hpp)
-        return evaluate(orig_begin, begin, end, Modifier{}, return_type<result_iterator, RE>{},
-                        ctll::list<start_mark, RE, assert_subject_end, end_mark, accept>());
+        return evaluate(orig_begin, begin, end, Modifier{}, result_type{},
+                        ctll::list<start_mark, Pattern, assert_subject_end, end_mark, accept>());
     }
 
     template <typename Modifier = singleline, typename ResultIterator = void, typename RE, typename IteratorBegin,
@@ -161,22 +187,36 @@ struct search_method {
     constexpr CTRE_FORCE_INLINE static auto exec(IteratorBegin orig_begin, IteratorBegin begin, IteratorEnd end,
                                                  RE) noexcept {
         using result_iterator = std::conditional_t<std::is_same_v<ResultIterator, void>, IteratorBegin, ResultIterator>;
+        using result_type = return_type_for<Modifier, result_iterator, IteratorBegin, RE>;
+        using Pattern = evaluated_pattern_t<RE, Modifier>;
+
+        // Opt-in leftmost-longest (ctre::longest), decided on the pattern's DFAs
+        if constexpr (is_longest<Modifier>::value) {
+            static_assert(longest_viable<Modifier, RE, IteratorBegin>,
+                          "ctre::longest needs a case-sensitive, singleline char search and a pattern with a DFA: "
+                          "no assertions, lookarounds, backreferences, lazy/possessive repeats, within the state cap");
+            return longest_search<RE, Modifier, result_type>(orig_begin, begin, end);
+        }
+
+        // Opt-in memoized backtracking (ctre::memoized), linear in the input
+        if constexpr (use_memoization<Modifier, RE, IteratorBegin, IteratorEnd>) {
+            if (!std::is_constant_evaluated()) return memo_search<RE, Modifier, result_iterator>(orig_begin, begin, end);
+        }
 
         // BitNFA engine for alternation search
-        if constexpr (glushkov::is_select_v<RE> && std::is_pointer_v<IteratorBegin> &&
+        if constexpr (glushkov::is_select_v<RE> && bitnfa::fits_bitnfa_v<RE> && std::is_pointer_v<IteratorBegin> &&
                       std::is_same_v<IteratorEnd, const char*>) {
             if (!std::is_constant_evaluated()) {
                 auto result = bitnfa::search_from_ast<RE>(std::string_view{begin, static_cast<size_t>(end - begin)});
+                // The BitNFA gives the leftmost start; evaluating from there picks the end
+                // search reports, the first alternative rather than the longest
                 if (result.matched) {
-                    auto out = evaluate(orig_begin, begin + result.position, begin + result.position + result.length,
-                                        Modifier{}, return_type<result_iterator, RE>{},
-                                        ctll::list<start_mark, RE, end_mark, accept>());
-                    out.set_end_mark(begin + result.position);
-                    return out;
+                    return evaluate(orig_begin, begin + result.position, end, Modifier{}, result_type{},
+                                    ctll::list<start_mark, Pattern, end_mark, accept>());
                 }
                 // Not matched - return empty result
-                auto out = evaluate(orig_begin, end, end, Modifier{}, return_type<result_iterator, RE>{},
-                                    ctll::list<start_mark, RE, end_mark, accept>());
+                auto out = evaluate(orig_begin, end, end, Modifier{}, result_type{},
+                                    ctll::list<start_mark, Pattern, end_mark, accept>());
                 out.set_end_mark(end);
                 return out;
             }
@@ -186,16 +226,80 @@ struct search_method {
 
         auto it = begin;
 
+#ifndef CTRE_DISABLE_SIMD
+        // Two-phase: the DFAs find the first position a match can start at, so
+        // capture patterns skip straight there (or give up)
+        if constexpr (!fixed && std::is_pointer_v<IteratorBegin> && std::is_same_v<IteratorEnd, const char*> &&
+                      !is_case_insensitive(flags{Modifier{}}) && !multiline_mode(flags{Modifier{}}) &&
+                      !decomposition::has_prefilter_literal_set<RE> && dfa::two_phase_search_v<RE>) {
+            if (!std::is_constant_evaluated()) {
+                it = dfa::two_phase_start<RE>(begin, end);
+                if (it == nullptr) {
+                    result_type out;
+                    out.set_end_mark(end);
+                    return out;
+                }
+            }
+        }
+
+        // Multi-literal prefilter: every match starts with one of the prefix literals,
+        // so jump between their occurrences (Teddy) and evaluate only there
+        if constexpr (!fixed && std::is_pointer_v<IteratorBegin> && std::is_same_v<IteratorEnd, const char*> &&
+                      !is_case_insensitive(flags{Modifier{}})) {
+            if constexpr (decomposition::has_prefilter_literal_set<RE>) {
+                if (!std::is_constant_evaluated()) {
+                    constexpr auto & teddy = decomposition::prefilter_teddy<RE>;
+                    while ((it = simd::teddy_find(teddy, it, end)) != end) {
+                        if (auto out = evaluate(orig_begin, it, end, Modifier{}, result_type{},
+                                                ctll::list<start_mark, Pattern, end_mark, accept>())) {
+                            return out;
+                        }
+                        ++it;
+                    }
+                }
+            } else if constexpr (simd::first_byte_set_v<RE>.usable) {
+                // First-byte skip: evaluate only where the byte can start a match
+                if (!std::is_constant_evaluated()) {
+                    constexpr auto & first_bytes = simd::first_byte_set_v<RE>;
+                    while ((it = simd::first_byte_find(first_bytes, it, end)) != end) {
+                        if (auto out = evaluate(orig_begin, it, end, Modifier{}, result_type{},
+                                                ctll::list<start_mark, Pattern, end_mark, accept>())) {
+                            return out;
+                        }
+                        ++it;
+                    }
+                }
+            }
+        }
+
+        // Wide subjects skip to the next code unit that can start a match, on 16/32-bit lanes
+        using char_type = std::remove_cv_t<std::remove_reference_t<decltype(*begin)>>;
+        if constexpr (!fixed && std::is_pointer_v<IteratorBegin> && std::is_same_v<IteratorEnd, IteratorBegin> &&
+                      simd::is_wide_char_v<char_type> && !is_case_insensitive(flags{Modifier{}})) {
+            if constexpr (simd::wide_first_class_v<RE, char_type>.usable) {
+                if (!std::is_constant_evaluated()) {
+                    while ((it = simd::wide_class_find<simd::wide_first_class_v<RE, char_type>>(it, end)) != end) {
+                        if (auto out = evaluate(orig_begin, it, end, Modifier{}, result_type{},
+                                                ctll::list<start_mark, Pattern, end_mark, accept>())) {
+                            return out;
+                        }
+                        ++it;
+                    }
+                }
+            }
+        }
+#endif
+
         for (; end != it && !fixed; ++it) {
-            if (auto out = evaluate(orig_begin, it, end, Modifier{}, return_type<result_iterator, RE>{},
-                                    ctll::list<start_mark, RE, end_mark, accept>())) {
+            if (auto out = evaluate(orig_begin, it, end, Modifier{}, result_type{},
+                                    ctll::list<start_mark, Pattern, end_mark, accept>())) {
                 return out;
             }
         }
 
         // in case the RE is empty or fixed
-        auto out = evaluate(orig_begin, it, end, Modifier{}, return_type<result_iterator, RE>{},
-                            ctll::list<start_mark, RE, end_mark, accept>());
+        auto out = evaluate(orig_begin, it, end, Modifier{}, result_type{},
+                            ctll::list<start_mark, Pattern, end_mark, accept>());
 
         // Propagate end position only if match failed (needed for split iterator to know where to continue)
         if (!out) out.set_end_mark(it);
@@ -215,8 +319,23 @@ struct starts_with_method {
     constexpr CTRE_FORCE_INLINE static auto exec(IteratorBegin orig_begin, IteratorBegin begin, IteratorEnd end,
                                                  RE) noexcept {
         using result_iterator = std::conditional_t<std::is_same_v<ResultIterator, void>, IteratorBegin, ResultIterator>;
-        return evaluate(orig_begin, begin, end, Modifier{}, return_type<result_iterator, RE>{},
-                        ctll::list<start_mark, RE, end_mark, accept>());
+        using result_type = return_type_for<Modifier, result_iterator, IteratorBegin, RE>;
+        using Pattern = evaluated_pattern_t<RE, Modifier>;
+
+        // Opt-in leftmost-longest (ctre::longest), decided on the pattern's DFAs
+        if constexpr (is_longest<Modifier>::value) {
+            static_assert(longest_viable<Modifier, RE, IteratorBegin>,
+                          "ctre::longest needs a case-sensitive, singleline char search and a pattern with a DFA: "
+                          "no assertions, lookarounds, backreferences, lazy/possessive repeats, within the state cap");
+            return longest_starts_with<RE, Modifier, result_type>(orig_begin, begin, end);
+        }
+
+        // Opt-in memoized backtracking (ctre::memoized), linear in the input
+        if constexpr (use_memoization<Modifier, RE, IteratorBegin, IteratorEnd>) {
+            if (!std::is_constant_evaluated()) return memo_starts_with<RE, Modifier, result_iterator>(orig_begin, begin, end);
+        }
+        return evaluate(orig_begin, begin, end, Modifier{}, result_type{},
+                        ctll::list<start_mark, Pattern, end_mark, accept>());
     }
 
     template <typename Modifier = singleline, typename ResultIterator = void, typename RE, typename IteratorBegin,
@@ -0,0 +1,104 @@
+#include <ctre.hpp>
+#include <iostream>
+#include <string>
+#include <string_view>
+
+int tests_passed = 0;
+int tests_failed = 0;
+
+#define TEST(name) \
+    std::cout << "  " << #name << "... "; \
+    if (test_##name()) { tests_passed++; std::cout << "PASSED\n"; } \
+    else { tests_failed++; std::cout << "FAILED\n"; }
+
+template <ctll::fixed_string Pattern>
+using ast_of = decltype(ctll::front(typename ctll::parser<ctre::pcre, Pattern, ctre::pcre_actions>::template output<ctre::pcre_context<>>::output_type::stack_type()));
+
+using sql_injection = ast_of<"union[ ]+select">;
+using path_traversal = ast_of<"(?:\\.\\./)+">;
+using script_tag = ast_of<"<script[^>]*>">;
+using shell_escape = ast_of<"[;|] *(?:rm|cat|wget)">;
+using long_hex = ast_of<"%[0-9a-f][0-9a-f]">;
+
+static constexpr const auto& signatures =
+    ctre::bitnfa::compiled_multi_bitnfa_v<sql_injection, path_traversal, script_tag, shell_escape, long_hex>;
+
+static_assert(std::remove_cvref_t<decltype(signatures)>::PATTERNS == 5);
+static_assert(ctre::bitnfa::combined_positions_v<ast_of<"ab">, ast_of<"c|d">> == 4);
+static_assert(ctre::bitnfa::multi_bitnfa_width_v<ast_of<"ab">, ast_of<"c|d">> == 128);
+// Capture groups are not supported by the BitNFA, so the signatures use (?:...)
+static_assert(ctre::bitnfa::fits_multi_bitnfa_v<sql_injection, path_traversal, script_tag, shell_escape, long_hex>);
+
+// Reference: every pattern on its own BitNFA
+template <typename... ASTs>
+uint64_t one_by_one(std::string_view input) {
+    uint64_t fired = 0;
+    size_t k = 0;
+    ((fired |= (ctre::bitnfa::search_from_ast<ASTs>(input).matched ? uint64_t{1} << k : 0), ++k), ...);
+    return fired;
+}
+
+template <typename... ASTs>
+uint64_t one_by_one_whole(std::string_view input) {
+    uint64_t fired = 0;
+    size_t k = 0;
+    ((fired |= (ctre::bitnfa::match_from_ast<ASTs>(input).matched ? uint64_t{1} << k : 0), ++k), ...);
+    return fired;
+}
+
+template <typename... ASTs>
+bool agrees_with_reference(const char* alphabet, size_t alphabet_size) {
+    uint32_t seed = 5;
+    for (int round = 0; round < 500; ++round) {
+        std::string text;
+        const size_t length = static_cast<size_t>(round) % 24;
+        for (size_t i = 0; i < length; ++i) {
+            seed = seed * 1103515245u + 12345u;
+            text += alphabet[(seed >> 16) % alphabet_size];
+        }
+        if (ctre::bitnfa::search_each_from_ast<ASTs...>(text) != one_by_one<ASTs...>(text)) return false;
+        if (ctre::bitnfa::match_each_from_ast<ASTs...>(text) != one_by_one_whole<ASTs...>(text)) return false;
+    }
+    return true;
+}
+
+bool test_signatures() {
+    return ctre::bitnfa::search(signatures, "GET /?q=1 UNION select") == 0 &&
+           ctre::bitnfa::search(signatures, "GET /?q=1 union  select * from t") == 0b00001 &&
+           ctre::bitnfa::search(signatures, "GET /../../etc/passwd; cat x") == 0b01010 &&
+           ctre::bitnfa::search(signatures, "<script src=x>%3c") == 0b10100 &&
+           ctre::bitnfa::search(signatures, "plain request") == 0;
+}
+
+bool test_whole_input() {
+    return ctre::bitnfa::match(signatures, "../../") == 0b00010 &&
+           ctre::bitnfa::match(signatures, "%3f") == 0b10000 &&
+           ctre::bitnfa::match(signatures, "%3f ") == 0;
+}
+
+bool test_overlapping_patterns() {
+    return agrees_with_reference<ast_of<"ab">, ast_of<"b+c">, ast_of<"a|bc">, ast_of<"(?:ab)*c">, ast_of<"[a-c]{3}">>("abcx", 4);
+}
+
+bool test_nullable_pattern() {
+    // Unlike single-pattern search, the empty match counts
+    return ctre::bitnfa::search_each_from_ast<ast_of<"x*">, ast_of<"y">>("zz") == 0b01 &&
+           ctre::bitnfa::match_each_from_ast<ast_of<"x*">, ast_of<"y">>("") == 0b01 &&
+           agrees_with_reference<ast_of<"a+">, ast_of<"ba?">, ast_of<"(?:ab|b)+">>("ab", 2);
+}
+
+bool test_long_spans() {
+    // Later patterns sit past the 7-state shift limit from the start state
+    return agrees_with_reference<ast_of<"abcdefgh">, ast_of<"hgf">, ast_of<"(?:fed|c)+">, ast_of<"h.a">>("abcdefgh", 8);
+}
+
+int main() {
+    std::cout << "BitNFA multi-pattern tests\n";
+    TEST(signatures);
+    TEST(whole_input);
+    TEST(overlapping_patterns);
+    TEST(nullable_pattern);
+    TEST(long_spans);
+    std::cout << "\nPassed: " << tests_passed << ", Failed: " << tests_failed << "\n";
+    return tests_failed == 0 ? 0 : 1;
+}
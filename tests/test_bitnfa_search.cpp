@@ -0,0 +1,115 @@
+#include <ctre.hpp>
+#include <iostream>
+#include <string>
+#include <cassert>
+
+int tests_passed = 0;
+int tests_failed = 0;
+
+#define TEST(name) \
+    std::cout << "  " << #name << "... "; \
+    if (test_##name()) { tests_passed++; std::cout << "PASSED\n"; } \
+    else { tests_failed++; std::cout << "FAILED\n"; }
+
+using ctre::bitnfa::BitNFA128;
+using ctre::bitnfa::match_result;
+
+// Reference: restart from every offset, keep the longest match of the first start that matches
+match_result restart_search(const BitNFA128& nfa, std::string_view input, size_t offset = 0) {
+    for (size_t start = offset; start < input.size(); ++start) {
+        auto current = nfa.get_initial_state();
+        bool found = false;
+        size_t end = 0;
+        for (size_t pos = start; pos < input.size(); ++pos) {
+            current = nfa.calculate_successors(current, input[pos]);
+            if (current.none()) break;
+            if (nfa.has_accept(current)) { found = true; end = pos; }
+        }
+        if (found) return match_result{start, end - start + 1, true};
+    }
+    return match_result{};
+}
+
+bool same(const match_result& a, const match_result& b) {
+    if (a.matched != b.matched) return false;
+    return !a.matched || (a.position == b.position && a.length == b.length);
+}
+
+template <ctll::fixed_string Pattern>
+bool agrees_with_restart(const char* alphabet, size_t alphabet_size) {
+    static constexpr auto nfa = ctre::bitnfa::compile_pattern_string_with_charclass<Pattern>();
+    uint32_t seed = 12345;
+    for (int round = 0; round < 300; ++round) {
+        std::string input;
+        size_t length = round % 40;
+        for (size_t i = 0; i < length; ++i) {
+            seed = seed * 1103515245u + 12345u;
+            input += alphabet[(seed >> 16) % alphabet_size];
+        }
+        if (!same(ctre::bitnfa::search(nfa, input), restart_search(nfa, input))) return false;
+
+        size_t start = 0;
+        auto all = ctre::bitnfa::find_all(nfa, input);
+        for (const auto& r : all) {
+            if (!same(r, restart_search(nfa, input, start))) return false;
+            start = r.position + r.length;
+        }
+        if (restart_search(nfa, input, start).matched) return false;
+    }
+    return true;
+}
+
+bool test_alternation() {
+    return agrees_with_restart<"abc|bcd|cd">("abcd", 4);
+}
+
+bool test_overlapping_starts() {
+    // Later starts reach accept first, but the leftmost start must win
+    return agrees_with_restart<"a+b|ab+c">("abc", 3);
+}
+
+bool test_longest_from_leftmost() {
+    static constexpr auto nfa = ctre::bitnfa::compile_pattern_string_with_charclass<"a|a[bc]*d">();
+    auto r = ctre::bitnfa::search(nfa, "xabcbcdx");
+    return r.matched && r.position == 1 && r.length == 6 &&
+           agrees_with_restart<"a|a[bc]*d">("abcdx", 5);
+}
+
+bool test_char_class_loops() {
+    return agrees_with_restart<"[a-c]+x|b.y">("abcxy", 5);
+}
+
+bool test_long_partial_matches() {
+    static constexpr auto nfa = ctre::bitnfa::compile_pattern_string_with_charclass<"aaaaaaaaaab|ac">();
+    std::string input(4096, 'a');
+    input += "c";
+    auto r = ctre::bitnfa::search(nfa, input);
+    return r.matched && r.position == 4095 && r.length == 2;
+}
+
+// ctre::search routes alternations through the BitNFA; the text must be search's, not the BitNFA's longest
+bool test_search_method_text() {
+    const std::string_view input = "--abc--a0b--";
+    std::string joined;
+    size_t count = 0;
+    for (auto m : ctre::search_all<"xyz|abc|a0b|zzz">(input)) {
+        joined += m.to_view();
+        joined += ';';
+        if (++count > 4) break;
+    }
+    return ctre::search<"xyz|abc|a0b|zzz">(input).to_view() == "abc" && joined == "abc;a0b;" &&
+           ctre::search<"xa|xab|yz|qq">(std::string_view{"--xab"}).to_view() == "xa" &&
+           !ctre::search<"xyz|abd|zzz">(input);
+}
+
+int main() {
+    std::cout << "BitNFA single-pass search tests\n";
+    TEST(alternation);
+    TEST(overlapping_starts);
+    TEST(longest_from_leftmost);
+    TEST(char_class_loops);
+    TEST(long_partial_matches);
+    TEST(search_method_text);
+    std::cout << "\nPassed: " << tests_passed << ", Failed: " << tests_failed << "\n";
+    return tests_failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,93 @@
+#include <ctre.hpp>
+#include <ctre/smart_dispatch.hpp>
+#include <iostream>
+#include <string>
+#include <cassert>
+
+int tests_passed = 0;
+int tests_failed = 0;
+
+#define TEST(name) \
+    std::cout << "  " << #name << "... "; \
+    if (test_##name()) { tests_passed++; std::cout << "PASSED\n"; } \
+    else { tests_failed++; std::cout << "FAILED\n"; }
+
+// 26 literals, ~170 positions -> 256-state mask
+static constexpr ctll::fixed_string agents =
+    "mozilla|chrome|safari|firefox|opera|edge|trident|webkit|gecko|konqueror|"
+    "lynx|curl|wget|python|java|okhttp|postman|insomnia|httpie|axios|"
+    "googlebot|bingbot|yandex|baidu|duckduck|slurp";
+
+// 64 literals, ~290 positions -> 512-state mask
+static constexpr ctll::fixed_string schemes =
+    "http|https|ftp|ftps|sftp|ssh|telnet|gopher|mailto|news|nntp|irc|ircs|"
+    "ldap|ldaps|file|data|javascript|about|chrome|resource|view-source|ws|wss|"
+    "git|svn|rsync|smb|nfs|afp|dav|davs|magnet|torrent|spotify|steam|skype|"
+    "slack|zoom|tel|sms|geo|market|intent|bitcoin|callto|facetime|feed|"
+    "hcp|imap|jabber|maps|msteams|notes|pop|rtsp|rtmp|sip|sips|snmp|teamspeak|webcal|xmpp";
+
+// 33 repeated alternatives: each one is followed by all of them, past the 32 successors of a Glushkov state
+static constexpr ctll::fixed_string repeated =
+    "(?:a|b|c|d|e|f|g|h|i|j|k|l|m|n|o|p|q|r|s|t|u|v|w|y|z|A|B|C|D|E|F|G|H)+x|qq";
+
+static_assert(ctre::smart_dispatch::get_bitnfa_width<"abc|def">() == 128);
+static_assert(ctre::smart_dispatch::get_bitnfa_width<agents>() == 256);
+static_assert(ctre::smart_dispatch::get_bitnfa_width<schemes>() == 512);
+static_assert(ctre::smart_dispatch::get_bitnfa_width<"a+b">() == 0);
+
+static_assert(sizeof(ctre::bitnfa::StateMask256) == 32 && alignof(ctre::bitnfa::StateMask256) == 32);
+static_assert(sizeof(ctre::bitnfa::StateMask512) == 64 && alignof(ctre::bitnfa::StateMask512) == 64);
+static_assert((ctre::bitnfa::StateMask512{}.set(63) << 1).test(64));
+static_assert((ctre::bitnfa::StateMask512{}.set(200) << 7).test(207));
+static_assert((ctre::bitnfa::StateMask512{}.set(130) << 130).test(260));
+
+bool test_mask_operations() {
+    auto a = ctre::bitnfa::StateMask256{}.set(3).set(255);
+    auto b = ctre::bitnfa::StateMask256{}.set(255).set(128);
+    return (a & b).count() == 1 && (a & b).test(255) && (a | b).count() == 3 &&
+           (a ^ b).count() == 2 && !(a ^ a).any() && (a ^ a).none();
+}
+
+bool test_user_agents() {
+    static constexpr auto nfa = ctre::bitnfa::compile_pattern_string_with_charclass<agents>();
+    static_assert(decltype(nfa)::MAX_STATES == 256);
+    auto r = ctre::bitnfa::search(nfa, "Agent: Mozilla/5.0 (compatible; googlebot/2.1)");
+    auto all = ctre::bitnfa::find_all(nfa, "curl then wget then slurp");
+    return r.matched && r.position == 32 && r.length == 9 &&
+           all.size() == 3 && all[2].position == 20 && all[2].length == 5;
+}
+
+bool test_url_schemes() {
+    static constexpr auto nfa = ctre::bitnfa::compile_pattern_string_with_charclass<schemes>();
+    static_assert(decltype(nfa)::MAX_STATES == 512);
+    auto late = ctre::bitnfa::search(nfa, "open intent://x");
+    auto longest = ctre::bitnfa::search(nfa, "see https://x");
+    return late.matched && late.position == 5 && late.length == 6 &&
+           longest.matched && longest.position == 4 && longest.length == 5 &&
+           ctre::bitnfa::match(nfa, "view-source").matched &&
+           !ctre::bitnfa::search(nfa, "nothing to see").matched;
+}
+
+bool test_wrapper_dispatch() {
+    return ctre::match<schemes>("market") && !ctre::match<schemes>("marke") &&
+           ctre::search<schemes>("xx magnet:?").to_view() == "magnet" &&
+           ctre::search<agents>("User-Agent: okhttp/4").to_view() == "okhttp";
+}
+
+bool test_repeated_alternation() {
+    static constexpr auto nfa = ctre::bitnfa::compile_pattern_string_with_charclass<repeated>();
+    return ctre::bitnfa::match(nfa, "abx").matched && ctre::bitnfa::match(nfa, "Hzax").matched &&
+           !ctre::bitnfa::match(nfa, "abq").matched && ctre::match<repeated>("abx") &&
+           ctre::match<repeated>("GHabHx") && ctre::match<repeated>("qq") && !ctre::match<repeated>("x");
+}
+
+int main() {
+    std::cout << "BitNFA wide mask tests\n";
+    TEST(mask_operations);
+    TEST(user_agents);
+    TEST(url_schemes);
+    TEST(wrapper_dispatch);
+    TEST(repeated_alternation);
+    std::cout << "\nPassed: " << tests_passed << ", Failed: " << tests_failed << "\n";
+    return tests_failed == 0 ? 0 : 1;
+}
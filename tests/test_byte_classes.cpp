@@ -0,0 +1,68 @@
+#include <ctre.hpp>
+#include <ctre/dfa/dfa_match.hpp>
+#include <iostream>
+#include <string>
+
+int tests_passed = 0;
+int tests_failed = 0;
+
+#define TEST(name) \
+    std::cout << "  " << #name << "... "; \
+    if (test_##name()) { tests_passed++; std::cout << "PASSED\n"; } \
+    else { tests_failed++; std::cout << "FAILED\n"; }
+
+template <ctll::fixed_string Pattern>
+using ast_of = decltype(ctll::front(typename ctll::parser<ctre::pcre, Pattern, ctre::pcre_actions>::template output<ctre::pcre_context<>>::output_type::stack_type()));
+
+constexpr auto digit_rows = [] {
+    std::array<int, 256> rows{};
+    for (int c = '0'; c <= '9'; ++c) rows[static_cast<size_t>(c)] = 1;
+    rows['x'] = 2;
+    return rows;
+}();
+static_assert(ctre::partition_bytes(digit_rows).count == 3);
+static_assert(ctre::partition_bytes(digit_rows).class_of['5'] == ctre::partition_bytes(digit_rows).class_of['0']);
+static_assert(ctre::partition_bytes(digit_rows).representative[0] == 0);
+
+// BitNFA: "abc|def" needs the six letters plus everything else
+using alternation = ast_of<"abc|def">;
+static_assert(ctre::bitnfa::byte_class_count(ctre::bitnfa::full_bitnfa_v<alternation>.reachability) == 7);
+static_assert(sizeof(ctre::bitnfa::compiled_bitnfa_v<alternation>.reachability) <
+              sizeof(ctre::bitnfa::full_bitnfa_v<alternation>.reachability) / 8);
+
+// Shift-or: a literal of N bytes has at most N + 1 masks
+static_assert(sizeof(ctre::simd::shift_or_state<64>) < 256 * sizeof(uint64_t) / 2);
+
+// DFA tables use the same partition
+static_assert(ctre::dfa::forward_dfa<ast_of<"[a-z]+[0-9]">>.class_count == 3);
+
+bool test_compressed_rows_agree() {
+    const auto& full = ctre::bitnfa::full_bitnfa_v<alternation>.reachability;
+    const auto& compact = ctre::bitnfa::compiled_bitnfa_v<alternation>.reachability;
+    for (int c = 0; c < 256; ++c)
+        if (!(full.get(static_cast<unsigned char>(c)) == compact.get(static_cast<unsigned char>(c)))) return false;
+    return compact.class_count() == 7;
+}
+
+bool test_compressed_nfa_search() {
+    return ctre::bitnfa::search<"abc|def">("xxdefabc").position == 2 &&
+           ctre::bitnfa::find_all<"abc|def">("abc def abd").size() == 2 &&
+           ctre::bitnfa::match<"abc|def">("def").matched;
+}
+
+bool test_shift_or_literal() {
+    std::string text(300, 'a');
+    text += "needle in a haystack";
+    const char* it = text.data();
+    bool found = ctre::simd::match_string_shift_or<'n', 'e', 'e', 'd', 'l', 'e'>(it, text.data() + text.size(), ctre::flags{});
+    return found && it == text.data() + 306;
+}
+
+int main() {
+    std::cout << "Byte equivalence class tests\n";
+    TEST(compressed_rows_agree);
+    TEST(compressed_nfa_search);
+    TEST(shift_or_literal);
+    std::cout << "\nPassed: " << tests_passed << ", Failed: " << tests_failed << "\n";
+    return tests_failed == 0 ? 0 : 1;
+}
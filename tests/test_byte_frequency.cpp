@@ -0,0 +1,83 @@
+#include <ctre.hpp>
+#include <ctre/simd/literal_search.hpp>
+#include <iostream>
+#include <string>
+#include <string_view>
+
+int tests_passed = 0;
+int tests_failed = 0;
+
+#define TEST(name, cond) do { \
+    if (cond) { \
+        std::cout << "  [PASS] " << name << std::endl; \
+        tests_passed++; \
+    } else { \
+        std::cout << "  [FAIL] " << name << std::endl; \
+        tests_failed++; \
+    } \
+} while(0)
+
+// 'e' is the rarest byte here, every other letter and the space are common
+struct no_e_frequency {
+    static constexpr auto rank = ctre::simd::byte_rank_from_order("abcdfghijklmnopqrstuvwxyzZ ");
+};
+
+constexpr bool offsets_are(ctre::simd::rare_byte_offsets r, size_t rarest, size_t second) {
+    return r.rarest == rarest && r.second == second;
+}
+
+static_assert(offsets_are(ctre::simd::rare_bytes("the Zebra", 9), 4, 6));
+static_assert(offsets_are(ctre::simd::rare_bytes(" e", 2), 1, 0));
+static_assert(offsets_are(ctre::simd::rare_bytes("x", 1), 0, 0));
+static_assert(offsets_are(ctre::simd::rare_bytes<no_e_frequency>("the Zebra", 9), 2, 5));
+// Caseless search ranks letters as their lowercase
+static_assert(offsets_are(ctre::simd::rare_bytes("THE", 3, true), 1, 0));
+
+// Every tier the CPU runs agrees with std::string_view::find for the literal planted
+// at every offset of text made of its own frequent bytes
+template <typename Frequency, size_t N>
+bool kernels_agree(const char (&literal)[N]) {
+    const std::string_view needle{literal, N - 1};
+    for (size_t at = 0; at < 100; ++at) {
+        std::string text;
+        while (text.size() < 140) text += "e /e e/ ee";
+        text.replace(at, needle.size(), needle);
+        const char* begin = text.data();
+        for (size_t length = 0; length <= text.size(); length += 3) {
+            const bool expected = std::string_view{begin, length}.find(needle) != std::string_view::npos;
+            if (ctre::simd::search_literal_scalar<N, Frequency>(begin, begin + length, literal) != expected) return false;
+            if (ctre::simd::search_literal<N, Frequency>(begin, begin + length, literal) != expected) return false;
+            if (ctre::simd::has_sse42() &&
+                ctre::simd::search_literal_sse42<N, Frequency>(begin, begin + length, literal) != expected)
+                return false;
+            if (ctre::simd::has_avx2() &&
+                ctre::simd::search_literal_avx2<N, Frequency>(begin, begin + length, literal) != expected)
+                return false;
+            if (ctre::simd::search_literal_caseless<N, Frequency>(begin, begin + length, literal) != expected)
+                return false;
+        }
+    }
+    return true;
+}
+
+int main() {
+    std::cout << "=== Byte Frequency Tests ===\n\n";
+
+    TEST("Common first byte", kernels_agree<CTRE_BYTE_FREQUENCY>(" e/x"));
+    TEST("Repeated bytes", kernels_agree<CTRE_BYTE_FREQUENCY>("e e e"));
+    TEST("Single byte", kernels_agree<CTRE_BYTE_FREQUENCY>("/"));
+    TEST("Long literal", kernels_agree<CTRE_BYTE_FREQUENCY>("/usr/lib/x86_64-linux-gnu"));
+    TEST("Custom frequency", kernels_agree<no_e_frequency>("the Zebra"));
+
+    {
+        // The match prefilter searches by the rare bytes too
+        const std::string text = std::string(200, ' ') + "error: e/1";
+        TEST("Match prefilter", (ctre::match<" +error: [a-z]+/[0-9]">(std::string_view{text})));
+        TEST("Match prefilter miss", (!ctre::match<" +error: [a-z]+/[0-9]">(std::string_view{text + "x"})));
+    }
+
+    std::cout << "\n=== Results ===\n";
+    std::cout << "Passed: " << tests_passed << "\n";
+    std::cout << "Failed: " << tests_failed << "\n";
+    return tests_failed > 0 ? 1 : 0;
+}
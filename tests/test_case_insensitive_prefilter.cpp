@@ -0,0 +1,93 @@
+#include <ctre.hpp>
+#include <ctre/fast_search.hpp>
+#include <ctre/simd/literal_search.hpp>
+#include <iostream>
+#include <string>
+#include <string_view>
+
+int tests_passed = 0;
+int tests_failed = 0;
+
+#define TEST(name, cond) do { \
+    if (cond) { \
+        std::cout << "  [PASS] " << name << std::endl; \
+        tests_passed++; \
+    } else { \
+        std::cout << "  [FAIL] " << name << std::endl; \
+        tests_failed++; \
+    } \
+} while(0)
+
+// Constant evaluation takes the naive literal scan
+static_assert(ctre::fast_search<"x+hello", ctre::case_insensitive>("xxHeLLo"));
+static_assert(ctre::fast_search<"(?i)hello">("say HELLO"));
+static_assert(!ctre::fast_search<"(?i)hello">("say HELL0"));
+
+// A literal planted at every offset of a subject long enough for the vector kernels,
+// in mixed case; every tier the CPU runs must agree with the scalar search
+bool caseless_kernels_agree() {
+    static const char literal[] = "ab-Z";
+    static const char* const variants[] = {"ab-Z", "AB-z", "aB-z", "ab-@", "ab-Z", "ab_Z"};
+    for (const char* variant : variants) {
+        for (size_t at = 0; at < 90; ++at) {
+            std::string text(100, '.');
+            text.replace(at, 4, variant);
+            const char* begin = text.data();
+            for (size_t length = 0; length <= text.size(); length += 7) {
+                const bool expected = ctre::simd::search_literal_caseless_scalar(begin, begin + length, literal);
+                if (expected != (at + 4 <= length && variant[3] != '@' && variant[2] == '-')) return false;
+                if (ctre::simd::search_literal_caseless(begin, begin + length, literal) != expected) return false;
+                if (ctre::simd::has_sse42() &&
+                    ctre::simd::search_literal_caseless_sse42(begin, begin + length, literal) != expected)
+                    return false;
+                if (ctre::simd::has_avx2() &&
+                    ctre::simd::search_literal_caseless_avx2(begin, begin + length, literal) != expected)
+                    return false;
+            }
+        }
+    }
+    return true;
+}
+
+int main() {
+    std::cout << "=== Case-Insensitive Prefilter Tests ===\n\n";
+
+    const std::string padding(40, '-');
+
+    {
+        // The prefilter literal of the match method is searched ignoring case
+        const std::string text = "xXx" + padding + "Needle" + padding;
+        const std::string_view subject{text};
+        TEST("Match modifier", (ctre::match<"x+-+needle-+", ctre::case_insensitive>(subject)));
+        TEST("Match inline mode", (ctre::match<"(?i)x+-+needle-+">(subject)));
+        TEST("Match mode after prefix", (ctre::match<"x+(?i)X*-+needle-+">(subject)));
+        TEST("Match case-sensitive", (!ctre::match<"x+-+needle-+">(subject)));
+    }
+
+    {
+        const std::string text = padding + "say HeLLo World" + padding;
+        const std::string_view subject{text};
+        auto m = ctre::fast_search<"hello [a-z]+", ctre::case_insensitive>(subject);
+        TEST("Fast search modifier", m && m.to_view() == "HeLLo World");
+        auto inline_mode = ctre::fast_search<"(?i)hello world">(subject);
+        TEST("Fast search inline mode", inline_mode && inline_mode.to_view() == "HeLLo World");
+        TEST("Fast search case-sensitive", (!ctre::fast_search<"hello world">(subject)));
+        TEST("Fast search no match", (!ctre::fast_search<"(?i)hello there">(subject)));
+    }
+
+    {
+        // The match starts where the prefix's longest run does, not next to the literal
+        auto m = ctre::fast_search<"[a-z]+ needle", ctre::case_insensitive>(std::string_view{"xx ab NEEDLE cd"});
+        TEST("Fast search leftmost prefix", m && m.to_view() == "ab NEEDLE");
+        const std::string text = padding + "(" + std::string(80, 'Q') + " nEeDlE)";
+        auto nested = ctre::fast_search<"([a-z]+) (needle)", ctre::case_insensitive>(std::string_view{text});
+        TEST("Fast search long nested prefix", nested && nested.get<1>().to_view().size() == 80);
+    }
+
+    TEST("Caseless kernels", caseless_kernels_agree());
+
+    std::cout << "\n=== Results ===\n";
+    std::cout << "Passed: " << tests_passed << "\n";
+    std::cout << "Failed: " << tests_failed << "\n";
+    return tests_failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,84 @@
+#include <ctre.hpp>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+int tests_passed = 0;
+int tests_failed = 0;
+
+#define TEST(name, cond) do { \
+    if (cond) { \
+        std::cout << "  [PASS] " << name << std::endl; \
+        tests_passed++; \
+    } else { \
+        std::cout << "  [FAIL] " << name << std::endl; \
+        tests_failed++; \
+    } \
+} while(0)
+
+using compact_result = decltype(ctre::match<"(a)(b)(c)(d)(e)(f)(g)(h)(i)(j)", ctre::compact_captures>(std::string_view{}));
+using plain_result = decltype(ctre::match<"(a)(b)(c)(d)(e)(f)(g)(h)(i)(j)">(std::string_view{}));
+
+// Opt-in, and only for pointer subjects
+static_assert(ctre::is_regex_results_v<compact_result>);
+static_assert(!std::is_same_v<compact_result, plain_result>);
+static_assert(sizeof(compact_result) * 2 <= sizeof(plain_result));
+static_assert(std::tuple_size_v<compact_result> == 11);
+static_assert(std::is_same_v<decltype(ctre::match<"(a)", ctre::compact_captures>(std::declval<std::string>().begin(), std::declval<std::string>().end())),
+                             decltype(ctre::match<"(a)">(std::declval<std::string>().begin(), std::declval<std::string>().end()))>);
+// Constant evaluation
+static_assert(ctre::match<"([a-z]+)@([a-z]+)", ctre::compact_captures>("user@host").get<2>() == "host");
+
+int main() {
+    std::cout << "=== Compact Capture Tests ===\n\n";
+
+    {
+        auto m = ctre::match<"([a-z]+)@([a-z]+)\\.(com|org)", ctre::compact_captures>(std::string_view{"user@example.org"});
+        TEST("Match", m && m.to_view() == "user@example.org");
+        TEST("Groups", m.get<1>() == "user" && m.get<2>() == "example" && m.get<3>() == "org");
+        auto [whole, user, host, tld] = m;
+        TEST("Structured bindings", whole.size() == 16 && user == "user" && tld == "org");
+    }
+
+    {
+        auto m = ctre::search<"x(y)?(z)", ctre::compact_captures>(std::string_view{"..xz.."});
+        TEST("Unmatched group", m && !m.get<1>() && m.get<2>() == "z" && !m.get<1>().to_optional_view());
+    }
+
+    {
+        auto m = ctre::search<"(?<key>[a-z]+)=(?<value>[0-9]+)", ctre::compact_captures>(std::string_view{"-- abc=123 --"});
+        TEST("Named groups", m && m.get<"key">() == "abc" && m.get<"value">().to_number() == 123);
+    }
+
+    {
+        // Offsets are relative to the subject, so later groups far from the start work too
+        std::string text(1000, '.');
+        text += "k=42";
+        auto m = ctre::search<"([a-z])=([0-9]+)", ctre::compact_captures>(text);
+        TEST("Far offsets", m && m.get<1>().data() == text.data() + 1000 && m.get<2>() == "42");
+    }
+
+    {
+        std::string out;
+        for (auto item : ctre::search_all<"([a-z])([0-9])", ctre::compact_captures>(std::string_view{"a1 b2 c3"}))
+            out += item.get<2>().to_view();
+        TEST("Search all", out == "123");
+
+        std::string parts;
+        for (auto part : ctre::split<"(,)", ctre::compact_captures>(std::string_view{"a,b,c"})) parts += part.to_view();
+        TEST("Split", parts == "abc");
+    }
+
+    {
+        auto m = ctre::match<"(a+)(b+)", ctre::compact_captures, ctre::memoized>(std::string_view{"aabbb"});
+        TEST("With memoized", m && m.get<2>() == "bbb");
+    }
+
+    TEST("No match", (!ctre::match<"([a-z]+)@([a-z]+)", ctre::compact_captures>(std::string_view{"user"})));
+
+    std::cout << "\n=== Results ===\n";
+    std::cout << "Passed: " << tests_passed << "\n";
+    std::cout << "Failed: " << tests_failed << "\n";
+    return tests_failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,99 @@
+#include <ctre.hpp>
+#include <ctre/dfa/dfa_match.hpp>
+#include <iostream>
+#include <string>
+
+int tests_passed = 0;
+int tests_failed = 0;
+
+#define TEST(name) \
+    std::cout << "  " << #name << "... "; \
+    if (test_##name()) { tests_passed++; std::cout << "PASSED\n"; } \
+    else { tests_failed++; std::cout << "FAILED\n"; }
+
+template <ctll::fixed_string Pattern>
+using ast_of = decltype(ctll::front(typename ctll::parser<ctre::pcre, Pattern, ctre::pcre_actions>::template output<ctre::pcre_context<>>::output_type::stack_type()));
+
+// Byte classes: [0-9] splits the bytes into digits and the rest
+static_assert(ctre::dfa::forward_dfa<ast_of<"[0-9]+">>.class_count == 2);
+static_assert(ctre::dfa::forward_dfa<ast_of<"[0-9]+">>.state_count == 3);
+static_assert(ctre::dfa::dfa_viable_v<ast_of<"(ab|cd){2,4}x?">>);
+static_assert(!ctre::dfa::dfa_viable_v<ast_of<"^ab">>);
+static_assert(!ctre::dfa::dfa_viable_v<ast_of<"a+?b">>);
+static_assert(!ctre::dfa::dfa_viable_v<ast_of<"(a)\\1">>);
+// (a|b)*a(a|b){9} needs 2^10 subsets
+static_assert(!ctre::dfa::dfa_viable_v<ast_of<"(a|b)*a(a|b){9}">>);
+// Usable in constant expressions
+static_assert(ctre::dfa_match<"[a-f0-9]{8}">("deadbeef"));
+static_assert(ctre::dfa_search<"b+">("abbbc").to_view() == "bbb");
+// A sequence can end on an element only if everything after it may be empty
+static_assert(!ctre::dfa_match<"a+\\.b*">("a") && ctre::dfa_match<"a+\\.b*">("a."));
+
+std::string random_text(uint32_t& seed, const char* alphabet, size_t alphabet_size, size_t length) {
+    std::string text;
+    for (size_t i = 0; i < length; ++i) {
+        seed = seed * 1103515245u + 12345u;
+        text += alphabet[(seed >> 16) % alphabet_size];
+    }
+    return text;
+}
+
+// match must agree with ctre::match; search with the longest match at ctre::search's start
+// (patterns are chosen so that ctre's leftmost start is also the leftmost possible start)
+template <ctll::fixed_string Pattern>
+bool agrees_with_ctre(const char* alphabet, size_t alphabet_size) {
+    uint32_t seed = 2024;
+    for (int round = 0; round < 500; ++round) {
+        const std::string text = random_text(seed, alphabet, alphabet_size, static_cast<size_t>(round) % 24);
+        if (static_cast<bool>(ctre::dfa_match<Pattern>(text)) != static_cast<bool>(ctre::match<Pattern>(text)))
+            return false;
+        auto got = ctre::dfa_search<Pattern>(text);
+        auto want = ctre::search<Pattern>(text);
+        if (static_cast<bool>(got) != static_cast<bool>(want)) return false;
+        if (got && got.to_view().data() != want.to_view().data()) return false;
+        if (got && got.to_view().size() < want.to_view().size()) return false;
+    }
+    return true;
+}
+
+bool test_counted_repeats() {
+    return agrees_with_ctre<"a{2,3}b{0,2}c{2,}">("abc", 3) && agrees_with_ctre<"(ab){2}|ba">("ab", 2);
+}
+
+bool test_char_classes() {
+    return agrees_with_ctre<"[a-c]+[^a]x?">("abcx", 4) && agrees_with_ctre<"\\d+\\.\\w*">("1a._", 4);
+}
+
+bool test_alternation_in_loops() {
+    return agrees_with_ctre<"(a|bc)*d">("abcd", 4) && agrees_with_ctre<"x(y|z|yz)+">("xyz", 3);
+}
+
+bool test_nullable() {
+    return ctre::dfa_match<"a*">("") && ctre::dfa_search<"a*">("bbb").to_view().empty() &&
+           ctre::dfa_search<"a*">("bbb").to_view().data() != nullptr;
+}
+
+bool test_leftmost_longest() {
+    // Backtracking picks the first alternative; the DFA reports the longest match
+    auto r = ctre::dfa_search<"a|ab|abc">("xxabcd");
+    return r && r.to_view() == "abc" && ctre::search<"a|ab|abc">("xxabcd").to_view() == "a";
+}
+
+bool test_long_input() {
+    std::string text(100000, 'a');
+    text += "ab12";
+    auto r = ctre::dfa_search<"b[0-9]+">(text);
+    return r && r.to_view() == "b12" && !ctre::dfa_match<"a*">(text);
+}
+
+int main() {
+    std::cout << "Compile-time DFA tests\n";
+    TEST(counted_repeats);
+    TEST(char_classes);
+    TEST(alternation_in_loops);
+    TEST(nullable);
+    TEST(leftmost_longest);
+    TEST(long_input);
+    std::cout << "\nPassed: " << tests_passed << ", Failed: " << tests_failed << "\n";
+    return tests_failed == 0 ? 0 : 1;
+}
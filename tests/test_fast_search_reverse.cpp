@@ -0,0 +1,111 @@
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <ctre.hpp>
+
+int tests_passed = 0;
+int tests_failed = 0;
+
+#define TEST(name, cond) do { \
+    if (cond) { \
+        std::cout << "  [PASS] " << name << std::endl; \
+        tests_passed++; \
+    } else { \
+        std::cout << "  [FAIL] " << name << std::endl; \
+        tests_failed++; \
+    } \
+} while(0)
+
+template <ctll::fixed_string Pattern>
+using ast_of = decltype(ctll::front(typename ctll::parser<ctre::pcre, Pattern, ctre::pcre_actions>::template output<ctre::pcre_context<>>::output_type::stack_type()));
+
+template <ctll::fixed_string Pattern>
+using split_of = ctre::inner_literal_split<ast_of<Pattern>>;
+
+// Split at the longest string; prefix must be reversible
+static_assert(split_of<"[a-z]+@example\\.com">::value && split_of<"[a-z]+@example\\.com">::index == 1);
+static_assert(split_of<"(\\w+) says hello">::literal.length == 11);
+static_assert(split_of<"hello\\d+">::value && split_of<"hello\\d+">::index == 0);
+static_assert(!split_of<"\\bfoo\\d+bar">::value);
+static_assert(!split_of<"a+?bcd">::value);
+static_assert(!split_of<"[a-z]+">::value);
+// Only a prefix that cannot run across the literal is scanned backwards from each hit
+static_assert(ctre::reverse_prefix_viable<split_of<"[ab]+cde">>());
+static_assert(!ctre::reverse_prefix_viable<split_of<"[a-c]+cab">>());
+
+template <ctll::fixed_string Pattern>
+bool agrees_with_search(const char* alphabet, size_t alphabet_size, size_t max_length) {
+    uint32_t seed = 99;
+    for (int round = 0; round < 400; ++round) {
+        std::string text;
+        size_t length = static_cast<size_t>(round) % max_length;
+        for (size_t i = 0; i < length; ++i) {
+            seed = seed * 1103515245u + 12345u;
+            text += alphabet[(seed >> 16) % alphabet_size];
+        }
+        std::string_view view = text;
+        auto got = ctre::fast_search<Pattern>(view);
+        auto want = ctre::search<Pattern>(text.begin(), text.end());
+        if (static_cast<bool>(got) != static_cast<bool>(want)) return false;
+        if (got && (got.begin() - view.begin() != want.begin() - text.begin() || got.size() != want.size())) return false;
+    }
+    return true;
+}
+
+int main() {
+    std::cout << "=== fast_search Reverse Prefix Tests ===\n\n";
+
+    {
+        std::string text = "contact: " + std::string(100, 'q') + "@example.com.";
+        auto r = ctre::fast_search<"([a-z]+)@example\\.com">(std::string_view{text});
+        TEST("Prefix longer than 64 bytes", r && r.to_view().size() == 112 && r.get<1>().to_view().size() == 100);
+    }
+
+    {
+        std::string text(500, 'x');
+        text += "1234567890123456789012345678901234567890123456789012345678901234567890:end";
+        auto r = ctre::fast_search<"x\\d+:end">(std::string_view{text});
+        TEST("Match starts before a long digit run", r && r.to_view().size() == 75);
+    }
+
+    TEST("Char class prefix", (agrees_with_search<"[ab]+cde">("abcde", 5, 60)));
+    TEST("Alternation prefix", (agrees_with_search<"(a|bb)c?xyz">("abcxyz", 6, 60)));
+    TEST("Bounded repeat prefix", (agrees_with_search<"a{2,3}b*xy[a-c]">("abxy", 4, 60)));
+    TEST("Any prefix", (agrees_with_search<".+xy">("axy", 3, 40)));
+    TEST("Literal at start", (agrees_with_search<"xy\\d+">("xy12", 4, 40)));
+    TEST("Long random prefixes", (agrees_with_search<"[a-c]+cab">("abc", 3, 300)));
+    TEST("Long reversed prefixes", (agrees_with_search<"[a-c]+dab">("abcd", 4, 300)));
+
+    // The leftmost start is not the first alternative that reaches the hit
+    TEST("Longer alternative starts first", (ctre::fast_search<"(?:a|ba)cd">(std::string_view{"bacd"}).to_view() == "bacd"));
+    TEST("Repeated alternation", (ctre::fast_search<"(?:x|yx)+cd">(std::string_view{"yxyxcd"}).to_view() == "yxyxcd"));
+    TEST("Alternation differential", (agrees_with_search<"(?:a|ba)cd">("abcd", 4, 30)));
+    TEST("Repeated alternation differential", (agrees_with_search<"(?:x|yx)+cd">("xycd", 4, 30)));
+    // A later hit reaches back past an earlier one: "zcd" must not win over "yzcdecd"
+    TEST("Later hit starts earlier", (ctre::fast_search<"(?:y[a-z]{1,3}e|z)cd">(std::string_view{"yzcdecd"}).size() == 7));
+    TEST("Later hit differential", (agrees_with_search<"(?:y[a-z]{1,3}e|z)cd">("yzcde", 5, 40)));
+    // Backreferences rule out the DFA, the windows are evaluated instead
+    TEST("Window fallback", (agrees_with_search<"(a|ba|y[a-z]{1,3}e)cd\\1">("abcdye", 6, 40)));
+
+    // Patterns with the literal nested in a group go through the prefilter literal instead
+    {
+        std::string text = "-- " + std::string(100, 'q') + "needle.";
+        auto r = ctre::fast_search<"([a-z]+)(needle)">(std::string_view{text});
+        TEST("Nested literal, prefix longer than 64 bytes", r && r.to_view().size() == 106 && r.get<1>().to_view().size() == 100);
+    }
+    TEST("Nested literal differential", (agrees_with_search<"([a-c]+)(cab)">("abc", 3, 300)));
+
+    {
+        // Iterators other than pointers are prefiltered too
+        std::string text = "xx ab needle cd";
+        auto r = ctre::fast_search<"[a-z]+ needle">(text.cbegin(), text.cend());
+        TEST("String iterators", r && r.to_view() == "ab needle");
+        auto nested = ctre::fast_search<"([a-z]+) (needle)">(text.cbegin(), text.cend());
+        TEST("String iterators, nested literal", nested && nested.get<1>().to_view() == "ab");
+    }
+
+    std::cout << "\n=== Results ===\n";
+    std::cout << "Passed: " << tests_passed << "\n";
+    std::cout << "Failed: " << tests_failed << "\n";
+    return tests_failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,87 @@
+#include <ctre.hpp>
+#include <iostream>
+#include <string>
+#include <string_view>
+
+int tests_passed = 0;
+int tests_failed = 0;
+
+#define TEST(name, cond) do { \
+    if (cond) { \
+        std::cout << "  [PASS] " << name << std::endl; \
+        tests_passed++; \
+    } else { \
+        std::cout << "  [FAIL] " << name << std::endl; \
+        tests_failed++; \
+    } \
+} while(0)
+
+template <ctll::fixed_string Pattern>
+using ast_of = decltype(ctll::front(typename ctll::parser<ctre::pcre, Pattern, ctre::pcre_actions>::template output<ctre::pcre_context<>>::output_type::stack_type()));
+
+template <ctll::fixed_string Pattern>
+constexpr auto first_bytes = ctre::simd::first_byte_set_v<ast_of<Pattern>>;
+
+// First sets
+static_assert(first_bytes<"[0-9]+x">.usable && first_bytes<"[0-9]+x">.contiguous && first_bytes<"[0-9]+x">.count == 10);
+static_assert(first_bytes<"[0-9]*x">.count == 11 && !first_bytes<"[0-9]*x">.contiguous);
+static_assert(first_bytes<"\\b[qz][a-c]">.count == 2);
+static_assert(first_bytes<"(?:k|[0-9])y">.count == 11);
+// '\n' joins the set when $ can end a match
+static_assert(first_bytes<"[xk]?$">.count == 3 && first_bytes<"[xk]?$">.bytes['\n']);
+// Nullable, unknown or too dense: no skipping
+static_assert(!first_bytes<"[0-9]*">.usable);
+static_assert(!first_bytes<"\\bx?">.usable);
+static_assert(!first_bytes<".x">.usable);
+static_assert(!first_bytes<"(?i)k[0-9]">.usable);
+static_assert(!first_bytes<"(?<=a)b">.usable);
+static_assert(!first_bytes<"[^a-y]z">.usable);
+// Constant evaluation keeps the plain loop
+static_assert(ctre::search<"[0-9]+x">("abc12x").to_view() == "12x");
+
+// Reference: non-pointer iterators never take the skip loop
+template <ctll::fixed_string Pattern>
+bool agrees_with_reference(const char* alphabet, size_t alphabet_size) {
+    uint32_t seed = 11;
+    for (int round = 0; round < 400; ++round) {
+        std::string text;
+        const size_t length = static_cast<size_t>(round) % 100;
+        for (size_t i = 0; i < length; ++i) {
+            seed = seed * 1103515245u + 12345u;
+            text += alphabet[(seed >> 16) % alphabet_size];
+        }
+        auto got = ctre::search<Pattern>(std::string_view{text});
+        auto expected = ctre::search<Pattern>(text.begin(), text.end());
+        if (static_cast<bool>(got) != static_cast<bool>(expected)) return false;
+        if (got && (got.to_view().data() - text.data() != expected.begin() - text.begin() ||
+                    got.size() != expected.size()))
+            return false;
+    }
+    return true;
+}
+
+int main() {
+    std::cout << "=== First-Byte Skip Tests ===\n\n";
+
+    TEST("Range first set", (agrees_with_reference<"[0-9]+x">("ab19x ", 6)));
+    TEST("Optional head", (agrees_with_reference<"[0-9]*x">("ab9x  ", 6)));
+    TEST("Shufti first set", (agrees_with_reference<"\\b[qz][a-c]">("qzab d", 6)));
+    TEST("Alternation", (agrees_with_reference<"(?:k|[0-9])y">("k1yy..", 6)));
+    TEST("Line end", (agrees_with_reference<"[xk]?$">("ab\nk", 4)));
+
+    {
+        // Hit past the first vector blocks
+        std::string text(200, '.');
+        text.replace(150, 3, "7x!");
+        TEST("Long haystack", ctre::search<"[0-9]+x">(text).to_view() == "7x");
+        text[170] = 'q';
+        text[171] = 'b';
+        TEST("First of two", ctre::search<"\\b[qz][a-c]">(text).to_view() == "qb");
+        TEST("No candidate", !ctre::search<"[qz][0-9]">(text));
+    }
+
+    std::cout << "\n=== Results ===\n";
+    std::cout << "Passed: " << tests_passed << "\n";
+    std::cout << "Failed: " << tests_failed << "\n";
+    return tests_failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,94 @@
+#include <ctre.hpp>
+#include <ctre/lexer.hpp>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+int tests_passed = 0;
+int tests_failed = 0;
+
+#define TEST(name, cond) do { \
+    if (cond) { \
+        std::cout << "  [PASS] " << name << std::endl; \
+        tests_passed++; \
+    } else { \
+        std::cout << "  [FAIL] " << name << std::endl; \
+        tests_failed++; \
+    } \
+} while(0)
+
+enum token { kw_select, kw_from, identifier, number, op, whitespace, string_literal };
+
+using query_lexer = ctre::lexer<"select", "from", "[a-z_][a-z0-9_]*", "[0-9]+(\\.[0-9]+)?", "<=|>=|<>|[<>=,*]", "[ \\t\\n]+",
+                                "'([^'\\\\]|\\\\.)*'">;
+
+static_assert(query_lexer::size() == 7);
+// Constant evaluation
+static_assert(query_lexer::next("select x").token == kw_select);
+static_assert(query_lexer::next("selected").token == identifier && query_lexer::next("selected").span.size() == 8);
+static_assert(query_lexer::next("3.14)").span == "3.14");
+static_assert(query_lexer::next("?").token == query_lexer::no_token && query_lexer::next("?").span.empty());
+
+std::vector<ctre::lexeme> lex(std::string_view input, std::string_view* rest = nullptr) {
+    std::vector<ctre::lexeme> out;
+    auto left = query_lexer::tokenize(input, [&](const ctre::lexeme& l) { out.push_back(l); });
+    if (rest) *rest = left;
+    return out;
+}
+
+int main() {
+    std::cout << "=== Lexer Tests ===\n\n";
+
+    {
+        auto tokens = lex("select name, age from users where age >= 21");
+        const std::vector<size_t> expected = {kw_select, whitespace, identifier, op, whitespace, identifier, whitespace,
+                                              kw_from, whitespace, identifier, whitespace, identifier, whitespace,
+                                              identifier, whitespace, op, whitespace, number};
+        bool same = tokens.size() == expected.size();
+        for (size_t i = 0; same && i < tokens.size(); ++i) same = tokens[i].token == expected[i];
+        TEST("Token ids", same);
+        TEST("Spans", tokens.size() == expected.size() && tokens[15].span == ">=" && tokens[17].span == "21");
+    }
+
+    {
+        // Longest match beats the earlier token, ties go to the earlier one
+        auto tokens = lex("fromage from");
+        TEST("Keyword prefix", tokens.size() == 3 && tokens[0].token == identifier && tokens[0].span == "fromage");
+        TEST("Keyword tie", tokens.size() == 3 && tokens[2].token == kw_from);
+    }
+
+    {
+        auto tokens = lex("'it\\'s' <> 1.5");
+        TEST("String literal", tokens.size() == 5 && tokens[0].token == string_literal && tokens[0].span == "'it\\'s'");
+        TEST("Two-char operator", tokens.size() == 5 && tokens[2].span == "<>" && tokens[4].span == "1.5");
+    }
+
+    {
+        // Maximal munch backs off to the last accepting position
+        auto tokens = lex("12.x");
+        std::string_view rest;
+        lex("12.x", &rest);
+        TEST("Back off", tokens.size() == 1 && tokens[0].span == "12" && rest == ".x");
+    }
+
+    {
+        std::string_view rest;
+        auto tokens = lex("x = 'open", &rest);
+        TEST("Unlexable rest", tokens.size() == 4 && rest == "'open");
+        TEST("Empty input", lex("").empty());
+    }
+
+    {
+        std::string big;
+        for (int i = 0; i < 1000; ++i) big += "select a_1, 42 from t where b <= 7\n";
+        size_t count = 0;
+        auto rest = query_lexer::tokenize(big, [&](const ctre::lexeme&) { ++count; });
+        TEST("Large input", rest.empty() && count == 1000 * 19);
+    }
+
+    std::cout << "\n=== Results ===\n";
+    std::cout << "Passed: " << tests_passed << "\n";
+    std::cout << "Failed: " << tests_failed << "\n";
+    return tests_failed > 0 ? 1 : 0;
+}
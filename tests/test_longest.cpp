@@ -0,0 +1,114 @@
+#include <ctre.hpp>
+#include <iostream>
+#include <list>
+#include <string>
+#include <string_view>
+
+int tests_passed = 0;
+int tests_failed = 0;
+
+#define TEST(name, cond) do { \
+    if (cond) { \
+        std::cout << "  [PASS] " << name << std::endl; \
+        tests_passed++; \
+    } else { \
+        std::cout << "  [FAIL] " << name << std::endl; \
+        tests_failed++; \
+    } \
+} while(0)
+
+// Leftmost-first picks the first alternative, leftmost-longest the longest one
+static_assert(ctre::search<"a|ab|abc">("xabcd").to_view() == "a");
+static_assert(ctre::search<"a|ab|abc", ctre::longest>("xabcd").to_view() == "abc");
+static_assert(ctre::starts_with<"[0-9]+|[0-9]+\\.[0-9]+", ctre::longest>("3.14 rad").to_view() == "3.14");
+static_assert(!ctre::search<"x+y", ctre::longest>("xxx"));
+
+// Reference: for the leftmost start with any match, the longest anchored match
+template <ctll::fixed_string Pattern>
+std::string_view leftmost_longest(std::string_view text) {
+    for (size_t start = 0; start <= text.size(); ++start)
+        for (size_t length = text.size() - start + 1; length-- > 0;)
+            if (ctre::match<Pattern>(text.substr(start, length))) return text.substr(start, length);
+    return {};
+}
+
+template <ctll::fixed_string Pattern>
+bool agrees_with_reference(const char* alphabet, size_t alphabet_size) {
+    uint32_t seed = 3;
+    for (int round = 0; round < 300; ++round) {
+        std::string text;
+        const size_t length = static_cast<size_t>(round) % 20;
+        for (size_t i = 0; i < length; ++i) {
+            seed = seed * 1103515245u + 12345u;
+            text += alphabet[(seed >> 16) % alphabet_size];
+        }
+        const std::string_view view{text};
+        const auto expected = leftmost_longest<Pattern>(view);
+        auto got = ctre::search<Pattern, ctre::longest>(view);
+        if (static_cast<bool>(got) != (expected.data() != nullptr)) return false;
+        if (got && (got.to_view().data() != expected.data() || got.size() != expected.size())) return false;
+        // Iterators without the backward pass agree too
+        auto forward = ctre::search<Pattern, ctre::longest>(text.begin(), text.end());
+        if (static_cast<bool>(forward) != static_cast<bool>(got)) return false;
+        if (forward && (&*forward.begin() != got.to_view().data() || forward.size() != got.size())) return false;
+    }
+    return true;
+}
+
+int main() {
+    std::cout << "=== Leftmost-Longest Tests ===\n\n";
+
+    TEST("Alternation", (agrees_with_reference<"a|ab|abc|bcd">("abcd", 4)));
+    TEST("Repeats", (agrees_with_reference<"(?:a|ab)(?:c|bcd)*">("abcd", 4)));
+    TEST("Optional tail", (agrees_with_reference<"x(?:yz)?|xy">("xyz", 3)));
+    TEST("Counted repeat", (agrees_with_reference<"[ab]{2,4}">("abc", 3)));
+
+    {
+        // Captures are filled within the longest span
+        auto m = ctre::search<"([a-z]+)(=|==)([0-9]*)", ctre::longest>(std::string_view{"if x==42 then"});
+        TEST("Captures", m && m.to_view() == "x==42" && m.get<1>() == "x" && m.get<2>() == "==" && m.get<3>() == "42");
+    }
+
+    {
+        std::string out;
+        for (auto item : ctre::search_all<"<|<=|<<|<<=", ctre::longest>(std::string_view{"a<<=b<c<=d"})) {
+            out += item.to_view();
+            out += ' ';
+        }
+        TEST("Search all", out == "<<= < <= ");
+        std::string tokens;
+        for (auto item : ctre::tokenize<"[a-z]+|[a-z]+[0-9]+|[ ]", ctre::longest>(std::string_view{"ab12 cd"})) {
+            tokens += item.to_view();
+            tokens += '|';
+        }
+        TEST("Tokenize", tokens == "ab12| |cd|");
+
+        // Each search stops near its match; a long run with no match falls back to one backward pass
+        std::string text;
+        for (int i = 0; i < 2000; ++i) text += "ab=" + std::to_string(i) + ",";
+        text += std::string(5000, 'q');
+        size_t count = 0;
+        std::string_view last;
+        for (auto item : ctre::search_all<"[a-z]+=[0-9]+", ctre::longest>(std::string_view{text})) {
+            ++count;
+            last = item.to_view();
+        }
+        TEST("Search all many matches", count == 2000 && last == "ab=1999");
+    }
+
+    {
+        // Forward-only iterators take the start-by-start scan
+        std::list<char> chars{'x', 'a', 'b', 'c'};
+        auto m = ctre::search<"a|abc", ctre::longest>(chars.begin(), chars.end());
+        TEST("Forward iterators", m && m.size() == 3);
+    }
+
+    TEST("No match", (!ctre::search<"a|ab", ctre::longest>(std::string_view{"xyz"})));
+    TEST("Empty match", (ctre::search<"a*", ctre::longest>(std::string_view{"bbb"}).size() == 0));
+    TEST("Match unchanged", (ctre::match<"a|ab", ctre::longest>(std::string_view{"ab"})));
+
+    std::cout << "\n=== Results ===\n";
+    std::cout << "Passed: " << tests_passed << "\n";
+    std::cout << "Failed: " << tests_failed << "\n";
+    return tests_failed > 0 ? 1 : 0;
+}
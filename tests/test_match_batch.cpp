@@ -0,0 +1,87 @@
+#include <ctre.hpp>
+#include <ctre/dfa/match_batch.hpp>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+int tests_passed = 0;
+int tests_failed = 0;
+
+#define TEST(name, cond) do { \
+    if (cond) { \
+        std::cout << "  [PASS] " << name << std::endl; \
+        tests_passed++; \
+    } else { \
+        std::cout << "  [FAIL] " << name << std::endl; \
+        tests_failed++; \
+    } \
+} while(0)
+
+template <ctll::fixed_string Pattern>
+using ast_of = decltype(ctll::front(typename ctll::parser<ctre::pcre, Pattern, ctre::pcre_actions>::template output<ctre::pcre_context<>>::output_type::stack_type()));
+
+static_assert(ctre::dfa::sheng_batch_v<ast_of<"[0-9a-f]{8}-[0-9a-f]{4}">>);
+// Captures do not matter for a yes/no answer
+static_assert(ctre::dfa::sheng_batch_v<ast_of<"(ab|cd)+">>);
+static_assert(!ctre::dfa::sheng_batch_v<ast_of<"[0-9a-f]{40}">>);
+static_assert(!ctre::dfa::sheng_batch_v<ast_of<"^a$">>);
+
+// Tokens drawn from the alphabet, about a third of them built to match
+template <ctll::fixed_string Pattern>
+bool agrees_with_match(const char* alphabet, size_t alphabet_size, const char* sample) {
+    uint32_t seed = 10;
+    std::vector<std::string> storage;
+    for (size_t i = 0; i < 203; ++i) {
+        seed = seed * 1103515245u + 12345u;
+        std::string token = (seed >> 16) % 3 == 0 ? sample : "";
+        const size_t extra = (seed >> 8) % 45;
+        for (size_t j = 0; j < extra && token.empty(); ++j) {
+            seed = seed * 1103515245u + 12345u;
+            token += alphabet[(seed >> 16) % alphabet_size];
+        }
+        if ((seed >> 20) % 4 == 0 && !token.empty()) token[(seed >> 4) % token.size()] = alphabet[0];
+        storage.push_back(token);
+    }
+    std::vector<std::string_view> inputs(storage.begin(), storage.end());
+    // Every batch size, so all lane tails are exercised
+    for (size_t n = 0; n <= inputs.size(); n += (n < 70 ? 1 : 33)) {
+        std::vector<uint64_t> bits((n + 63) / 64 + 1, ~uint64_t{0});
+        const size_t total = ctre::match_batch<Pattern>(std::span<const std::string_view>(inputs.data(), n), bits);
+        size_t expected = 0;
+        for (size_t i = 0; i < n; ++i) {
+            const bool want = static_cast<bool>(ctre::match<Pattern>(inputs[i]));
+            expected += want;
+            if (static_cast<bool>((bits[i / 64] >> (i % 64)) & 1) != want) return false;
+        }
+        if (total != expected) return false;
+    }
+    return true;
+}
+
+// A matched span shorter than the batch only gets the inputs it has bits for
+template <ctll::fixed_string Pattern>
+bool clamps_to_matched(size_t words) {
+    const std::vector<std::string_view> inputs(150, "deadbeef-0123");
+    std::vector<uint64_t> bits(words + 1, 0x5a5a);
+    const size_t total = ctre::match_batch<Pattern>(inputs, std::span<uint64_t>(bits.data(), words));
+    return total == std::min(inputs.size(), words * 64) && bits[words] == 0x5a5a;
+}
+
+int main() {
+    std::cout << "=== match_batch Tests ===\n\n";
+
+    TEST("Hex validator", (agrees_with_match<"[0-9a-f]{8}-[0-9a-f]{4}">("0a9f-x", 6, "deadbeef-0123")));
+    TEST("Loop with captures", (agrees_with_match<"(ab|cd)+">("abcd", 4, "abcdab")));
+    TEST("Long tokens", (agrees_with_match<"x[a-z]*y">("xyab", 4, "xabababababababababababababababababababababababababababababababababababy")));
+    TEST("Fallback: too many states", (agrees_with_match<"[0-9a-f]{40}">("0af", 3, "0123456789abcdef0123456789abcdef01234567")));
+    TEST("Fallback: assertions", (agrees_with_match<"a+\\b">("ab", 2, "aaa")));
+    TEST("Short matched span", clamps_to_matched<"[0-9a-f]{8}-[0-9a-f]{4}">(1) &&
+                               clamps_to_matched<"[0-9a-f]{40}|deadbeef-0123">(2) &&
+                               clamps_to_matched<"[0-9a-f]{8}-[0-9a-f]{4}">(0));
+
+    std::cout << "\n=== Results ===\n";
+    std::cout << "Passed: " << tests_passed << "\n";
+    std::cout << "Failed: " << tests_failed << "\n";
+    return tests_failed > 0 ? 1 : 0;
+}
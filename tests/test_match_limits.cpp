@@ -0,0 +1,84 @@
+#include <ctre.hpp>
+#include <ctre/limits.hpp>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <string_view>
+
+int tests_passed = 0;
+int tests_failed = 0;
+
+#define TEST(name, cond) do { \
+    if (cond) { \
+        std::cout << "  [PASS] " << name << std::endl; \
+        tests_passed++; \
+    } else { \
+        std::cout << "  [FAIL] " << name << std::endl; \
+        tests_failed++; \
+    } \
+} while(0)
+
+// Ticks go before every alternative and into every repeat body
+static_assert(std::is_same_v<ctre::limited_t<ctre::select<ctre::character<'a'>, ctre::character<'b'>>>,
+                             ctre::select<ctre::sequence<ctre::step_tick, ctre::character<'a'>>,
+                                          ctre::sequence<ctre::step_tick, ctre::character<'b'>>>>);
+static_assert(std::is_same_v<ctre::limited_t<ctre::capture<1, ctre::repeat<0, 0, ctre::any>>>,
+                             ctre::capture<1, ctre::repeat<0, 0, ctre::step_tick, ctre::any>>>);
+
+int main() {
+    std::cout << "=== Match Limits Tests ===\n\n";
+
+    {
+        ctre::match_limits limits;
+        auto r = ctre::limited_match<"(\\w+)-(\\d+)">(limits, std::string_view{"abc-123"});
+        TEST("Unlimited match", r && r.result.get<1>().to_view() == "abc" && r.result.get<2>().to_view() == "123");
+        TEST("Steps counted", limits.steps > 0 && !limits.exceeded);
+    }
+    {
+        ctre::match_limits limits{1000};
+        auto r = ctre::limited_search<"[0-9]+">(limits, std::string_view{"abc 42 def"});
+        TEST("Search within budget", r && r.result.to_view() == "42");
+        auto miss = ctre::limited_match<"[0-9]+">(limits, std::string_view{"abc"});
+        TEST("Plain mismatch", !miss && miss.status == ctre::match_status::not_matched);
+        auto prefix = ctre::limited_starts_with<"ab|x">(limits, std::string_view{"abc"});
+        TEST("Starts with", prefix && prefix.result.to_view() == "ab");
+    }
+
+    const std::string hostile(2000, 'a');
+    {
+        ctre::match_limits limits{100000};
+        auto r = ctre::limited_search<"(?:a*?)*a*?a*?c">(limits, hostile);
+        TEST("Step budget exceeded", !r && r.limit_exceeded());
+        TEST("Stops at the budget", limits.steps <= 100001);
+    }
+    {
+        // Shared limits keep counting: a spent budget fails the next call too
+        ctre::match_limits limits{50};
+        (void)ctre::limited_search<"(?:a*?)*a*?a*?c">(limits, hostile);
+        auto r = ctre::limited_search<"a">(limits, std::string_view{"xxa"});
+        TEST("Spent budget", r.limit_exceeded());
+    }
+    {
+        // Failing ticks make a negative lookahead succeed; that match must not be reported
+        const std::string_view subject = "aaaaab";
+        ctre::match_limits limits{4};
+        auto r = ctre::limited_search<"(?!(?:a)+b)[a-z]">(limits, subject);
+        TEST("Lookahead under a spent budget", !r && r.limit_exceeded());
+        ctre::match_limits enough{1000};
+        auto full = ctre::limited_search<"(?!(?:a)+b)[a-z]">(enough, subject);
+        TEST("Lookahead within budget", full && full.result.to_view() == "b" && full.result.begin() == subject.begin() + 5);
+    }
+    {
+        const auto start = ctre::match_limits::clock::now();
+        ctre::match_limits limits{start + std::chrono::milliseconds(20)};
+        auto r = ctre::limited_search<"(?:a*?)*a*?a*?c">(limits, hostile);
+        const auto took = ctre::match_limits::clock::now() - start;
+        TEST("Deadline exceeded", r.limit_exceeded());
+        TEST("Deadline honoured", took < std::chrono::seconds(2));
+    }
+
+    std::cout << "\n=== Results ===\n";
+    std::cout << "Passed: " << tests_passed << "\n";
+    std::cout << "Failed: " << tests_failed << "\n";
+    return tests_failed > 0 ? 1 : 0;
+}
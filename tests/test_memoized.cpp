@@ -0,0 +1,88 @@
+#include <ctre.hpp>
+#include <iostream>
+#include <string>
+#include <string_view>
+
+int tests_passed = 0;
+int tests_failed = 0;
+
+#define TEST(name, cond) do { \
+    if (cond) { \
+        std::cout << "  [PASS] " << name << std::endl; \
+        tests_passed++; \
+    } else { \
+        std::cout << "  [FAIL] " << name << std::endl; \
+        tests_failed++; \
+    } \
+} while(0)
+
+template <ctll::fixed_string Pattern>
+using ast_of = decltype(ctll::front(typename ctll::parser<ctre::pcre, Pattern, ctre::pcre_actions>::template output<ctre::pcre_context<>>::output_type::stack_type()));
+
+using iter = std::string_view::iterator;
+
+// One memo point per select and repeat
+static_assert(ctre::memo_point_count<ast_of<"(a|aa)*b">> == 2);
+static_assert(ctre::memo_point_count<ast_of<"abc">> == 0);
+static_assert(ctre::memo_point_count<ast_of<"x++(?:y|z)">> == 1);
+// Opt-in, and only where a failure depends on the position alone
+static_assert(ctre::use_memoization<ctre::memoized, ast_of<"(a|aa)*b">, iter, iter>);
+static_assert(!ctre::use_memoization<ctre::singleline, ast_of<"(a|aa)*b">, iter, iter>);
+static_assert(!ctre::use_memoization<ctre::memoized, ast_of<"(a+)\\1">, iter, iter>);
+static_assert(!ctre::use_memoization<ctre::memoized, ast_of<"a(?i)b*">, iter, iter>);
+static_assert(!ctre::use_memoization<ctre::memoized, ast_of<"a*b">, iter, ctre::zero_terminated_string_end_iterator>);
+// Constant evaluation keeps the plain path
+static_assert(ctre::search<"(a|aa)*b", ctre::memoized>("aaab"));
+
+// Same match and captures as without memoization
+template <ctll::fixed_string Pattern>
+bool agrees_with_plain(const char* alphabet, size_t alphabet_size) {
+    uint32_t seed = 7;
+    for (int round = 0; round < 300; ++round) {
+        std::string text;
+        const size_t length = static_cast<size_t>(round) % 40;
+        for (size_t i = 0; i < length; ++i) {
+            seed = seed * 1103515245u + 12345u;
+            text += alphabet[(seed >> 16) % alphabet_size];
+        }
+        const std::string_view view{text};
+        auto got = ctre::search<Pattern, ctre::memoized>(view);
+        auto expected = ctre::search<Pattern>(view);
+        if (static_cast<bool>(got) != static_cast<bool>(expected)) return false;
+        if (got && (got.to_view() != expected.to_view() || got.template get<1>().to_view() != expected.template get<1>().to_view()))
+            return false;
+        if (static_cast<bool>(ctre::match<Pattern, ctre::memoized>(view)) != static_cast<bool>(ctre::match<Pattern>(view)))
+            return false;
+        if (ctre::starts_with<Pattern, ctre::memoized>(view).to_view() != ctre::starts_with<Pattern>(view).to_view())
+            return false;
+    }
+    return true;
+}
+
+int main() {
+    std::cout << "=== Memoized Backtracking Tests ===\n\n";
+
+    TEST("Alternation in repeat", (agrees_with_plain<"(a|aa)*b">("aab", 3)));
+    TEST("Colliding repeat", (agrees_with_plain<"(a|ab)*abc">("abc", 3)));
+    TEST("Nested repeats", (agrees_with_plain<"((?:x+x+)+)y">("xy", 2)));
+    TEST("Lazy repeat", (agrees_with_plain<"(a+?)b*?c">("abc", 3)));
+    TEST("Bounded repeat", (agrees_with_plain<"(a{2,3})+b">("ab", 2)));
+    TEST("Lookahead", (agrees_with_plain<"(\\w+)(?=\\d)">("a1 ", 3)));
+
+    {
+        const std::string text(20000, 'a');
+        TEST("Long failing search", !(ctre::search<"(a|aa)*b", ctre::memoized>(text)));
+        TEST("Long colliding search", !(ctre::search<"(a|aa)*ab", ctre::memoized>(text)));
+        TEST("Long nested match", !(ctre::match<"(?:a+a+)+b", ctre::memoized>(text)));
+        TEST("Long success", (ctre::match<"(a|aa)*a", ctre::memoized>(text)));
+    }
+    {
+        auto r = ctre::match<"(\\w+)(\\s?)(x)?", ctre::memoized>(std::string_view{"hello "});
+        TEST("Captures", r && r.get<1>().to_view() == "hello" && r.get<2>().to_view() == " " && !r.get<3>());
+    }
+
+    std::cout << "\n=== Results ===\n";
+    std::cout << "Passed: " << tests_passed << "\n";
+    std::cout << "Failed: " << tests_failed << "\n";
+    return tests_failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,90 @@
+#include <ctre.hpp>
+#include <ctre/parallel.hpp>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+int tests_passed = 0;
+int tests_failed = 0;
+
+#define TEST(name, cond) do { \
+    if (cond) { \
+        std::cout << "  [PASS] " << name << std::endl; \
+        tests_passed++; \
+    } else { \
+        std::cout << "  [FAIL] " << name << std::endl; \
+        tests_failed++; \
+    } \
+} while(0)
+
+template <ctll::fixed_string Pattern>
+using ast_of = decltype(ctll::front(typename ctll::parser<ctre::pcre, Pattern, ctre::pcre_actions>::template output<ctre::pcre_context<>>::output_type::stack_type()));
+
+static_assert(ctre::max_match_length_v<ast_of<"ab[0-9]{2,4}">> == 6);
+static_assert(ctre::max_match_length_v<ast_of<"(foo|ba)?x">> == 4);
+static_assert(ctre::max_match_length_v<ast_of<"a+">> == ctre::unbounded_match_length);
+static_assert(ctre::max_match_length_v<ast_of<"a$">> == ctre::unbounded_match_length);
+static_assert(ctre::max_match_length_v<ast_of<"(?<=x)a">> == ctre::unbounded_match_length);
+
+// Runs the tasks one after another, in reverse to shake out ordering assumptions
+struct serial_executor {
+    template <typename Task>
+    void operator()(size_t count, Task&& task) const {
+        for (size_t i = count; i-- > 0;) task(i);
+    }
+};
+
+template <ctll::fixed_string Pattern, typename Results>
+bool same_as_search_all(std::string_view text, const Results& got) {
+    size_t k = 0;
+    for (auto m : ctre::search_all<Pattern>(text)) {
+        if (k == got.size()) return false;
+        const auto& g = got[k++];
+        if (g.to_view().data() != m.to_view().data() || g.size() != m.size()) return false;
+        if constexpr (decltype(m)::count() > 1)
+            if (g.template get<1>().to_view() != m.template get<1>().to_view()) return false;
+    }
+    return k == got.size();
+}
+
+template <ctll::fixed_string Pattern>
+bool agrees_with_search_all(const char* alphabet, size_t alphabet_size) {
+    uint32_t seed = 9;
+    for (int round = 0; round < 200; ++round) {
+        std::string text;
+        const size_t length = static_cast<size_t>(round) % 70;
+        for (size_t i = 0; i < length; ++i) {
+            seed = seed * 1103515245u + 12345u;
+            text += alphabet[(seed >> 16) % alphabet_size];
+        }
+        for (size_t chunks : {size_t{1}, size_t{2}, size_t{5}, length + 1})
+            if (!same_as_search_all<Pattern>(text, ctre::parallel_find_all<Pattern>(text, serial_executor{}, chunks)))
+                return false;
+    }
+    return true;
+}
+
+int main() {
+    std::cout << "=== Parallel find_all Tests ===\n\n";
+
+    TEST("Bounded pattern", (agrees_with_search_all<"ab[0-9]{1,3}">("ab12", 4)));
+    TEST("Bounded alternation", (agrees_with_search_all<"(aba|ab|b)a">("ab", 2)));
+    TEST("Unbounded pattern", (agrees_with_search_all<"a+b?">("abc", 3)));
+    TEST("Unbounded with captures", (agrees_with_search_all<"x([ab]*)y">("xaby", 4)));
+    TEST("Lookbehind sees the previous chunk", (agrees_with_search_all<"(?<=a)b+">("ab", 2)));
+    TEST("End anchor", (agrees_with_search_all<"ab$">("ab", 2)));
+
+    {
+        std::string log;
+        for (int i = 0; i < 50000; ++i) log += "id=" + std::to_string(i) + ";";
+        const auto got = ctre::parallel_find_all<"id=([0-9]+)">(log, ctre::thread_executor{}, 4);
+        TEST("Threads, document order", got.size() == 50000 && got[12345].get<1>().to_view() == "12345" &&
+                                            same_as_search_all<"id=([0-9]+)">(log, got));
+    }
+
+    std::cout << "\n=== Results ===\n";
+    std::cout << "Passed: " << tests_passed << "\n";
+    std::cout << "Failed: " << tests_failed << "\n";
+    return tests_failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,98 @@
+#include <ctre.hpp>
+#include <ctre/pattern_set.hpp>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+int tests_passed = 0;
+int tests_failed = 0;
+
+#define TEST(name, cond) do { \
+    if (cond) { \
+        std::cout << "  [PASS] " << name << std::endl; \
+        tests_passed++; \
+    } else { \
+        std::cout << "  [FAIL] " << name << std::endl; \
+        tests_failed++; \
+    } \
+} while(0)
+
+using log_patterns = ctre::pattern_set<"ERROR [0-9]+", "timeout after [0-9]+ms", "user=([a-z]+)", "[0-9]+\\.[0-9]+\\.[0-9]+\\.[0-9]+",
+                                       "(?i)warn", "disk (full|failure)">;
+
+static_assert(log_patterns::size() == 6);
+static_assert(log_patterns::prefiltered(0) && log_patterns::prefiltered(1) && log_patterns::prefiltered(2));
+// No literal every match contains, or one under a mode switch
+static_assert(!log_patterns::prefiltered(3) && !log_patterns::prefiltered(4));
+
+// Reference: every pattern searched for on its own
+template <ctll::fixed_string... Patterns>
+std::vector<ctre::pattern_match> reference(std::string_view subject) {
+    std::vector<ctre::pattern_match> out;
+    size_t index = 0;
+    ((void)[&] {
+        if (auto r = ctre::search<Patterns>(subject)) out.push_back({index, r.to_view()});
+        ++index;
+    }(), ...);
+    return out;
+}
+
+bool same(const std::vector<ctre::pattern_match>& a, const std::vector<ctre::pattern_match>& b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); ++i)
+        if (a[i].index != b[i].index || a[i].span.data() != b[i].span.data() || a[i].span.size() != b[i].span.size()) return false;
+    return true;
+}
+
+template <ctll::fixed_string... Patterns>
+bool agrees_with_reference(const char* alphabet, size_t alphabet_size) {
+    uint32_t seed = 11;
+    for (int round = 0; round < 400; ++round) {
+        std::string text;
+        const size_t length = static_cast<size_t>(round) % 60;
+        for (size_t i = 0; i < length; ++i) {
+            seed = seed * 1103515245u + 12345u;
+            text += alphabet[(seed >> 16) % alphabet_size];
+        }
+        if (!same(ctre::pattern_set<Patterns...>::matches(text), reference<Patterns...>(text))) return false;
+    }
+    return true;
+}
+
+int main() {
+    std::cout << "=== Pattern Set Tests ===\n\n";
+
+    {
+        auto found = log_patterns::matches("2024-01-01 ERROR 42 from 10.0.0.1: disk full, user=root");
+        TEST("Several patterns", found.size() == 4);
+        TEST("Pattern order", found.size() == 4 && found[0].index == 0 && found[1].index == 2 && found[2].index == 3 && found[3].index == 5);
+        TEST("Spans", found.size() == 4 && found[0].span == "ERROR 42" && found[1].span == "user=root" && found[3].span == "disk full");
+    }
+
+    {
+        auto found = log_patterns::matches("WARN: timeout after 300ms");
+        TEST("Mode switch always searched", found.size() == 2 && found[0].index == 1 && found[1].index == 4 && found[1].span == "WARN");
+    }
+
+    TEST("Literal without match", log_patterns::matches("ERROR x user= disk").empty());
+    TEST("Empty subject", log_patterns::matches("").empty());
+
+    {
+        size_t calls = 0;
+        log_patterns::scan("user=admin user=guest", [&](const ctre::pattern_match& m) {
+            calls++;
+            TEST("First match only", m.index == 2 && m.span == "user=admin");
+        });
+        TEST("Scan callback", calls == 1);
+    }
+
+    // Overlapping literals: suffixes reached through fail links
+    TEST("Overlapping literals", (agrees_with_reference<"abab", "bab+", "b", "ab?c", "[a-c]+d", "cab|d">("abcd ", 5)));
+    TEST("Shared prefixes", (agrees_with_reference<"ab", "abc", "abcd", "bc", "c+">("abcd", 4)));
+
+    std::cout << "\n=== Results ===\n";
+    std::cout << "Passed: " << tests_passed << "\n";
+    std::cout << "Failed: " << tests_failed << "\n";
+    return tests_failed > 0 ? 1 : 0;
+}
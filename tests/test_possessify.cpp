@@ -0,0 +1,82 @@
+#include <ctre.hpp>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+int tests_passed = 0;
+int tests_failed = 0;
+
+#define TEST(name, cond) do { \
+    if (cond) { \
+        std::cout << "  [PASS] " << name << std::endl; \
+        tests_passed++; \
+    } else { \
+        std::cout << "  [FAIL] " << name << std::endl; \
+        tests_failed++; \
+    } \
+} while(0)
+
+template <ctll::fixed_string Pattern>
+using ast_of = decltype(ctll::front(typename ctll::parser<ctre::pcre, Pattern, ctre::pcre_actions>::template output<ctre::pcre_context<>>::output_type::stack_type()));
+
+template <ctll::fixed_string Pattern>
+using rewritten = ctre::possessified_t<ast_of<Pattern>>;
+
+template <ctll::fixed_string Pattern, ctll::fixed_string Expected>
+constexpr bool rewrites_to = std::is_same_v<rewritten<Pattern>, ast_of<Expected>>;
+
+// Disjoint follow sets turn possessive
+static_assert(rewrites_to<"[a-z]+@", "[a-z]++@">);
+static_assert(rewrites_to<"\\d+\\.", "\\d++\\.">);
+static_assert(rewrites_to<"[a-z]+", "[a-z]++">);
+static_assert(rewrites_to<"x*y?z", "x*+y?+z">);
+static_assert(rewrites_to<"([0-9]+)-([0-9]+)", "([0-9]++)-([0-9]++)">);
+static_assert(rewrites_to<"(?:a|b+)c", "(?:a|b++)c">);
+static_assert(rewrites_to<"(?=[0-9]+x)", "(?=[0-9]++x)">);
+// Overlapping follow sets stay greedy
+static_assert(rewrites_to<"[a-z]+z", "[a-z]+z">);
+static_assert(rewrites_to<"a*ab", "a*ab">);
+static_assert(rewrites_to<".*x", ".*x">);
+static_assert(rewrites_to<"(?:[0-9]+)+[0-9]", "(?:[0-9]++)+[0-9]">);
+// Lazy repeats are never touched
+static_assert(rewrites_to<"[a-z]+?@", "[a-z]+?@">);
+// Case folding makes the first sets meaningless
+static_assert(!ctre::use_possessify<ast_of<"[a-z]+A">, ctre::case_insensitive>);
+static_assert(!ctre::use_possessify<ast_of<"(?i)[a-z]+A">, ctre::singleline>);
+static_assert(ctre::use_possessify<ast_of<"[a-z]+A">, ctre::singleline>);
+// Constant evaluation runs the rewritten pattern too
+static_assert(ctre::match<"([a-z]+)@([a-z]+)">("user@host").get<1>() == "user");
+static_assert(ctre::search<"\\d+\\.">("v 12.5").to_view() == "12.");
+
+int main() {
+    std::cout << "=== Automatic Possessification Tests ===\n\n";
+
+    TEST("Email-like", ctre::match<"[a-z]+@[a-z]+\\.[a-z]+">("user@example.com"));
+    TEST("Digits then dot", ctre::search<"\\d+\\.">("version 3141.59").to_view() == "3141.");
+    TEST("Overlap still backtracks", ctre::match<"[a-z]+z">("abcz"));
+    TEST("Star overlap", ctre::match<"a*ab">("aaab"));
+
+    {
+        auto m = ctre::match<"([0-9]+)-([0-9]+)">("123-4567");
+        TEST("Captures kept", m && m.get<1>() == "123" && m.get<2>() == "4567");
+    }
+
+    TEST("Case-insensitive modifier", (ctre::match<"[a-z]+A", ctre::case_insensitive>("abcA")));
+    TEST("Inline case-insensitive", ctre::match<"(?i)[a-z]+A">("abcA"));
+
+    {
+        // Long runs take the possessive scan
+        std::string text(300, 'k');
+        text += "@host";
+        TEST("Long run", ctre::match<"[a-z]+@[a-z]+">(text));
+        text.back() = '!';
+        TEST("Long run mismatch", !ctre::match<"[a-z]+@[a-z]+">(text));
+        TEST("Starts with", ctre::starts_with<"[a-z]+@">(text).size() == 301);
+    }
+
+    std::cout << "\n=== Results ===\n";
+    std::cout << "Passed: " << tests_passed << "\n";
+    std::cout << "Failed: " << tests_failed << "\n";
+    return tests_failed > 0 ? 1 : 0;
+}
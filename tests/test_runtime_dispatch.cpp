@@ -0,0 +1,83 @@
+#include <ctre.hpp>
+#include <ctre/simd/literal_search.hpp>
+#include <ctre/simd/single_char.hpp>
+#include <iostream>
+#include <string>
+
+int tests_passed = 0;
+int tests_failed = 0;
+
+#define TEST(name, cond) do { \
+    if (cond) { \
+        std::cout << "  [PASS] " << name << std::endl; \
+        tests_passed++; \
+    } else { \
+        std::cout << "  [FAIL] " << name << std::endl; \
+        tests_failed++; \
+    } \
+} while(0)
+
+// Runs of length n followed by a stop byte, for every n across the 16/32/64 byte
+// vector boundaries; whichever kernel the CPU dispatches to must agree with n
+template <ctll::fixed_string Pattern>
+bool runs_agree(char fill, char stop) {
+    for (size_t n = 1; n < 200; ++n) {
+        const std::string run(n, fill);
+        if (!ctre::match<Pattern>(run)) return false;
+        if (ctre::starts_with<Pattern>(run + stop + run).size() != n) return false;
+    }
+    return true;
+}
+
+bool single_char_agrees() {
+    std::string text(300, 'a');
+    for (size_t n = 0; n < 200; ++n) {
+        text[n] = 'b';
+        for (size_t length = n; length <= n + 40; ++length) {
+            const size_t expected = ctre::simd::match_single_char_scalar<'a'>(text.data(), length);
+            if (ctre::simd::match_single_char_repeat<'a'>(text.data(), length) != expected) return false;
+            // Every tier the CPU runs, not only the one dispatched to
+            if (ctre::simd::has_sse42() && ctre::simd::match_single_char_sse42<'a'>(text.data(), length) != expected)
+                return false;
+            if (ctre::simd::has_avx2() && ctre::simd::match_single_char_avx2<'a'>(text.data(), length) != expected)
+                return false;
+        }
+        text[n] = 'a';
+    }
+    return true;
+}
+
+bool literal_search_agrees() {
+    static const char literal[] = "aab";
+    for (size_t at = 0; at < 100; ++at) {
+        std::string text(120, 'x');
+        text.replace(at, 4, "aaab");
+        const char* begin = text.data();
+        for (size_t length = 0; length <= text.size(); ++length) {
+            const bool expected = ctre::simd::search_literal_scalar(begin, begin + length, literal);
+            if (ctre::simd::search_literal(begin, begin + length, literal) != expected) return false;
+            if (ctre::simd::has_sse42() && ctre::simd::search_literal_sse42(begin, begin + length, literal) != expected)
+                return false;
+        }
+    }
+    return true;
+}
+
+int main() {
+    std::cout << "=== Runtime Dispatch Tests ===\n\n";
+    std::cout << "  AVX2: " << ctre::simd::has_avx2() << ", SSE4.2: " << ctre::simd::has_sse42() << "\n";
+
+    TEST("Single char run", (runs_agree<"a+">('a', 'b')));
+    TEST("Range run", (runs_agree<"[0-9]+">('7', 'x')));
+    TEST("Case-insensitive run", (runs_agree<"(?i)[a-f]+">('C', 'g')));
+    TEST("Multirange run", (runs_agree<"[a-zA-Z0-9]+">('Q', '-')));
+    TEST("Shufti run", (runs_agree<"[!#%&;<>@`~]+">(';', 'k')));
+    TEST("Negated shufti run", (runs_agree<"[^!#%&;<>@`~]+">('u', '@')));
+    TEST("Single char kernel", single_char_agrees());
+    TEST("Literal search kernel", literal_search_agrees());
+
+    std::cout << "\n=== Results ===\n";
+    std::cout << "Passed: " << tests_passed << "\n";
+    std::cout << "Failed: " << tests_failed << "\n";
+    return tests_failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,54 @@
+#include <ctre.hpp>
+#include <iostream>
+#include <string>
+#include <string_view>
+
+int tests_passed = 0;
+int tests_failed = 0;
+
+#define TEST(name, cond) do { \
+    if (cond) { \
+        std::cout << "  [PASS] " << name << std::endl; \
+        tests_passed++; \
+    } else { \
+        std::cout << "  [FAIL] " << name << std::endl; \
+        tests_failed++; \
+    } \
+} while(0)
+
+// Sequences over pointers are fused once SIMD_SEQUENCE_THRESHOLD bytes remain; the rest of the
+// regex has to see every length a variable-length sequence can take
+template <ctll::fixed_string Pattern, ctll::fixed_string Oracle>
+bool agrees_past_threshold(std::string_view head) {
+    for (size_t pad = 0; pad < 80; ++pad) {
+        const std::string subject = std::string(head) + std::string(pad, '.');
+        const std::string_view text = subject;
+        auto fused = ctre::search<Pattern>(text);
+        auto plain = ctre::search<Oracle>(text);
+        if (bool(fused) != bool(plain) || fused.to_view() != plain.to_view()) return false;
+        if (bool(ctre::match<Pattern>(text)) != bool(ctre::match<Oracle>(text))) return false;
+    }
+    return true;
+}
+
+int main() {
+    std::cout << "=== Sequence Fusion Tests ===\n\n";
+
+    const std::string subject = "ab22b" + std::string(60, '.');
+    const std::string_view text = subject;
+    TEST("Longest run is kept", ctre::search<"ab[0-9]{1,3}">(text).to_view() == "ab22");
+    TEST("Rest picks the length", ctre::starts_with<"[0-9]{1,3}b">(text.substr(2)).to_view() == "22b");
+    TEST("Shorter run after longer fails", ctre::starts_with<"[0-9]{1,3}2b">(text.substr(2)).to_view() == "22b");
+    TEST("Class without a repeat", !ctre::starts_with<"a[0-9]">(text) && !ctre::search<"b[a-z]">(text));
+
+    TEST("Variable length", (agrees_past_threshold<"ab[0-9]{1,3}", "ab(?:[0-9][0-9][0-9]|[0-9][0-9]|[0-9])">("xab1234")));
+    TEST("Variable length then literal",
+         (agrees_past_threshold<"b[0-9]{1,3}2b", "b(?:[0-9][0-9][0-9]|[0-9][0-9]|[0-9])2b">("ab222b")));
+    TEST("Fixed length", (agrees_past_threshold<"ab[0-9]{3}", "ab[0-9][0-9][0-9]">("ab12ab345")));
+    TEST("Single characters", (agrees_past_threshold<"a[0-9][a-z]", "a(?:[0-9])(?:[a-z])">("a1.a2b")));
+
+    std::cout << "\n=== Results ===\n";
+    std::cout << "Passed: " << tests_passed << "\n";
+    std::cout << "Failed: " << tests_failed << "\n";
+    return tests_failed > 0 ? 1 : 0;
+}
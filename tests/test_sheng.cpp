@@ -0,0 +1,88 @@
+#include <ctre.hpp>
+#include <ctre/dfa/sheng.hpp>
+#include <ctre/smart_dispatch.hpp>
+#include <iostream>
+#include <string>
+#include <string_view>
+
+int tests_passed = 0;
+int tests_failed = 0;
+
+#define TEST(name, cond) do { \
+    if (cond) { \
+        std::cout << "  [PASS] " << name << std::endl; \
+        tests_passed++; \
+    } else { \
+        std::cout << "  [FAIL] " << name << std::endl; \
+        tests_failed++; \
+    } \
+} while(0)
+
+template <ctll::fixed_string Pattern>
+using ast_of = decltype(ctll::front(typename ctll::parser<ctre::pcre, Pattern, ctre::pcre_actions>::template output<ctre::pcre_context<>>::output_type::stack_type()));
+
+// Viability: capture-free and at most 16 states, dead state included
+static_assert(ctre::dfa::sheng_viable_v<ast_of<"[0-9a-f]{8}-[0-9a-f]{4}">>);
+static_assert(ctre::dfa::sheng_v<ast_of<"[0-9a-f]{8}-[0-9a-f]{4}">>.state_count == 15);
+static_assert(ctre::dfa::sheng_v<ast_of<"[0-9]+">>.class_count == 2);
+static_assert(!ctre::dfa::sheng_viable_v<ast_of<"[0-9a-f]{16}">>);
+static_assert(!ctre::dfa::sheng_viable_v<ast_of<"([0-9]+)x">>);
+static_assert(!ctre::dfa::sheng_viable_v<ast_of<"a+?b">>);
+static_assert(ctre::smart_dispatch::get_strategy_name<"[0-9a-f]{8}-[0-9a-f]{4}">() == std::string_view{"Sheng"});
+static_assert(ctre::smart_dispatch::would_use_sheng<"(?:ab|cd)+">());
+// The scalar path runs in constant expressions
+static_assert(ctre::match<"[0-9a-f]{8}-[0-9a-f]{4}">("deadbeef-0123"));
+static_assert(!ctre::match<"[0-9a-f]{8}-[0-9a-f]{4}">("deadbeef-012"));
+
+// Reference: non-pointer iterators never take the Sheng path
+template <ctll::fixed_string Pattern>
+bool reference_match(const std::string& text) {
+    return static_cast<bool>(ctre::match<Pattern>(text.begin(), text.end()));
+}
+
+template <ctll::fixed_string Pattern>
+bool agrees_with_reference(const char* alphabet, size_t alphabet_size, size_t max_length) {
+    uint32_t seed = 16;
+    for (int round = 0; round < 600; ++round) {
+        std::string text;
+        const size_t length = static_cast<size_t>(round) % max_length;
+        for (size_t i = 0; i < length; ++i) {
+            seed = seed * 1103515245u + 12345u;
+            text += alphabet[(seed >> 16) % alphabet_size];
+        }
+        auto got = ctre::match<Pattern>(text);
+        if (static_cast<bool>(got) != reference_match<Pattern>(text)) return false;
+        if (got && (got.to_view().data() != text.data() || got.size() != text.size())) return false;
+    }
+    return true;
+}
+
+int main() {
+    std::cout << "=== Sheng DFA Tests ===\n\n";
+
+    TEST("Hex validator", (agrees_with_reference<"[0-9a-f]{8}-[0-9a-f]{4}">("0a9f-g", 6, 16)));
+    TEST("Alternation loop", (agrees_with_reference<"(?:ab|cd)+">("abcd", 4, 40)));
+    TEST("Optional tail", (agrees_with_reference<"x*y?z">("xyz", 3, 40)));
+
+    {
+        std::string text = "deadbeef-0123";
+        TEST("Accepts", ctre::match<"[0-9a-f]{8}-[0-9a-f]{4}">(text).to_view() == text);
+        text[3] = 'X';
+        TEST("Rejects", !ctre::match<"[0-9a-f]{8}-[0-9a-f]{4}">(text));
+    }
+
+    {
+        // Longer than one 16-byte block, and dead inside the first block
+        std::string text(70, 'a');
+        TEST("Long input", ctre::match<"a*b?">(text));
+        text[5] = 'c';
+        TEST("Dead state", !ctre::match<"a*b?">(text));
+        text[5] = 'b';
+        TEST("Last byte", !ctre::match<"a*b?">(text));
+    }
+
+    std::cout << "\n=== Results ===\n";
+    std::cout << "Passed: " << tests_passed << "\n";
+    std::cout << "Failed: " << tests_failed << "\n";
+    return tests_failed > 0 ? 1 : 0;
+}
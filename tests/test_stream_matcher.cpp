@@ -0,0 +1,91 @@
+#include <ctre.hpp>
+#include <ctre/dfa/stream_matcher.hpp>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+int tests_passed = 0;
+int tests_failed = 0;
+
+#define TEST(name, cond) do { \
+    if (cond) { \
+        std::cout << "  [PASS] " << name << std::endl; \
+        tests_passed++; \
+    } else { \
+        std::cout << "  [FAIL] " << name << std::endl; \
+        tests_failed++; \
+    } \
+} while(0)
+
+// Reference: for every end, the leftmost start whose substring matches
+template <ctll::fixed_string Pattern>
+std::vector<ctre::stream_match> reference_matches(std::string_view text) {
+    std::vector<ctre::stream_match> out;
+    for (size_t end = 1; end <= text.size(); ++end)
+        for (size_t start = 0; start < end; ++start)
+            if (ctre::match<Pattern>(text.substr(start, end - start))) {
+                out.push_back({start, end});
+                break;
+            }
+    return out;
+}
+
+template <ctll::fixed_string Pattern>
+std::vector<ctre::stream_match> stream_matches(std::string_view text, uint32_t& seed) {
+    ctre::stream_matcher<Pattern> matcher;
+    std::vector<ctre::stream_match> out;
+    size_t pos = 0;
+    while (pos < text.size()) {
+        seed = seed * 1103515245u + 12345u;
+        const size_t size = std::min<size_t>((seed >> 16) % 7, text.size() - pos); // empty chunks too
+        matcher.feed(text.substr(pos, size), [&](ctre::stream_match m) { out.push_back(m); });
+        pos += size;
+    }
+    if (matcher.finish() != text.size()) out.push_back({0, 0});
+    return out;
+}
+
+template <ctll::fixed_string Pattern>
+bool agrees_with_reference(const char* alphabet, size_t alphabet_size) {
+    uint32_t seed = 8;
+    for (int round = 0; round < 300; ++round) {
+        std::string text;
+        const size_t length = static_cast<size_t>(round) % 40;
+        for (size_t i = 0; i < length; ++i) {
+            seed = seed * 1103515245u + 12345u;
+            text += alphabet[(seed >> 16) % alphabet_size];
+        }
+        if (stream_matches<Pattern>(text, seed) != reference_matches<Pattern>(text)) return false;
+    }
+    return true;
+}
+
+int main() {
+    std::cout << "=== Stream Matcher Tests ===\n\n";
+
+    TEST("Literal", (agrees_with_reference<"abc">("abcx", 4)));
+    TEST("Repeat", (agrees_with_reference<"[0-9]+x">("12x.", 4)));
+    TEST("Alternation with shared suffix", (agrees_with_reference<"abcd|c|bcx">("abcdx", 5)));
+    TEST("Counted repeat", (agrees_with_reference<"(?:ab){2,3}">("ab", 2)));
+
+    {
+        // A match spanning three chunks, reported with global offsets
+        ctre::stream_matcher<"GET /[a-z]+ HTTP"> matcher;
+        std::vector<ctre::stream_match> got;
+        const auto collect = [&](ctre::stream_match m) { got.push_back(m); };
+        matcher.feed("xxxxGE", collect);
+        matcher.feed("T /inde", collect);
+        TEST("Nothing before the last byte", got.empty());
+        matcher.feed("x HTTP/1.1", collect);
+        TEST("Spanning match", got.size() == 1 && got[0].start == 4 && got[0].end == 19);
+        TEST("Stream length", matcher.finish() == 23);
+        matcher.feed("GET /a HTTP", collect);
+        TEST("Reused after finish", got.size() == 2 && got[1].start == 0 && got[1].end == 11);
+    }
+
+    std::cout << "\n=== Results ===\n";
+    std::cout << "Passed: " << tests_passed << "\n";
+    std::cout << "Failed: " << tests_failed << "\n";
+    return tests_failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,108 @@
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <ctre.hpp>
+
+int tests_passed = 0;
+int tests_failed = 0;
+
+#define TEST(name, cond) do { \
+    if (cond) { \
+        std::cout << "  [PASS] " << name << std::endl; \
+        tests_passed++; \
+    } else { \
+        std::cout << "  [FAIL] " << name << std::endl; \
+        tests_failed++; \
+    } \
+} while(0)
+
+template <ctll::fixed_string Pattern>
+using ast_of = decltype(ctll::front(typename ctll::parser<ctre::pcre, Pattern, ctre::pcre_actions>::template output<ctre::pcre_context<>>::output_type::stack_type()));
+
+template <ctll::fixed_string Pattern>
+constexpr auto prefixes = ctre::extraction::extract_prefix_literals<ast_of<Pattern>>();
+
+template <size_t N, size_t L>
+constexpr bool has_literal(const ctre::multi_literal_result<N, L>& r, std::string_view s) {
+    for (size_t i = 0; i < r.count; ++i)
+        if (std::string_view{r.literals[i].chars.data(), r.literals[i].length} == s) return true;
+    return false;
+}
+
+// Prefix sets
+static_assert(prefixes<"(GET|POST|PUT) /api">.count == 3);
+static_assert(has_literal(prefixes<"(GET|POST|PUT) /api">, "POST /api"));
+static_assert(prefixes<"[ab]c+d">.count == 2 && has_literal(prefixes<"[ab]c+d">, "ac"));
+static_assert(prefixes<"foo.bar">.count == 1 && has_literal(prefixes<"foo.bar">, "foo"));
+// Not safe: a match may start with anything / with an empty prefix
+static_assert(!prefixes<".*foo">.has_literals);
+static_assert(!prefixes<"a*b">.has_literals);
+static_assert(prefixes<"(foo|\\d+)x">.count == 11);
+static_assert(!prefixes<"(foo|\\w+)x">.has_literals);
+static_assert(!prefixes<"^abc">.has_literals);
+
+// Reference: non-pointer iterators never take the prefilter path
+template <ctll::fixed_string Pattern>
+std::string_view reference_search(const std::string& text) {
+    if (auto r = ctre::search<Pattern>(text.begin(), text.end()))
+        return {text.data() + (r.begin() - text.begin()), r.size()};
+    return {};
+}
+
+template <ctll::fixed_string Pattern>
+bool agrees_with_reference(const char* alphabet, size_t alphabet_size) {
+    uint32_t seed = 7;
+    for (int round = 0; round < 400; ++round) {
+        std::string text;
+        size_t length = static_cast<size_t>(round) % 90;
+        for (size_t i = 0; i < length; ++i) {
+            seed = seed * 1103515245u + 12345u;
+            text += alphabet[(seed >> 16) % alphabet_size];
+        }
+        auto got = ctre::search<Pattern>(text);
+        auto want = reference_search<Pattern>(text);
+        if (static_cast<bool>(got) != (want.data() != nullptr)) return false;
+        if (got && (got.to_view().data() != want.data() || got.to_view().size() != want.size())) return false;
+    }
+    return true;
+}
+
+int main() {
+    std::cout << "=== Teddy Multi-Literal Prefilter Tests ===\n\n";
+
+    {
+        constexpr auto teddy = ctre::simd::make_teddy_masks(prefixes<"(GET|POST|PUT) /api">);
+        TEST("Fingerprint uses 3 bytes", teddy.fingerprint == 3);
+        std::string text(200, '.');
+        text.replace(150, 9, "POST /api");
+        text.replace(40, 8, "PUT /apx");
+        const char* hit = ctre::simd::teddy_find(teddy, text.data(), text.data() + text.size());
+        TEST("Finds the only complete literal", hit == text.data() + 150);
+        TEST("Scalar agrees", ctre::simd::teddy_find_scalar(teddy, text.data(), text.data() + text.size()) == hit);
+        TEST("No literal -> end", ctre::simd::teddy_find(teddy, text.data(), text.data() + 100) == text.data() + 100);
+    }
+
+    {
+        constexpr auto teddy = ctre::simd::make_teddy_masks(prefixes<"(a|bc|def|ghij|klmno|p|q|r|s|t)x">);
+        std::string text(64, 'z');
+        text += "tx";
+        const char* hit = ctre::simd::teddy_find(teddy, text.data(), text.data() + text.size());
+        TEST("More literals than buckets", hit == text.data() + 64);
+    }
+
+    TEST("HTTP methods", (agrees_with_reference<"(GET|POST|PUT) /a[pq]i">("GETPOSU /apqi", 13)));
+    TEST("Char class prefix", (agrees_with_reference<"[xy]z+w">("xyzw", 4)));
+    TEST("Overlapping literals", (agrees_with_reference<"(ab|abab|b)c">("abc", 3)));
+
+    {
+        std::string log(4096, 'x');
+        log += "DELETE /users/42";
+        auto r = ctre::search<"(GET|POST|PUT|DELETE) /users/([0-9]+)">(log);
+        TEST("Capture after prefilter", r && r.get<2>().to_view() == "42");
+    }
+
+    std::cout << "\n=== Results ===\n";
+    std::cout << "Passed: " << tests_passed << "\n";
+    std::cout << "Failed: " << tests_failed << "\n";
+    return tests_failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,110 @@
+#include <ctre.hpp>
+#include <iostream>
+#include <string>
+#include <string_view>
+
+int tests_passed = 0;
+int tests_failed = 0;
+
+#define TEST(name, cond) do { \
+    if (cond) { \
+        std::cout << "  [PASS] " << name << std::endl; \
+        tests_passed++; \
+    } else { \
+        std::cout << "  [FAIL] " << name << std::endl; \
+        tests_failed++; \
+    } \
+} while(0)
+
+template <ctll::fixed_string Pattern>
+using ast_of = decltype(ctll::front(typename ctll::parser<ctre::pcre, Pattern, ctre::pcre_actions>::template output<ctre::pcre_context<>>::output_type::stack_type()));
+
+// Only capture patterns the DFA handles take the two phases
+static_assert(ctre::dfa::two_phase_match_v<ast_of<"([a-z]+)@([a-z]+)">>);
+static_assert(ctre::dfa::two_phase_search_v<ast_of<"([0-9]+)-([0-9]+)">>);
+static_assert(!ctre::dfa::two_phase_match_v<ast_of<"[a-z]+@[a-z]+">>);
+static_assert(!ctre::dfa::two_phase_match_v<ast_of<"(a)\\1">>);
+static_assert(!ctre::dfa::two_phase_search_v<ast_of<"^([a-z]+)$">>);
+static_assert(!ctre::dfa::two_phase_search_v<ast_of<"([a-z]{30}){3}">>);
+// Constant evaluation keeps the plain evaluator
+static_assert(ctre::match<"([a-z]+)@([a-z]+)">("user@host").get<2>() == "host");
+static_assert(ctre::search<"([0-9]+)-([0-9]+)">("tel 12-34").get<1>() == "12");
+
+// Reference: non-pointer iterators never take the two phases
+template <ctll::fixed_string Pattern>
+bool agrees_with_reference(const char* alphabet, size_t alphabet_size) {
+    uint32_t seed = 7;
+    for (int round = 0; round < 400; ++round) {
+        std::string text;
+        const size_t length = static_cast<size_t>(round) % 40;
+        for (size_t i = 0; i < length; ++i) {
+            seed = seed * 1103515245u + 12345u;
+            text += alphabet[(seed >> 16) % alphabet_size];
+        }
+        auto got = ctre::search<Pattern>(std::string_view{text});
+        auto expected = ctre::search<Pattern>(text.begin(), text.end());
+        if (static_cast<bool>(got) != static_cast<bool>(expected)) return false;
+        if (got && (got.template get<1>().to_view().data() - text.data() != expected.template get<1>().begin() - text.begin() ||
+                    got.template get<1>().size() != expected.template get<1>().size() || got.size() != expected.size()))
+            return false;
+        auto whole = ctre::match<Pattern>(std::string_view{text});
+        auto whole_expected = ctre::match<Pattern>(text.begin(), text.end());
+        if (static_cast<bool>(whole) != static_cast<bool>(whole_expected)) return false;
+        if (whole && whole.template get<1>().size() != whole_expected.template get<1>().size()) return false;
+    }
+    return true;
+}
+
+int main() {
+    std::cout << "=== Two-Phase Capture Tests ===\n\n";
+
+    TEST("Key value", (agrees_with_reference<"([a-c]+)=([0-9]*)">("ab=12 c", 7)));
+    TEST("Alternation in group", (agrees_with_reference<"(a|ab)(c|bcd)">("abcd", 4)));
+    TEST("Nested groups", (agrees_with_reference<"((a|b)+)c">("abc.", 4)));
+    TEST("Optional group", (agrees_with_reference<"x(y)?z">("xyz", 3)));
+
+    {
+        auto m = ctre::match<"([a-z]+)@([a-z]+)\\.com">("user@example.com");
+        TEST("Match captures", m && m.get<1>() == "user" && m.get<2>() == "example");
+        TEST("Match rejected", !ctre::match<"([a-z]+)@([a-z]+)\\.com">("user@example.org"));
+    }
+
+    {
+        // Leftmost-first, not leftmost-longest
+        auto m = ctre::search<"(a|ab)(c|bcd)">("xxabcd");
+        TEST("Leftmost-first", m && m.to_view() == "abcd" && m.get<1>() == "a" && m.get<2>() == "bcd");
+    }
+
+    {
+        std::string text(500, '.');
+        TEST("No match anywhere", !ctre::search<"([0-9]+)-([0-9]+)">(text));
+        text.replace(400, 7, "123-456");
+        auto m = ctre::search<"([0-9]+)-([0-9]+)">(text);
+        TEST("Late match", m && m.get<1>() == "123" && m.get<2>() == "456");
+    }
+
+    {
+        // Each search of search_all stops at its match
+        std::string text;
+        for (int i = 0; i < 2000; ++i) text += std::string(1 + i % 7, static_cast<char>('a' + i % 26)) + "=" + std::to_string(i) + "; ";
+        size_t count = 0;
+        std::string_view last;
+        for (auto m : ctre::search_all<"([a-z]+)=([0-9]+)">(std::string_view{text})) {
+            ++count;
+            last = m.get<2>().to_view();
+        }
+        TEST("Search all", count == 2000 && last == "1999");
+    }
+
+    {
+        // Split and ranges continue after a failed search
+        std::string out;
+        for (auto part : ctre::split<"(,)">("a,b,c")) out += part.to_view();
+        TEST("Split", out == "abc");
+    }
+
+    std::cout << "\n=== Results ===\n";
+    std::cout << "Passed: " << tests_passed << "\n";
+    std::cout << "Failed: " << tests_failed << "\n";
+    return tests_failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,111 @@
+#include <ctre.hpp>
+#include <ctre/simd/wide_classes.hpp>
+#include <iostream>
+#include <string>
+#include <string_view>
+
+int tests_passed = 0;
+int tests_failed = 0;
+
+#define TEST(name, cond) do { \
+    if (cond) { \
+        std::cout << "  [PASS] " << name << std::endl; \
+        tests_passed++; \
+    } else { \
+        std::cout << "  [FAIL] " << name << std::endl; \
+        tests_failed++; \
+    } \
+} while(0)
+
+// Classes become code unit ranges, clipped to the lane
+using lower = ctre::char_range<U'a', U'z'>;
+using cjk = ctre::char_range<U'一', U'鿿'>;
+using astral = ctre::char_range<U'\U0001F600', U'\U0001F64F'>;
+static_assert(ctre::simd::wide_class_v<lower, char16_t, false>.count == 1);
+static_assert(ctre::simd::wide_class_v<lower, char16_t, true>.count == 2);
+static_assert(ctre::simd::wide_class_v<ctre::negative_set<lower, cjk>, char32_t, false>.negated);
+static_assert(ctre::simd::wide_class_v<astral, char16_t, false>.count == 0);
+static_assert(ctre::simd::wide_class_v<astral, char32_t, false>.contains(0x1F610));
+static_assert(ctre::simd::wide_repeat_viable<ctre::space_chars, const wchar_t*, const wchar_t*>());
+static_assert(!ctre::simd::wide_repeat_viable<lower, const char*, const char*>());
+// Only ASCII letters fold: U+0161 and U+0141 differ in bit 5 as well
+static_assert(ctre::simd::wide_class_v<ctre::character<U'š'>, char32_t, true>.count == 1);
+
+// Literals longer than SIMD_STRING_THRESHOLD keep working at compile time
+static_assert(ctre::match<u"(?i)wide character subject">(std::u16string_view{u"Wide Character Subject"}));
+
+static constexpr ctre::simd::wide_class digits = ctre::simd::make_wide_class<ctre::char_range<'0', '9'>, char16_t>(false);
+static constexpr ctre::simd::wide_class not_comma = ctre::simd::make_wide_class<ctre::negative_set<ctre::character<U','>>, char32_t>(false);
+
+// Every tier the CPU runs agrees with the scalar kernel, for stops on either side of the vector boundaries
+template <typename CharT, const ctre::simd::wide_class& Class, bool Stop>
+bool scan_agrees(CharT fill, CharT stop) {
+    std::basic_string<CharT> text(160, fill);
+    for (size_t at = 0; at < 100; ++at) {
+        text[at] = stop;
+        for (size_t length = at; length <= at + 40; ++length) {
+            const size_t expected = ctre::simd::wide_class_scan_scalar<CharT, Class, Stop>(text.data(), length);
+            if (ctre::simd::wide_class_scan<CharT, Class, Stop>(text.data(), length) != expected) return false;
+            if (ctre::simd::has_sse42() &&
+                ctre::simd::wide_class_scan_sse42<CharT, Class, Stop>(text.data(), length) != expected)
+                return false;
+            if (ctre::simd::has_avx2() &&
+                ctre::simd::wide_class_scan_avx2<CharT, Class, Stop>(text.data(), length) != expected)
+                return false;
+        }
+        text[at] = fill;
+    }
+    return true;
+}
+
+template <ctll::fixed_string Pattern, typename CharT>
+bool runs_agree(CharT fill, CharT stop) {
+    for (size_t n = 1; n < 120; ++n) {
+        const std::basic_string<CharT> run(n, fill);
+        if (!ctre::match<Pattern>(std::basic_string_view<CharT>{run})) return false;
+        const std::basic_string<CharT> text = run + stop + run;
+        if (ctre::starts_with<Pattern>(std::basic_string_view<CharT>{text}).size() != n) return false;
+    }
+    return true;
+}
+
+int main() {
+    std::cout << "=== Wide Character Tests ===\n\n";
+
+    TEST("Range run kernel", (scan_agrees<char16_t, digits, false>(u'7', u'x')));
+    TEST("Range find kernel", (scan_agrees<char16_t, digits, true>(u'x', u'7')));
+    TEST("Negated 32-bit kernel", (scan_agrees<char32_t, not_comma, false>(U'é', U',')));
+
+    TEST("char16_t run", (runs_agree<u"[a-z]+">(u'q', u'-')));
+    TEST("wchar_t run", (runs_agree<L"[0-9a-fA-F]+">(L'C', L'g')));
+    TEST("char32_t run", (runs_agree<U"[一-鿿]+">(U'中', U'.')));
+    TEST("Case-insensitive run", (runs_agree<u"(?i)[a-f]+">(u'D', u'x')));
+    TEST("Caseless run stays ASCII", !ctre::match<U"(?i)š++">(std::u32string_view{U"ŁŁŁŁŁŁŁŁŁŁŁŁŁŁŁŁŁŁŁŁ"}) &&
+                                         ctre::match<U"(?i)š++">(std::u32string_view{U"šššššššššššššššššššš"}));
+    TEST("Bounded run", (ctre::starts_with<u"[a-z]{2,40}">(std::u16string_view{std::u16string(90, u'k')}).size() == 40));
+
+    {
+        const std::u16string text = std::u16string(200, u'.') + u"id=4711;";
+        auto m = ctre::search<u"id=[0-9]+">(std::u16string_view{text});
+        TEST("Search skips to first unit", m && m.to_view() == u"id=4711");
+        TEST("Search without match", !ctre::search<u"[#@]x">(std::u16string_view{text}));
+    }
+
+    {
+        const std::wstring text = std::wstring(70, L' ') + L"Content-Type: application/json";
+        TEST("Long literal", ctre::search<L"Content-Type: application/json">(std::wstring_view{text}));
+        TEST("Long literal mismatch", !ctre::search<L"Content-Type: application/xml!">(std::wstring_view{text}));
+        TEST("Caseless long literal", ctre::search<L"(?i)CONTENT-TYPE: APPLICATION/JSON">(std::wstring_view{text}));
+        const std::u32string subject = U"\U0001F600 grinning face with big eyes";
+        TEST("Astral literal", ctre::match<U"\U0001F600 grinning face with big eyes">(std::u32string_view{subject}));
+        TEST("Caseless literal stays ASCII",
+             !ctre::match<u"(?i)šššššššššššššššššš">(std::u16string_view{u"ŁŁŁŁŁŁŁŁŁŁŁŁŁŁŁŁŁŁ"}));
+        TEST("Truncated subject", !ctre::match<U"\U0001F600 grinning face with big eyes">(
+                                      std::u32string_view{subject}.substr(0, 20)));
+    }
+
+    std::cout << "\n=== Results ===\n";
+    std::cout << "Passed: " << tests_passed << "\n";
+    std::cout << "Failed: " << tests_failed << "\n";
+    return tests_failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,140 @@
+#include <ctre.hpp>
+#include <ctre/fast_search.hpp>
+#include <ctre/simd/shift_or.hpp>
+#include <iostream>
+#include <string>
+#include <string_view>
+
+int tests_passed = 0;
+int tests_failed = 0;
+
+#define TEST(name, cond) do { \
+    if (cond) { \
+        std::cout << "  [PASS] " << name << std::endl; \
+        tests_passed++; \
+    } else { \
+        std::cout << "  [FAIL] " << name << std::endl; \
+        tests_failed++; \
+    } \
+} while(0)
+
+static_assert(std::is_same_v<ctre::simd::shift_or_state_for<64>, ctre::simd::shift_or_state<64>>);
+static_assert(ctre::simd::wide_shift_or_state<65>::words == 2);
+static_assert(ctre::simd::wide_shift_or_state<129>::words == 4);
+
+template <ctll::fixed_string Pattern> using segments = ctre::simd::fixed_segment_sequence<typename ctre::regex_builder<Pattern>::type>;
+static_assert(segments<"[0-9a-f]{8}-[0-9a-f]{4}-[0-9a-f]{4}-[0-9a-f]{4}-[0-9a-f]{12}">::length == 36);
+static_assert(segments<"[0-9a-f]{8}-[0-9a-f]{4}-[0-9a-f]{4}-[0-9a-f]{4}-[0-9a-f]{12}">::value);
+static_assert(!segments<"[0-9a-f]{8}-[0-9a-f]+">::value);
+// Overlapping classes split the bytes into more partitions than the state has rows
+static_assert(segments<"[a-m]{1}[h-z]{1}[0-5]{1}">::value);
+static_assert(!ctre::segment_shift_or_viable<segments<"[a-m]{1}[h-z]{1}[0-5]{1}">>());
+
+template <size_t N>
+constexpr auto make_state(const std::array<std::array<uint64_t, 4>, N>& sets) {
+    ctre::simd::wide_shift_or_state<N> state;
+    state.init_position_sets(sets);
+    return state;
+}
+
+// Position i accepts "ab" for even i and 'c' for odd i
+template <size_t N>
+constexpr auto alternating_sets() {
+    std::array<std::array<uint64_t, 4>, N> sets{};
+    for (size_t i = 0; i < N; ++i) {
+        if (i % 2 == 0) {
+            sets[i][1] |= (uint64_t(1) << ('a' - 64)) | (uint64_t(1) << ('b' - 64));
+        } else {
+            sets[i][1] |= uint64_t(1) << ('c' - 64);
+        }
+    }
+    return sets;
+}
+
+// Every tier the CPU runs finds the first occurrence planted at every offset, and
+// nothing once one of its bytes is broken
+template <size_t N>
+bool kernels_agree() {
+    static constexpr auto state = make_state<N>(alternating_sets<N>());
+    for (size_t at = 0; at < 60; ++at) {
+        std::string text(N + 80, 'x');
+        for (size_t i = 0; i < N; ++i) text[at + i] = i % 2 == 0 ? (i % 4 == 0 ? 'a' : 'b') : 'c';
+        for (int broken = 0; broken < 2; ++broken) {
+            if (broken) text[at + N / 2] = 'x';
+            const auto* p = reinterpret_cast<const unsigned char*>(text.data());
+            const auto* end = p + text.size();
+            const auto* expected = broken ? nullptr : p + at + N;
+            if (ctre::simd::wide_shift_or_scalar<N>(p, end, state) != expected) return false;
+            if (ctre::simd::has_sse42() && ctre::simd::wide_shift_or_sse42<N>(p, end, state) != expected) return false;
+            if (ctre::simd::has_avx2() && ctre::simd::wide_shift_or_avx2<N>(p, end, state) != expected) return false;
+            const char* it = text.data();
+            if (ctre::simd::match_shift_or<N>(it, text.data() + text.size(), state) != !broken) return false;
+            if (!broken && it != text.data() + at + N) return false;
+        }
+    }
+    return true;
+}
+
+template <char... Chars>
+bool long_literal_found(std::string_view literal, bool caseless) {
+    std::string text(300, '-');
+    text.replace(150, literal.size(), literal);
+    const char* it = text.data();
+    const ctre::flags f = caseless ? ctre::flags{ctre::case_insensitive{}} : ctre::flags{};
+    return ctre::simd::match_string_shift_or<Chars...>(it, text.data() + text.size(), f) &&
+           it == text.data() + 150 + literal.size();
+}
+
+int main() {
+    std::cout << "=== Wide Shift-Or Tests ===\n\n";
+
+    TEST("Two words", kernels_agree<100>());
+    TEST("Two words, full", kernels_agree<128>());
+    TEST("Four words", kernels_agree<200>());
+    TEST("Four words, full", kernels_agree<256>());
+
+    {
+        // 80 positions: longer than a single mask word
+        TEST("Long literal", (long_literal_found<'0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd', 'e',
+                                                 'f', 'g', 'h', 'i', 'j', 'k', 'l', 'm', 'n', 'o', 'p', 'q', 'r', 's', 't',
+                                                 'u', 'v', 'w', 'x', 'y', 'z', '0', '1', '2', '3', '4', '5', '6', '7', '8',
+                                                 '9', 'a', 'b', 'c', 'd', 'e', 'f', 'g', 'h', 'i', 'j', 'k', 'l', 'm', 'n',
+                                                 'o', 'p', 'q', 'r', 's', 't', 'u', 'v', 'w', 'x', 'y', 'z', '0', '1', '2',
+                                                 '3', '4', '5', '6', '7'>(
+                                  "0123456789abcdefghijklmnopqrstuvwxyz0123456789abcdefghijklmnopqrstuvwxyz01234567",
+                                  false)));
+        TEST("Long caseless literal", (long_literal_found<'0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c',
+                                                          'd', 'e', 'f', 'g', 'h', 'i', 'j', 'k', 'l', 'm', 'n', 'o', 'p',
+                                                          'q', 'r', 's', 't', 'u', 'v', 'w', 'x', 'y', 'z', '0', '1', '2',
+                                                          '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd', 'e', 'f',
+                                                          'g', 'h', 'i', 'j', 'k', 'l', 'm', 'n', 'o', 'p', 'q', 'r', 's',
+                                                          't', 'u', 'v', 'w', 'x', 'y', 'z', '0', '1', '2', '3', '4', '5',
+                                                          '6', '7'>(
+                                          "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789abcdefghijklmnopqrstuvwxyz01234567",
+                                          true)));
+    }
+
+    {
+        // Fixed segment sequences are found by one shift-or scan
+        const std::string text = "id=0123abcd-ffff-zzzz-0000-000000000000 id=0123abcd-ffff-0a0a-0000-0123456789ab;";
+        auto m = ctre::fast_search<"[0-9a-f]{8}-[0-9a-f]{4}-[0-9a-f]{4}-[0-9a-f]{4}-[0-9a-f]{12}">(std::string_view{text});
+        TEST("UUID", m && m.to_view() == "0123abcd-ffff-0a0a-0000-0123456789ab");
+
+        std::string pair = std::string(50, ' ') + "0123abcd-ffff-0a0a-0000-0123456789ab/0123abcd-ffff-0a0a-0000-0123456789ab";
+        auto two = ctre::fast_search<"[0-9a-f]{8}-[0-9a-f]{4}-[0-9a-f]{4}-[0-9a-f]{4}-[0-9a-f]{12}/"
+                                     "[0-9a-f]{8}-[0-9a-f]{4}-[0-9a-f]{4}-[0-9a-f]{4}-[0-9a-f]{12}">(std::string_view{pair});
+        TEST("Sequence over 64 positions", two && two.to_view().size() == 73 && two.to_view().data() == pair.data() + 50);
+
+        auto overlap = ctre::fast_search<"[a-m]{1}[h-z]{1}[0-5]{1}">(std::string_view{"zzhz9 zzhi3"});
+        TEST("Overlapping classes", overlap && overlap.to_view() == "hi3");
+
+        TEST("No sequence", (!ctre::fast_search<"[0-9]{3}-[0-9]{4}">(std::string_view{"call 555-12x4 now"})));
+        // Constant evaluation keeps the plain search
+        static_assert(ctre::fast_search<"[0-9]{3}-[0-9]{4}">("call 555-1234").to_view() == "555-1234");
+    }
+
+    std::cout << "\n=== Results ===\n";
+    std::cout << "Passed: " << tests_passed << "\n";
+    std::cout << "Failed: " << tests_failed << "\n";
+    return tests_failed > 0 ? 1 : 0;
+}